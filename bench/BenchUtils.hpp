@@ -0,0 +1,154 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+namespace bench {
+
+struct Metric
+{
+    std::string name;
+    double value;
+};
+
+struct Result
+{
+    std::string name;
+    std::vector<Metric> metrics;
+};
+
+class Report
+{
+private:
+    std::string _suite;
+    std::vector<std::string> _notes;
+    std::vector<Result> _results;
+
+    static void writeJsonString(std::ostream& os, const std::string_view s)
+    {
+        os << '"';
+
+        for (const char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                os << '\\';
+            }
+
+            os << c;
+        }
+
+        os << '"';
+    }
+
+public:
+    explicit Report(std::string suite) : _suite{SSVOH_MOVE(suite)}
+    {}
+
+    // Caveats about what the results measure, e.g. work that is skipped.
+    void addNote(std::string note)
+    {
+        std::cout << "NOTE: " << note << '\n' << std::flush;
+        _notes.emplace_back(SSVOH_MOVE(note));
+    }
+
+    void add(Result&& result)
+    {
+        std::cout << result.name << '\n';
+
+        for (const Metric& m : result.metrics)
+        {
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "    %-24s %16.3f\n",
+                m.name.c_str(), m.value);
+
+            std::cout << buf;
+        }
+
+        std::cout << std::flush;
+        _results.emplace_back(SSVOH_MOVE(result));
+    }
+
+    void writeJson(std::ostream& os) const
+    {
+        os << "{\n  \"suite\": ";
+        writeJsonString(os, _suite);
+        os << ",\n  \"notes\": [";
+
+        for (std::size_t i = 0; i < _notes.size(); ++i)
+        {
+            os << (i == 0 ? "\n    " : ",\n    ");
+            writeJsonString(os, _notes[i]);
+        }
+
+        os << (_notes.empty() ? "]" : "\n  ]");
+        os << ",\n  \"results\": [";
+
+        for (std::size_t i = 0; i < _results.size(); ++i)
+        {
+            const Result& r = _results[i];
+
+            os << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+            writeJsonString(os, r.name);
+            os << ",\n      \"metrics\": {";
+
+            for (std::size_t j = 0; j < r.metrics.size(); ++j)
+            {
+                const Metric& m = r.metrics[j];
+
+                char buf[64];
+                std::snprintf(buf, sizeof(buf), "%.6f", m.value);
+
+                os << (j == 0 ? "\n" : ",\n") << "        ";
+                writeJsonString(os, m.name);
+                os << ": " << buf;
+            }
+
+            os << "\n      }\n    }";
+        }
+
+        os << "\n  ]\n}\n";
+    }
+
+    // Writes the JSON report to the path following `--json` on the command
+    // line, if any. Returns `false` on failure.
+    [[nodiscard]] bool writeJsonIfRequested(int argc, char** argv) const
+    {
+        for (int i = 1; i + 1 < argc; ++i)
+        {
+            if (std::string_view{argv[i]} != "--json")
+            {
+                continue;
+            }
+
+            std::ofstream ofs{argv[i + 1]};
+            writeJson(ofs);
+
+            if (!ofs)
+            {
+                std::cerr << "Failed to write '" << argv[i + 1] << "'\n";
+                return false;
+            }
+
+            std::cout << "Results written to '" << argv[i + 1] << "'\n";
+            return true;
+        }
+
+        return true;
+    }
+};
+
+} // namespace bench
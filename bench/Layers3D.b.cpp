@@ -0,0 +1,172 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "BenchUtils.hpp"
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Layers3D.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace {
+
+// Flat geometry of a busy frame: many walls, a hexagonal pivot and a player.
+constexpr std::size_t wallCount = 512;
+constexpr std::size_t pivotSides = 6;
+
+constexpr std::array depths{1, 15};
+
+constexpr int measuredFrames = 2'000;
+
+void emitQuads(hg::Utils::FastVertexVectorTris& out, const std::size_t n)
+{
+    out.reserve_more_quad(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float x = static_cast<float>(i);
+
+        out.batch_unsafe_emplace_back_quad(sf::Color::White, //
+            sf::Vector2f{x, 0.f}, sf::Vector2f{x, 1.f},      //
+            sf::Vector2f{x + 1.f, 1.f}, sf::Vector2f{x + 1.f, 0.f});
+    }
+}
+
+[[nodiscard]] std::vector<hg::Utils::Layer3D> makeLayers(const int depth)
+{
+    std::vector<hg::Utils::Layer3D> result;
+
+    for (int i = 0; i < depth; ++i)
+    {
+        const float offset = static_cast<float>(depth - i) * 2.f;
+
+        result.push_back(hg::Utils::Layer3D{
+            .offset = {0.f, offset},       //
+            .pivotColor = sf::Color::Red,  //
+            .wallColor = sf::Color::Green, //
+            .playerColor = sf::Color::Blue //
+        });
+    }
+
+    return result;
+}
+
+struct Measurement
+{
+    std::size_t baseVertices;
+    std::size_t cpuVerticesPerFrame;
+    double cpuSeconds;
+    std::size_t offsetDrawCallsPerFrame;
+};
+
+[[nodiscard]] Measurement runCase(const int depth)
+{
+    hg::Utils::FastVertexVectorTris wallQuads;
+    hg::Utils::FastVertexVectorTris pivotQuads;
+    hg::Utils::FastVertexVectorTris playerTris;
+
+    emitQuads(wallQuads, wallCount);
+    emitQuads(pivotQuads, pivotSides);
+    emitQuads(playerTris, 1);
+
+    const std::vector<hg::Utils::Layer3D> layers = makeLayers(depth);
+
+    hg::Utils::FastVertexVectorTris wallQuads3D;
+    hg::Utils::FastVertexVectorTris pivotQuads3D;
+    hg::Utils::FastVertexVectorTris playerTris3D;
+
+    const auto emitFrame = [&]
+    {
+        wallQuads3D.clear();
+        pivotQuads3D.clear();
+        playerTris3D.clear();
+
+        hg::Utils::emitLayers3D(
+            wallQuads3D, wallQuads, layers, &hg::Utils::Layer3D::wallColor);
+
+        hg::Utils::emitLayers3D(
+            pivotQuads3D, pivotQuads, layers, &hg::Utils::Layer3D::pivotColor);
+
+        hg::Utils::emitLayers3D(playerTris3D, playerTris, layers,
+            &hg::Utils::Layer3D::playerColor);
+    };
+
+    // Warm-up, not measured: grows the vertex vectors to their final size.
+    emitFrame();
+
+    const hg::HRTimePoint tpBegin = hg::HRClock::now();
+
+    for (int i = 0; i < measuredFrames; ++i)
+    {
+        emitFrame();
+    }
+
+    // The offset path draws the flat geometry once per layer and kind of
+    // geometry, without writing any vertex.
+    return Measurement{
+        .baseVertices =
+            wallQuads.size() + pivotQuads.size() + playerTris.size(), //
+        .cpuVerticesPerFrame =
+            wallQuads3D.size() + pivotQuads3D.size() + playerTris3D.size(), //
+        .cpuSeconds =
+            std::chrono::duration<double>(hg::HRClock::now() - tpBegin)
+                .count(),                                              //
+        .offsetDrawCallsPerFrame = static_cast<std::size_t>(depth) * 3 //
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+try
+{
+    bench::Report report{"Layers3D"};
+
+    for (const int depth : depths)
+    {
+        const Measurement m = runCase(depth);
+
+        std::vector<bench::Metric> metrics{
+            {"baseVertices", static_cast<double>(m.baseVertices)}, //
+            {"cpuVerticesPerFrame",
+                static_cast<double>(m.cpuVerticesPerFrame)}, //
+            {"cpuUsPerFrame",
+                m.cpuSeconds * 1'000'000.0 / measuredFrames}, //
+            {"offsetVerticesPerFrame", 0.0},                  //
+            {"offsetDrawCallsPerFrame",
+                static_cast<double>(m.offsetDrawCallsPerFrame)} //
+        };
+
+        report.add(bench::Result{
+            .name = "depth" + std::to_string(depth), //
+            .metrics = SSVOH_MOVE(metrics)           //
+        });
+    }
+
+    return report.writeJsonIfRequested(argc, argv) ? 0 : 1;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
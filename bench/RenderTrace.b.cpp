@@ -0,0 +1,223 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "BenchUtils.hpp"
+
+#include "SSVOpenHexagon/Data/ProfileData.hpp"
+
+#include "SSVOpenHexagon/Global/Assets.hpp"
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+#include "SSVOpenHexagon/Global/Version.hpp"
+
+#include "SSVOpenHexagon/Core/HexagonGame.hpp"
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+#include "SSVOpenHexagon/Utils/DrawTrace.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct BenchCase
+{
+    const char* packId;
+    const char* levelId;
+};
+
+constexpr std::array benchCases{
+    BenchCase{"ohvrvanilla_vittorio_romeo_cube_1",
+        "ohvrvanilla_vittorio_romeo_cube_1_apeirogon"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_hypercube_1",
+        "ohvrvanilla_vittorio_romeo_hypercube_1_g-force"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_experimental_1",
+        "ohvrvanilla_vittorio_romeo_experimental_1_stress1"}};
+
+// Seeds are fixed so that every run of the benchmark draws exactly the same
+// frames.
+constexpr hg::replay_file::seed_type baseGameSeed = 123456;
+constexpr std::uint32_t baseInputSeed = 654321;
+
+// Length of the recorded input stream of every case, in ticks.
+constexpr std::size_t recordedTicks =
+    static_cast<std::size_t>(hg::Config::TICKS_PER_SECOND) * 30;
+
+// Records a plausible input stream, where every input state is held for a
+// few ticks like a human player would.
+[[nodiscard]] hg::replay_data recordInputs(const std::uint32_t seed)
+{
+    std::mt19937 en{seed};
+
+    // Values are derived from the engine's output directly, as it is fully
+    // specified by the standard, while the output of distributions differs
+    // between standard library implementations. The modulo bias is
+    // irrelevant here.
+    const auto between = [&](const int min, const int max)
+    {
+        const auto range = static_cast<std::uint32_t>(max - min + 1);
+        return min + static_cast<int>(en() % range);
+    };
+
+    const auto chance = [&](const int percent)
+    { return between(0, 99) < percent; };
+
+    hg::replay_data result;
+
+    while (result.size() < recordedTicks)
+    {
+        const int movement = between(-1, 1);
+        const bool focus = chance(25);
+        const bool swap = chance(2);
+        const int holdTicks = between(5, 40);
+
+        for (int i = 0; i < holdTicks; ++i)
+        {
+            result.record_input(movement < 0, movement > 0, swap && i == 0,
+                focus);
+        }
+    }
+
+    return result;
+}
+
+struct Measurement
+{
+    std::uint64_t frames{0};
+    std::uint64_t drawCalls{0};
+    std::uint64_t vertices{0};
+    double drawSeconds{0.0};
+};
+
+// Plays `rf` until death or until its inputs run out, drawing a frame after
+// every tick. Only the time spent drawing is measured.
+[[nodiscard]] Measurement playReplay(hg::HexagonGame& hg,
+    hg::Utils::DrawTrace& trace, const hg::replay_file& rf)
+{
+    hg.setLastReplay(rf);
+    hg.newGame(rf._pack_id, rf._level_id, rf._first_play, rf._difficulty_mult,
+        /* mExecuteLastReplay */ true);
+
+    trace.clear();
+
+    std::chrono::nanoseconds drawTime{0};
+
+    do
+    {
+        hg.executeTick(1.f /* timescale */);
+
+        const hg::HRTimePoint tpBegin = hg::HRClock::now();
+        hg.executeDraw();
+        drawTime += hg::HRClock::now() - tpBegin;
+    }
+    while (!hg.getStatus().hasDied && hg.mustReplayInput());
+
+    return Measurement{
+        .frames = trace.getFrameCount(),                               //
+        .drawCalls = trace.getTotalCallCount(),                        //
+        .vertices = trace.getTotalVertexCount(),                       //
+        .drawSeconds = std::chrono::duration<double>(drawTime).count() //
+    };
+}
+
+[[nodiscard]] bench::Result makeResult(
+    std::string name, const Measurement& m)
+{
+    const double frames = static_cast<double>(m.frames);
+    const double drawCalls = static_cast<double>(m.drawCalls);
+    const double vertices = static_cast<double>(m.vertices);
+
+    std::vector<bench::Metric> metrics{
+        {"frames", frames},                                  //
+        {"drawCallsPerFrame", drawCalls / frames},           //
+        {"verticesPerFrame", vertices / frames},             //
+        {"usPerFrame", m.drawSeconds * 1'000'000.0 / frames} //
+    };
+
+    return bench::Result{
+        .name = SSVOH_MOVE(name),      //
+        .metrics = SSVOH_MOVE(metrics) //
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+try
+{
+    hg::Config::loadConfig({});
+
+    hg::HGAssets assets{nullptr /* graphicsContext */,
+        nullptr /* steamManager */, true /* headless */};
+
+    hg::ProfileData fakeProfile{hg::GAME_VERSION, "benchProfile", {}, {}};
+    assets.addLocalProfile(SSVOH_MOVE(fakeProfile));
+    assets.pSetCurrent("benchProfile");
+
+    hg::HexagonGame hg{
+        nullptr /* graphicsContext */, //
+        nullptr /* steamManager */,    //
+        nullptr /* discordManager */,  //
+        assets,                        //
+        nullptr /* audio */,           //
+        nullptr /* window */,          //
+        nullptr /* client */           //
+    };
+
+    // No window and no OpenGL context: frames are only recorded.
+    hg::Utils::DrawTrace trace;
+    hg.setDrawTrace(&trace);
+
+    bench::Report report{"RenderTrace"};
+
+    // Headless drawing skips the elements whose textures and fonts are only
+    // loaded with a graphics context.
+    report.addNote(
+        "Text, particles and key icons are not drawn headlessly, their draw "
+        "calls and vertices are missing from these counts.");
+
+    for (std::size_t i = 0; i < benchCases.size(); ++i)
+    {
+        const BenchCase& bc = benchCases[i];
+        const auto inputSeed = baseInputSeed + static_cast<std::uint32_t>(i);
+
+        const hg::replay_file rf{
+            ._version{0},
+            ._player_name{"bench"},
+            ._seed{baseGameSeed + i},
+            ._data{recordInputs(inputSeed)},
+            ._pack_id{bc.packId},
+            ._level_id{bc.levelId},
+            ._first_play{true},
+            ._difficulty_mult{1.f},
+            ._played_score{0.0},
+        };
+
+        // Warm-up, not measured: loads scripts and grows vertex buffers.
+        (void)playReplay(hg, trace, rf);
+
+        report.add(makeResult(bc.levelId, playReplay(hg, trace, rf)));
+    }
+
+    return report.writeJsonIfRequested(argc, argv) ? 0 : 1;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "BenchUtils.hpp"
+
+#include "SSVOpenHexagon/Data/ProfileData.hpp"
+
+#include "SSVOpenHexagon/Global/Assets.hpp"
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+#include "SSVOpenHexagon/Global/Version.hpp"
+
+#include "SSVOpenHexagon/Core/HexagonGame.hpp"
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "SSVOpenHexagon/Utils/AllocationCounter.hpp"
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+SSVOH_DEFINE_ALLOCATION_COUNTER;
+
+namespace {
+
+struct BenchCase
+{
+    const char* packId;
+    const char* levelId;
+};
+
+constexpr std::array benchCases{
+    BenchCase{"ohvrvanilla_vittorio_romeo_cube_1",
+        "ohvrvanilla_vittorio_romeo_cube_1_apeirogon"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_cube_1",
+        "ohvrvanilla_vittorio_romeo_cube_1_pointless"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_hypercube_1",
+        "ohvrvanilla_vittorio_romeo_hypercube_1_acceleradiant"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_hypercube_1",
+        "ohvrvanilla_vittorio_romeo_hypercube_1_g-force"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_orthoplex_1",
+        "ohvrvanilla_vittorio_romeo_orthoplex_1_arcadia"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_orthoplex_1",
+        "ohvrvanilla_vittorio_romeo_orthoplex_1_bipolarity"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_experimental_1",
+        "ohvrvanilla_vittorio_romeo_experimental_1_stress1"},
+    BenchCase{"ohvrvanilla_vittorio_romeo_experimental_1",
+        "ohvrvanilla_vittorio_romeo_experimental_1_curvetest"}};
+
+// Seeds are fixed so that every run of the benchmark simulates exactly the
+// same games with exactly the same inputs.
+constexpr hg::replay_file::seed_type baseGameSeed = 123456;
+constexpr std::uint32_t baseInputSeed = 654321;
+
+// Length of the recorded input stream of every case, in ticks.
+constexpr std::size_t recordedTicks =
+    static_cast<std::size_t>(hg::Config::TICKS_PER_SECOND) * 30;
+
+// Every case is replayed until at least this many ticks have been measured.
+constexpr std::uint64_t minMeasuredTicks = 30'000;
+
+// Records a plausible input stream, where every input state is held for a
+// few ticks like a human player would.
+[[nodiscard]] hg::replay_data recordInputs(const std::uint32_t seed)
+{
+    std::mt19937 en{seed};
+
+    // Values are derived from the engine's output directly, as it is fully
+    // specified by the standard, while the output of distributions differs
+    // between standard library implementations. The modulo bias is
+    // irrelevant here.
+    const auto between = [&](const int min, const int max)
+    {
+        const auto range = static_cast<std::uint32_t>(max - min + 1);
+        return min + static_cast<int>(en() % range);
+    };
+
+    const auto chance = [&](const int percent)
+    { return between(0, 99) < percent; };
+
+    hg::replay_data result;
+
+    while (result.size() < recordedTicks)
+    {
+        const int movement = between(-1, 1);
+        const bool focus = chance(25);
+        const bool swap = chance(2);
+        const int holdTicks = between(5, 40);
+
+        for (int i = 0; i < holdTicks; ++i)
+        {
+            result.record_input(movement < 0, movement > 0, swap && i == 0,
+                focus);
+        }
+    }
+
+    return result;
+}
+
+struct Measurement
+{
+    std::uint64_t runs{0};
+    std::uint64_t ticks{0};
+    std::uint64_t allocations{0};
+    double seconds{0.0};
+
+    void operator+=(const Measurement& rhs) noexcept
+    {
+        runs += rhs.runs;
+        ticks += rhs.ticks;
+        allocations += rhs.allocations;
+        seconds += rhs.seconds;
+    }
+};
+
+// Plays `rf` until death or until its inputs run out, returning the number of
+// ticks executed and the time spent on them.
+[[nodiscard]] Measurement playReplay(
+    hg::HexagonGame& hg, const hg::replay_file& rf)
+{
+    hg.setLastReplay(rf);
+    hg.newGame(rf._pack_id, rf._level_id, rf._first_play, rf._difficulty_mult,
+        /* mExecuteLastReplay */ true);
+
+    Measurement result{.runs = 1};
+
+    const hg::Utils::AllocationCounterScope allocationCounter;
+    const hg::HRTimePoint tpBegin = hg::HRClock::now();
+
+    // The first tick only starts the game, without consuming inputs.
+    do
+    {
+        hg.executeTick(1.f /* timescale */);
+        ++result.ticks;
+    }
+    while (!hg.getStatus().hasDied && hg.mustReplayInput());
+
+    result.seconds =
+        std::chrono::duration<double>(hg::HRClock::now() - tpBegin).count();
+    result.allocations = allocationCounter.count();
+
+    return result;
+}
+
+[[nodiscard]] bench::Result makeResult(
+    std::string name, const Measurement& m)
+{
+    const double ticks = static_cast<double>(m.ticks);
+    const double allocations = static_cast<double>(m.allocations);
+
+    std::vector<bench::Metric> metrics{
+        {"runs", static_cast<double>(m.runs)},                //
+        {"ticks", ticks},                                     //
+        {"ticksPerSecond", ticks / m.seconds},                //
+        {"nsPerUpdate", m.seconds * 1'000'000'000.0 / ticks}, //
+        {"allocationsPerTick", allocations / ticks}           //
+    };
+
+    return bench::Result{
+        .name = SSVOH_MOVE(name),      //
+        .metrics = SSVOH_MOVE(metrics) //
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+try
+{
+    hg::Config::loadConfig({});
+
+    hg::HGAssets assets{nullptr /* graphicsContext */,
+        nullptr /* steamManager */, true /* headless */};
+
+    hg::ProfileData fakeProfile{hg::GAME_VERSION, "benchProfile", {}, {}};
+    assets.addLocalProfile(SSVOH_MOVE(fakeProfile));
+    assets.pSetCurrent("benchProfile");
+
+    hg::HexagonGame hg{
+        nullptr /* graphicsContext */, //
+        nullptr /* steamManager */,    //
+        nullptr /* discordManager */,  //
+        assets,                        //
+        nullptr /* audio */,           //
+        nullptr /* window */,          //
+        nullptr /* client */           //
+    };
+
+    bench::Report report{"SimulationThroughput"};
+    Measurement total;
+
+    for (std::size_t i = 0; i < benchCases.size(); ++i)
+    {
+        const BenchCase& bc = benchCases[i];
+        const auto inputSeed = baseInputSeed + static_cast<std::uint32_t>(i);
+
+        const hg::replay_file rf{
+            ._version{0},
+            ._player_name{"bench"},
+            ._seed{baseGameSeed + i},
+            ._data{recordInputs(inputSeed)},
+            ._pack_id{bc.packId},
+            ._level_id{bc.levelId},
+            ._first_play{true},
+            ._difficulty_mult{1.f},
+            ._played_score{0.0},
+        };
+
+        // Warm-up, not measured: loads scripts and fills caches.
+        (void)playReplay(hg, rf);
+
+        Measurement m;
+        while (m.ticks < minMeasuredTicks)
+        {
+            m += playReplay(hg, rf);
+        }
+
+        report.add(makeResult(bc.levelId, m));
+        total += m;
+    }
+
+    report.add(makeResult("total", total));
+    return report.writeJsonIfRequested(argc, argv) ? 0 : 1;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "BenchUtils.hpp"
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "SSVOpenHexagon/Components/CWall.hpp"
+#include "SSVOpenHexagon/Components/SpeedData.hpp"
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+#include "SSVOpenHexagon/Utils/Math.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace {
+
+constexpr int trigCalls = 10'000'000;
+
+constexpr std::size_t wallCount = 1'000;
+constexpr int measuredTicks = 2'000;
+
+// Prevents the compiler from discarding the benchmarked computations.
+volatile float sink;
+
+template <typename F>
+[[nodiscard]] double measureTrig(F&& f)
+{
+    float acc = 0.f;
+
+    const hg::HRTimePoint tpBegin = hg::HRClock::now();
+
+    for (int i = 0; i < trigCalls; ++i)
+    {
+        acc += f(static_cast<float>(i) * 0.001f);
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(hg::HRClock::now() - tpBegin).count();
+
+    sink = acc;
+    return seconds * 1'000'000'000.0 / trigCalls;
+}
+
+// Curving walls moving towards the center. With a zero acceleration the curve
+// rotation is computed once per wall, otherwise it is recomputed every tick.
+[[nodiscard]] double measureCurvingWalls(const float curveAccel)
+{
+    std::vector<hg::CWall> walls;
+    walls.reserve(wallCount);
+
+    for (std::size_t i = 0; i < wallCount; ++i)
+    {
+        walls.emplace_back(6u /* sides */, 0.f, 0.f, 0.f, 0.f,
+            sf::Vector2f::Zero, static_cast<int>(i % 6), 40.f /* thickness */,
+            1'000'000.f /* distance */, hg::SpeedData{0.01f},
+            hg::SpeedData{1.f, curveAccel, 0.5f, 2.f, true}, 0.f);
+    }
+
+    const hg::HRTimePoint tpBegin = hg::HRClock::now();
+
+    for (int t = 0; t < measuredTicks; ++t)
+    {
+        for (hg::CWall& w : walls)
+        {
+            w.update(2'000'000.f, 0.f, sf::Vector2f::Zero, 1.f);
+        }
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(hg::HRClock::now() - tpBegin).count();
+
+    sink = walls.front().getVertexPositions()[0].x;
+    return seconds * 1'000'000.0 / measuredTicks;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+try
+{
+    bench::Report report{"SinCos"};
+
+    const double nsStd = measureTrig(
+        [](const float rad) { return std::sin(rad) + std::cos(rad); });
+
+    const double nsUtils = measureTrig(
+        [](const float rad)
+        {
+            const hg::Utils::SinCos sc = hg::Utils::sinCos(rad);
+            return sc.sin + sc.cos;
+        });
+
+    report.add(bench::Result{
+        .name = "sincos", //
+        .metrics = {
+            {"stdNsPerCall", nsStd},    //
+            {"utilsNsPerCall", nsUtils} //
+        }                               //
+    });
+
+    std::vector<bench::Metric> wallMetrics{
+        {"constantCurveUsPerTick", measureCurvingWalls(0.f)},      //
+        {"acceleratingCurveUsPerTick", measureCurvingWalls(0.01f)} //
+    };
+
+    report.add(bench::Result{
+        .name = "curvingWalls" + std::to_string(wallCount), //
+        .metrics = SSVOH_MOVE(wallMetrics)                  //
+    });
+
+    return report.writeJsonIfRequested(argc, argv) ? 0 : 1;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
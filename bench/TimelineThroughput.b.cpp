@@ -0,0 +1,178 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "BenchUtils.hpp"
+
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "SSVOpenHexagon/Utils/AllocationCounter.hpp"
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+#include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
+#include "SSVOpenHexagon/Utils/Timeline2.hpp"
+#include "SSVOpenHexagon/Utils/Utils.hpp"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstdint>
+
+SSVOH_DEFINE_ALLOCATION_COUNTER;
+
+namespace {
+
+struct BenchCase
+{
+    const char* name;
+    const char* script; // Must define `onStep`.
+};
+
+// Patterns commonly found in level scripts, each emitting thousands of
+// timeline actions per second of game time.
+constexpr std::array benchCases{
+    BenchCase{"waitOnly",
+        "function onStep() for i = 1, 200 do t_wait(0) end end"},
+    BenchCase{"evalOnly",
+        "function onStep() for i = 1, 200 do t_eval(\"x = x + 1\") end end"},
+    BenchCase{"evalAndWait",
+        "function onStep() for i = 1, 100 do "
+        "t_eval(\"x = x + 1\") t_wait(0.25) end end"},
+    BenchCase{"distinctEvals",
+        "function onStep() for i = 1, 100 do "
+        "t_eval(\"x = x + \" .. (i % 8)) t_wait(0) end end"}};
+
+// Simulated game time of every case, in ticks.
+constexpr int simulatedTicks =
+    static_cast<int>(hg::Config::TICKS_PER_SECOND) * 10;
+
+struct Measurement
+{
+    std::uint64_t actions{0};
+    std::uint64_t allocations{0};
+    std::uint64_t arenaSlots{0};
+    double seconds{0.0};
+};
+
+// Runs `bc` like the main timeline of a level: every time the timeline ends,
+// it is cleared and refilled by `onStep`.
+[[nodiscard]] Measurement runCase(const BenchCase& bc)
+{
+    hg::Lua::LuaContext lua;
+
+    std::set<std::string, std::less<>> codePool;
+
+    hg::Utils::timeline2_arena arena;
+    hg::Utils::timeline2 timeline{arena};
+    hg::Utils::timeline2_runner runner;
+
+    lua.writeVariable("t_eval",
+        [&](const std::string_view mCode)
+        {
+            auto it = codePool.find(mCode);
+            if (it == codePool.end())
+            {
+                it = codePool.emplace(mCode).first;
+            }
+
+            timeline.append_do([&lua, code = &*it]
+                { hg::Utils::runLuaCode(lua, *code); });
+        });
+
+    lua.writeVariable("t_wait",
+        [&](const double mDuration)
+        { timeline.append_wait_for_sixths(mDuration); });
+
+    lua.executeCode("x = 0");
+    lua.executeCode(bc.script);
+
+    const auto timeStep =
+        std::chrono::duration_cast<hg::Utils::timeline2::duration>(
+            std::chrono::duration<double>{1.0 / hg::Config::TICKS_PER_SECOND});
+
+    Measurement result;
+
+    const auto simulate = [&](const int ticks)
+    {
+        hg::Utils::timeline2::time_point tp{};
+
+        for (int i = 0; i < ticks; ++i)
+        {
+            tp += timeStep;
+
+            if (runner.update(timeline, tp) ==
+                hg::Utils::timeline2_runner::outcome::finished)
+            {
+                timeline.clear();
+                lua.callLuaFunction<void>("onStep");
+                runner = {};
+
+                result.actions += timeline.size();
+            }
+        }
+    };
+
+    // Warm-up, not measured: fills the arena and the code pool.
+    simulate(simulatedTicks / 10);
+    result.actions = 0;
+
+    const hg::Utils::AllocationCounterScope allocationCounter;
+    const hg::HRTimePoint tpBegin = hg::HRClock::now();
+
+    simulate(simulatedTicks);
+
+    result.seconds =
+        std::chrono::duration<double>(hg::HRClock::now() - tpBegin).count();
+    result.allocations = allocationCounter.count();
+    result.arenaSlots = arena.size();
+
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+try
+{
+    bench::Report report{"TimelineThroughput"};
+
+    for (const BenchCase& bc : benchCases)
+    {
+        const Measurement m = runCase(bc);
+
+        const double actions = static_cast<double>(m.actions);
+        const double allocations = static_cast<double>(m.allocations);
+
+        std::vector<bench::Metric> metrics{
+            {"actions", actions},                                   //
+            {"actionsPerSecond", actions / m.seconds},              //
+            {"nsPerAction", m.seconds * 1'000'000'000.0 / actions}, //
+            {"allocationsPerAction", allocations / actions},        //
+            {"arenaSlots", static_cast<double>(m.arenaSlots)}       //
+        };
+
+        report.add(bench::Result{
+            .name = bc.name,               //
+            .metrics = SSVOH_MOVE(metrics) //
+        });
+    }
+
+    return report.writeJsonIfRequested(argc, argv) ? 0 : 1;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
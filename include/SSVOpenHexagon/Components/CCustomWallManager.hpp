@@ -11,6 +11,7 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Color.hpp>
 
+#include <span>
 #include <vector>
 #include <cstdint>
 
@@ -40,6 +41,14 @@ class CCustomWallManager
     [[nodiscard]] bool checkValidVertexIdxAndHandle(
         const CCustomWallHandle h, const int vertexIdx, const char* msg);
 
+    [[nodiscard]] bool checkValidBatchSize(const std::size_t handleCount,
+        const std::size_t valueCount, const std::size_t valuesPerHandle,
+        const char* msg);
+
+    template <typename F>
+    void forEachValidHandle(std::span<const CCustomWallHandle> cwHandles,
+        const char* msg, F&& f);
+
     void destroyUnchecked(const CCustomWallHandle cwHandle);
 
 public:
@@ -77,6 +86,18 @@ public:
     void setVertexColor4Same(
         const CCustomWallHandle cwHandle, const sf::Color& color);
 
+    // Batched variants of the functions above, applied to every wall in
+    // `cwHandles`: `positions` holds four positions per wall, `offsets` and
+    // `colors` one value per wall. Invalid handles are skipped.
+    void setVertexPos4Many(std::span<const CCustomWallHandle> cwHandles,
+        std::span<const sf::Vector2f> positions);
+
+    void moveVertexPos4SameMany(std::span<const CCustomWallHandle> cwHandles,
+        std::span<const sf::Vector2f> offsets);
+
+    void setVertexColor4SameMany(std::span<const CCustomWallHandle> cwHandles,
+        std::span<const sf::Color> colors);
+
     [[nodiscard]] const sf::Vector2f& getVertexPos(
         const CCustomWallHandle cwHandle, const int vertexIdx);
 
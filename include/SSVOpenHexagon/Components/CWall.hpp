@@ -7,10 +7,10 @@
 #include "SSVOpenHexagon/Components/SpeedData.hpp"
 #include "SSVOpenHexagon/Utils/PointInPolygon.hpp"
 #include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Math.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 
 #include <SFML/System/Vector2.hpp>
-#include <SFML/Base/Math/Cos.hpp>
-#include <SFML/Base/Math/Sin.hpp>
 
 #include <array>
 #include <cstdint>
@@ -25,6 +25,11 @@ private:
     SpeedData _speed;
     SpeedData _curve;
 
+    // Rotation of the last curve step. Most walls curve at a constant speed,
+    // so it is only recomputed when the curve angle changes.
+    float _curveRad;
+    Utils::SinCos _curveSinCos;
+
     float _hueMod;
     bool _killed;
 
@@ -44,13 +49,9 @@ public:
         const sf::Vector2f& centerPos, const float ft);
 
     [[gnu::always_inline]] void moveVertexAlongCurveImpl(sf::Vector2f& vertex,
-        const sf::Vector2f& centerPos, const float xSin,
-        const float xCos) const noexcept
+        const sf::Vector2f& centerPos, const Utils::SinCos& sc) const noexcept
     {
-        const float tempX = vertex.x - centerPos.x;
-        const float tempY = vertex.y - centerPos.y;
-        vertex.x = tempX * xCos - tempY * xSin + centerPos.x;
-        vertex.y = tempX * xSin + tempY * xCos + centerPos.y;
+        vertex = Utils::Strict::rotatedAround(vertex, centerPos, sc);
     }
 
     [[gnu::always_inline]] float getCurveRadians(const float ft) const noexcept
@@ -59,13 +60,17 @@ public:
         return _curve._speed * divBy60 * ft;
     }
 
-    [[gnu::always_inline]] void moveVertexAlongCurve(sf::Vector2f& vertex,
-        const sf::Vector2f& centerPos, const float ft) const noexcept
+    [[gnu::always_inline]] Utils::SinCos getCurveSinCos(
+        const float ft) const noexcept
     {
         const float rad = getCurveRadians(ft);
+        return rad == _curveRad ? _curveSinCos : Utils::sinCos(rad);
+    }
 
-        moveVertexAlongCurveImpl(
-            vertex, centerPos, sf::base::sin(rad), sf::base::cos(rad));
+    [[gnu::always_inline]] void moveVertexAlongCurve(sf::Vector2f& vertex,
+        const sf::Vector2f& centerPos, const float ft) const noexcept
+    {
+        moveVertexAlongCurveImpl(vertex, centerPos, getCurveSinCos(ft));
     }
 
     void draw(sf::Color color, Utils::FastVertexVectorTris& wallQuads);
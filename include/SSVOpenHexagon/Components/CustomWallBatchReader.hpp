@@ -0,0 +1,138 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Components/CCustomWallHandle.hpp"
+
+#include <SSVUtils/Core/Log/Log.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <SFML/Base/Optional.hpp>
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Reads the arrays passed to the batched custom wall functions into
+// contiguous buffers, reused across calls to avoid allocations. `Array` is a
+// `Lua::LuaContext::ArrayView`, or any type with the same `size` and `tryGet`
+// members. The returned spans are valid until the next read of the same kind.
+class CustomWallBatchReader
+{
+private:
+    std::vector<CCustomWallHandle> _handles;
+    std::vector<sf::Vector2f> _vectors;
+    std::vector<sf::Color> _colors;
+
+    // Components outside of `[0, 255]` are clamped, instead of wrapping
+    // around when narrowed.
+    [[nodiscard]] static std::uint8_t toColorComponent(const int x) noexcept
+    {
+        return static_cast<std::uint8_t>(std::clamp(x, 0, 255));
+    }
+
+    static void logError(const char* fnName, const char* error)
+    {
+        ssvu::lo("hg::LuaScripting::" + std::string{fnName}) << error << '\n';
+    }
+
+public:
+    // Elements that are not numbers become invalid handles, which are skipped
+    // and reported like any other invalid handle. Reading them as `0` would
+    // target the custom wall with handle `0`.
+    template <typename Array>
+    [[nodiscard]] std::span<const CCustomWallHandle> readHandles(
+        const Array& array)
+    {
+        _handles.clear();
+
+        for (std::size_t i = 0; i < array.size(); ++i)
+        {
+            CCustomWallHandle h = -1;
+            (void)array.tryGet(i, h);
+
+            _handles.emplace_back(h);
+        }
+
+        return _handles;
+    }
+
+    // Reads an array of `{x0, y0, x1, y1, ...}` coordinates. Returns
+    // `nullOpt` if its length is odd or if any element is not a number.
+    template <typename Array>
+    [[nodiscard]] sf::base::Optional<std::span<const sf::Vector2f>>
+    readVectors(const Array& array, const char* fnName)
+    {
+        if (array.size() % 2 != 0) [[unlikely]]
+        {
+            logError(fnName, "Coordinate array has an odd length");
+            return sf::base::nullOpt;
+        }
+
+        _vectors.clear();
+
+        for (std::size_t i = 0; i < array.size(); i += 2)
+        {
+            sf::Vector2f v;
+
+            if (!array.tryGet(i, v.x) || !array.tryGet(i + 1, v.y))
+                [[unlikely]]
+            {
+                logError(fnName, "Coordinate array has a non-number element");
+                return sf::base::nullOpt;
+            }
+
+            _vectors.emplace_back(v);
+        }
+
+        return sf::base::makeOptional(std::span<const sf::Vector2f>{_vectors});
+    }
+
+    // Reads an array of `{r0, g0, b0, a0, r1, ...}` components. Returns
+    // `nullOpt` if its length is not a multiple of four or if any element is
+    // not a number.
+    template <typename Array>
+    [[nodiscard]] sf::base::Optional<std::span<const sf::Color>> readColors(
+        const Array& array, const char* fnName)
+    {
+        if (array.size() % 4 != 0) [[unlikely]]
+        {
+            logError(fnName, "Color array length is not a multiple of four");
+            return sf::base::nullOpt;
+        }
+
+        _colors.clear();
+
+        for (std::size_t i = 0; i < array.size(); i += 4)
+        {
+            int c[4];
+
+            if (!array.tryGet(i, c[0]) || !array.tryGet(i + 1, c[1]) ||
+                !array.tryGet(i + 2, c[2]) || !array.tryGet(i + 3, c[3]))
+                [[unlikely]]
+            {
+                logError(fnName, "Color array has a non-number element");
+                return sf::base::nullOpt;
+            }
+
+            _colors.emplace_back(toColorComponent(c[0]),
+                toColorComponent(c[1]), toColorComponent(c[2]),
+                toColorComponent(c[3]));
+        }
+
+        return sf::base::makeOptional(std::span<const sf::Color>{_colors});
+    }
+};
+
+} // namespace hg
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
+
 namespace hg {
 
 struct SpeedData
@@ -30,7 +32,7 @@ struct SpeedData
             return;
         }
 
-        _speed += _accel * ft;
+        _speed = Utils::Strict::mulAdd(_accel, ft, _speed);
 
         if (_speed > _max)
         {
@@ -12,6 +12,10 @@ struct CustomTimeline
 {
     Utils::timeline2 _timeline;
     Utils::timeline2_runner _runner;
+
+    explicit CustomTimeline(Utils::timeline2_arena& arena) noexcept
+        : _timeline{arena}, _runner{}
+    {}
 };
 
 } // namespace hg
@@ -10,23 +10,36 @@
 
 #include <vector>
 
+#include <cstddef>
+
 namespace hg {
 
 struct CustomTimeline;
 
+namespace Utils {
+
+class timeline2_arena;
+
+} // namespace Utils
+
 class CustomTimelineManager
 {
 private:
+    Utils::timeline2_arena& _arena;
+
+    // Timelines past `_count` are unused, but kept around so that their
+    // storage can be reused by the next `create` calls.
     std::vector<CustomTimeline> _timelines;
+    std::size_t _count{0};
 
 public:
-    CustomTimelineManager();
+    explicit CustomTimelineManager(Utils::timeline2_arena& arena);
     ~CustomTimelineManager();
 
     [[nodiscard]] bool isHandleValid(
         const CustomTimelineHandle h) const noexcept;
 
-    void clear() noexcept;
+    void clear();
 
     void updateAllTimelines(const HRTimePoint tp);
 
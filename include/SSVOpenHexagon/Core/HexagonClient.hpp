@@ -6,6 +6,8 @@
 
 #include "SSVOpenHexagon/Online/Sodium.hpp"
 #include "SSVOpenHexagon/Online/DatabaseRecords.hpp"
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
 
 #include "SSVOpenHexagon/Utils/Clock.hpp"
 
@@ -13,10 +15,15 @@
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/Packet.hpp>
 
-#include <deque>
+#include <moodycamel/blockingconcurrentqueue.h>
+#include <moodycamel/concurrentqueue.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <SFML/Base/Optional.hpp>
 #include <sstream>
-#include <unordered_set>
+#include <thread>
 #include <variant>
 #include <vector>
 
@@ -31,6 +38,10 @@ namespace hg {
 struct replay_file;
 struct compressed_replay_file;
 
+// The client protocol (socket I/O, retries, encryption, heartbeats) runs on a
+// dedicated I/O thread. Public member functions can be called from the game
+// thread: requests are queued and executed in order on the I/O thread, and
+// their outcome is reported back through `pollEvent`.
 class HexagonClient
 {
 public:
@@ -57,28 +68,36 @@ public:
     struct ELogoutFailure           { };
     struct EDeleteAccountSuccess    { };
     struct EDeleteAccountFailure    { std::string error; };
-    struct EReceivedTopScores       { std::string levelValidator; std::vector<Database::ProcessedScore> scores; };
-    struct EReceivedOwnScore        { std::string levelValidator; Database::ProcessedScore score; };
+    struct EReceivedTopScores       { LevelValidatorId levelValidatorId; std::vector<Database::ProcessedScore> scores; };
+    struct EReceivedOwnScore        { LevelValidatorId levelValidatorId; Database::ProcessedScore score; };
+    struct EReceivedScoresUnchanged { LevelValidatorId levelValidatorId; LeaderboardVersion version; };
+    struct EReceivedScoresDelta     { LevelValidatorId levelValidatorId; LeaderboardVersion baseVersion; LeaderboardVersion version; LeaderboardDelta delta; sf::base::Optional<Database::ProcessedScore> ownScore; };
+    struct EScoresBatchRejected     { std::vector<LevelValidatorId> levelValidatorIds; std::string error; };
+    struct EReplayAccepted          { LevelValidatorId levelValidatorId; double score; };
     struct EGameVersionMismatch     { };
     struct EProtocolVersionMismatch { };
     // clang-format on
 
-    using Event = std::variant<  //
-        EConnectionSuccess,      //
-        EConnectionFailure,      //
-        EKicked,                 //
-        ERegistrationSuccess,    //
-        ERegistrationFailure,    //
-        ELoginSuccess,           //
-        ELoginFailure,           //
-        ELogoutSuccess,          //
-        ELogoutFailure,          //
-        EDeleteAccountSuccess,   //
-        EDeleteAccountFailure,   //
-        EReceivedTopScores,      //
-        EReceivedOwnScore,       //
-        EGameVersionMismatch,    //
-        EProtocolVersionMismatch //
+    using Event = std::variant<   //
+        EConnectionSuccess,       //
+        EConnectionFailure,       //
+        EKicked,                  //
+        ERegistrationSuccess,     //
+        ERegistrationFailure,     //
+        ELoginSuccess,            //
+        ELoginFailure,            //
+        ELogoutSuccess,           //
+        ELogoutFailure,           //
+        EDeleteAccountSuccess,    //
+        EDeleteAccountFailure,    //
+        EReceivedTopScores,       //
+        EReceivedOwnScore,        //
+        EReceivedScoresUnchanged, //
+        EReceivedScoresDelta,     //
+        EScoresBatchRejected,     //
+        EReplayAccepted,          //
+        EGameVersionMismatch,     //
+        EProtocolVersionMismatch  //
         >;
 
 private:
@@ -102,15 +121,24 @@ private:
     const SodiumPSKeys _clientPSKeys;
     sf::base::Optional<SodiumPublicKeyArray> _serverPublicKey;
     sf::base::Optional<SodiumRTKeys> _clientRTKeys;
+    std::atomic<bool> _hasRTKeys;
 
-    State _state;
+    std::atomic<State> _state;
 
     sf::base::Optional<std::uint64_t> _loginToken;
+
+    // Written by the I/O thread, read by the game thread.
+    mutable std::mutex _sharedDataMutex;
     sf::base::Optional<std::string> _loginName;
+    LevelValidatorTable _levelValidatorsSupportedByServer;
 
-    std::deque<Event> _events;
+    using Command = std::function<void()>;
 
-    std::unordered_set<std::string> _levelValidatorsSupportedByServer;
+    moodycamel::BlockingConcurrentQueue<Command> _commands;
+    moodycamel::ConcurrentQueue<Event> _events;
+
+    std::atomic<bool> _ioThreadRunning;
+    std::thread _ioThread;
 
     [[nodiscard]] bool initializeTicketSteamID();
     [[nodiscard]] bool initializeTcpSocket();
@@ -132,13 +160,20 @@ private:
     [[nodiscard]] bool sendDeleteAccount(
         const std::uint64_t steamId, const std::string& passwordHash);
     [[nodiscard]] bool sendRequestTopScores(
-        const std::uint64_t loginToken, const std::string& levelValidator);
+        const std::uint64_t loginToken,
+        const LevelValidatorId levelValidatorId);
     [[nodiscard]] bool sendRequestOwnScore(
-        const std::uint64_t loginToken, const std::string& levelValidator);
+        const std::uint64_t loginToken,
+        const LevelValidatorId levelValidatorId);
     [[nodiscard]] bool sendRequestTopScoresAndOwnScore(
-        const std::uint64_t loginToken, const std::string& levelValidator);
+        const std::uint64_t loginToken,
+        const LevelValidatorId levelValidatorId);
+    [[nodiscard]] bool sendRequestTopScoresAndOwnScoreBatch(
+        const std::uint64_t loginToken,
+        const std::vector<CachedLeaderboardVersion>& cachedVersions);
     [[nodiscard]] bool sendStartedGame(
-        const std::uint64_t loginToken, const std::string& levelValidator);
+        const std::uint64_t loginToken,
+        const LevelValidatorId levelValidatorId);
     [[nodiscard]] bool sendCompressedReplay(const std::uint64_t loginToken,
         const std::string& levelValidator,
         const compressed_replay_file& compressedReplayFile);
@@ -155,6 +190,26 @@ private:
 
     bool sendHeartbeatIfNecessary();
 
+    bool connectImpl();
+    void disconnectImpl();
+
+    bool tryRegisterImpl(const std::string& name, const std::string& password);
+    bool tryLoginImpl(const std::string& name, const std::string& password);
+    bool tryLogoutFromServerImpl();
+    bool tryDeleteAccountImpl(const std::string& password);
+    bool tryRequestTopScoresImpl(const LevelValidatorId levelValidatorId);
+    bool tryRequestOwnScoreImpl(const LevelValidatorId levelValidatorId);
+    bool tryRequestTopScoresAndOwnScoreImpl(
+        const LevelValidatorId levelValidatorId);
+    bool tryRequestTopScoresAndOwnScoreBatchImpl(
+        const std::vector<CachedLeaderboardVersion>& cachedVersions);
+    bool trySendStartedGameImpl(const std::string& levelValidator);
+    bool trySendCompressedReplayImpl(const std::string& levelValidator,
+        const compressed_replay_file& compressedReplayFile);
+
+    void run();
+    void runIteration();
+
     void addEvent(const Event& e);
 
     template <typename... Ts>
@@ -173,18 +228,21 @@ public:
     HexagonClient(const HexagonClient&) = delete;
     HexagonClient(HexagonClient&&) = delete;
 
+    // The `try*` functions return whether the request was queued, not whether
+    // it succeeded.
     bool connect();
-    void disconnect();
-
-    void update();
+    bool disconnect();
 
     bool tryRegister(const std::string& name, const std::string& password);
     bool tryLogin(const std::string& name, const std::string& password);
     bool tryLogoutFromServer();
     bool tryDeleteAccount(const std::string& password);
-    bool tryRequestTopScores(const std::string& levelValidator);
-    bool tryRequestOwnScore(const std::string& levelValidator);
-    bool tryRequestTopScoresAndOwnScore(const std::string& levelValidator);
+    bool tryRequestTopScores(const LevelValidatorId levelValidatorId);
+    bool tryRequestOwnScore(const LevelValidatorId levelValidatorId);
+    bool tryRequestTopScoresAndOwnScore(
+        const LevelValidatorId levelValidatorId);
+    bool tryRequestTopScoresAndOwnScoreBatch(
+        std::vector<CachedLeaderboardVersion>&& cachedVersions);
     bool trySendStartedGame(const std::string& levelValidator);
     bool trySendCompressedReplay(const std::string& levelValidator,
         const compressed_replay_file& compressedReplayFile);
@@ -192,13 +250,15 @@ public:
     [[nodiscard]] State getState() const noexcept;
     [[nodiscard]] bool hasRTKeys() const noexcept;
 
-    [[nodiscard]] const sf::base::Optional<std::string>&
-    getLoginName() const noexcept;
+    [[nodiscard]] sf::base::Optional<std::string> getLoginName() const;
 
     [[nodiscard]] sf::base::Optional<Event> pollEvent();
 
     [[nodiscard]] bool isLevelSupportedByServer(
-        const std::string& levelValidator) const noexcept;
+        const std::string& levelValidator) const;
+
+    [[nodiscard]] sf::base::Optional<LevelValidatorId> getLevelValidatorId(
+        const std::string& levelValidator) const;
 };
 
 } // namespace hg
@@ -7,7 +7,9 @@
 #include "SSVOpenHexagon/Core/CustomTimelineManager.hpp"
 #include "SSVOpenHexagon/Core/HGStatus.hpp"
 #include "SSVOpenHexagon/Core/RandomNumberGenerator.hpp"
+#include "SSVOpenHexagon/Core/RenderSnapshot.hpp"
 #include "SSVOpenHexagon/Core/Replay.hpp"
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
 
 #include "SSVOpenHexagon/Data/LevelStatus.hpp"
 #include "SSVOpenHexagon/Data/MusicData.hpp"
@@ -16,9 +18,14 @@
 #include "SSVOpenHexagon/Components/CPlayer.hpp"
 
 #include "SSVOpenHexagon/Utils/Utils.hpp"
+#include "SSVOpenHexagon/Utils/DrawTrace.hpp"
 #include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
 #include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Layers3D.hpp"
+#include "SSVOpenHexagon/Utils/ParticleSystem.hpp"
 #include "SSVOpenHexagon/Utils/Timeline2.hpp"
+#include "SSVOpenHexagon/Utils/TripleBuffer.hpp"
+#include "SSVOpenHexagon/Utils/Clock.hpp"
 
 #include "SSVOpenHexagon/Components/CCustomWallManager.hpp"
 
@@ -29,6 +36,7 @@
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -38,7 +46,12 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Clock.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <unordered_set>
 #include <functional>
@@ -46,6 +59,7 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <thread>
 
 struct ImGuiInputTextCallbackData;
 
@@ -100,6 +114,10 @@ private:
         sf::Text text;
         sf::Text replayText;
 
+        // Last strings set into `timeText` and `text`.
+        std::string timeTextString;
+        std::string textString;
+
         TextUI(HGAssets& mAssets);
     };
 
@@ -139,6 +157,18 @@ private:
     std::vector<std::string> ilcLuaTrackedResults;
     bool debugPause{false};
 
+#ifdef SSVOH_ENABLE_TICK_PROFILER
+    TickProfiler tickProfiler;
+#endif
+    bool dumpProfilesOnDeath{false};
+
+    // Number of draw calls issued by the frame being drawn and by the last
+    // complete frame. Counted even when no window is attached.
+    std::uint32_t frameDrawCalls{0};
+    std::uint32_t lastFrameDrawCalls{0};
+
+    Utils::DrawTrace* drawTrace{nullptr};
+
     std::vector<std::string> execScriptPackPathContext;
 
 public:
@@ -167,49 +197,53 @@ private:
     Lua::LuaContext lua;
     std::unordered_set<std::string> calledDeprecatedFunctions;
 
+    // The automatic Lua garbage collector is stopped during gameplay. Garbage
+    // is instead collected incrementally in the frame time left after
+    // `draw`, or between ticks when executing headlessly.
+    sf::base::Optional<HRTimePoint> luaGCFrameStart;
+    int luaGCMemoryLimitKB{0};
+
+    void startManualLuaGC();
+    void markLuaGCFrameStart();
+    void stepLuaGC(int stepSizeKB, std::chrono::microseconds budget);
+    void stepLuaGCInFrameBudget();
+
     LevelStatus levelStatus;
     MusicData musicData;
     StyleData styleData;
 
-    Utils::timeline2 timeline;
+    // Shared by all the timelines below, must outlive them.
+    Utils::timeline2_arena timelineArena;
+
+    Utils::timeline2 timeline{timelineArena};
     Utils::timeline2_runner timelineRunner;
 
-    Utils::timeline2 eventTimeline;
+    Utils::timeline2 eventTimeline{timelineArena};
     Utils::timeline2_runner eventTimelineRunner;
 
-    Utils::timeline2 messageTimeline;
+    Utils::timeline2 messageTimeline{timelineArena};
     Utils::timeline2_runner messageTimelineRunner;
 
-    CustomTimelineManager _customTimelineManager;
+    CustomTimelineManager _customTimelineManager{timelineArena};
 
+    // Code passed to `t_eval`, `e_eval` and `ct_eval`, interned so that the
+    // timeline actions can refer to it without copying it every time. The
+    // actions share ownership of their code, so the pool can be emptied at
+    // any time to bound its size. Keys view the strings they map to.
+    std::map<std::string_view, std::shared_ptr<const std::string>, std::less<>>
+        luaCodePool;
+    [[nodiscard]] std::shared_ptr<const std::string> internLuaCode(
+        std::string_view mCode);
 
     Utils::FastVertexVectorTris flashPolygon;
 
-    struct Particle
-    {
-        sf::Sprite sprite;
-        sf::Vector2f velocity;
-        float angularVelocity;
-    };
-
-    struct TrailParticle
-    {
-        sf::Sprite sprite;
-        float angle;
-    };
-
-    struct SwapParticle
-    {
-        sf::Sprite sprite;
-        sf::Vector2f velocity;
-    };
-
     sf::Texture* txStarParticle;
     sf::Texture* txSmallCircle;
 
-    std::vector<Particle> particles;
-    std::vector<TrailParticle> trailParticles;
-    std::vector<SwapParticle> swapParticles;
+    Utils::ParticleSystem particles;
+    Utils::ParticleSystem trailParticles;
+    Utils::ParticleSystem swapParticles;
+
     bool mustSpawnPBParticles{false};
 
     struct SwapParticleSpawnInfo
@@ -265,9 +299,15 @@ private:
 
     random_number_generator::seed_type lastSeed{};
     replay_data lastReplayData{};
+    replay_state_hashes lastStateHashes{};
     bool lastFirstPlay{};
     double lastPlayedScore{};
 
+    // Number of simulated ticks since the start of the game, used to take and
+    // verify periodic state hashes.
+    std::uint64_t stateHashTicks{0};
+    bool replayDiverged{false};
+
     std::string restartId;
     float difficultyMult{1};
     int inputImplLastMovement{0};
@@ -312,6 +352,22 @@ public:
 
     void setMustStart(const bool x);
 
+    // Prints per-stage tick timings to `stdout` when the player dies. Only
+    // effective if built with `SSVOH_ENABLE_TICK_PROFILER`.
+    void setDumpProfilesOnDeath(const bool x);
+
+    // Runs a single fixed-timestep simulation tick (`update` and
+    // `postUpdate`), as done by `executeGameUntilDeath`.
+    void executeTick(const float timescale);
+
+    // Records every draw call into `mDrawTrace`, if not null. With a trace,
+    // `draw` also runs without a window: nothing is actually drawn, and the
+    // textured elements whose textures are not loaded are skipped.
+    void setDrawTrace(Utils::DrawTrace* mDrawTrace);
+
+    // Draws a single frame, as done by the game loop.
+    void executeDraw();
+
     bool executeRandomInputs{false};
     bool alwaysSpinRight{false};
 
@@ -351,6 +407,7 @@ private:
     void start();
 
     void initKeyIcons();
+    void initCameras();
     void initFlashEffect(int r, int g, int b);
 
     // Fast-forward
@@ -388,6 +445,14 @@ private:
     void updateParticles(float mFT);
     void updateTrailParticles(float mFT);
     void updateSwapParticles(float mFT);
+    void updateStateHashes();
+    void updateRichPresence(const float mFT);
+
+    // Restarts the level or goes back to the menu if requested. Returns
+    // `false` if the game went back to the menu.
+    [[nodiscard]] bool updateStateChange();
+
+    [[nodiscard]] std::uint64_t computeStateHash() const noexcept;
 
     // Post update methods
     void postUpdate();
@@ -395,6 +460,8 @@ private:
 
     // Draw methods
     void draw();
+    void buildRenderSnapshot(RenderSnapshot& snapshot);
+    void drawRenderSnapshot(const RenderSnapshot& snapshot);
 
     // Gameplay methods
     void incrementDifficulty();
@@ -410,9 +477,9 @@ private:
     void drawText(const sf::RenderStates& mStates);
     void drawKeyIcons();
     void drawLevelInfo(const sf::RenderStates& mStates);
-    void drawParticles();
-    void drawTrailParticles();
-    void drawSwapParticles();
+    void emitParticles(RenderSnapshot& snapshot);
+    void drawParticles(const RenderSnapshot& snapshot);
+    void drawPlayerParticles(const RenderSnapshot& snapshot);
     void drawImguiLuaConsole();
 
     // Data-related methods
@@ -453,14 +520,66 @@ private:
     void performPlayerKill();
     void saveReplay();
 
-    Utils::FastVertexVectorTris backgroundTris;
-    Utils::FastVertexVectorTris wallQuads;
-    Utils::FastVertexVectorTris pivotQuads;
-    Utils::FastVertexVectorTris playerTris;
-    Utils::FastVertexVectorTris capTris;
-    Utils::FastVertexVectorTris wallQuads3D;
-    Utils::FastVertexVectorTris pivotQuads3D;
-    Utils::FastVertexVectorTris playerTris3D;
+    // Snapshot built and drawn by `draw` when the simulation runs on the
+    // window thread.
+    RenderSnapshot renderSnapshot;
+
+    // If the built-in layer shader is available, every layer of the 3D effect
+    // is drawn by offsetting the flat geometry and coloring it with a uniform.
+    sf::base::Optional<sf::Shader> layer3DShader;
+    sf::Shader::UniformLocation layer3DColorLocation{};
+
+    void loadLayer3DShader();
+    [[nodiscard]] bool canDrawLayers3DWithShader() const;
+    void drawLayers3DWithShader(const Utils::FastVertexVectorTris& base,
+        const std::vector<Utils::Layer3D>& layers3D,
+        sf::Color Utils::Layer3D::*layerColor);
+
+    // ------------------------------------------------------------------------
+    // Threaded simulation, see `Config::getThreadedSimulation`. The simulation
+    // thread runs `update` at a fixed rate and publishes a render snapshot
+    // after every tick, which `draw` picks up. All the other accesses to the
+    // game state from the window thread (input, state changes, text, the Lua
+    // console) are serialized with the ticks by `simulationMutex`.
+    Utils::TripleBuffer<RenderSnapshot> renderSnapshots;
+
+    std::thread simulationThread;
+    std::thread::id simulationThreadId;
+    std::mutex simulationMutex;
+    std::condition_variable simulationCV;
+
+    // Guards the Lua state while the simulation thread collects its garbage
+    // between ticks, which is done without holding `simulationMutex` so that
+    // the window thread is not blocked for the duration of the collection.
+    // The window thread takes it, after `simulationMutex`, wherever it uses
+    // Lua. Recursive, as those uses can be nested (e.g. `newGame` in a state
+    // change).
+    std::recursive_mutex luaMutex;
+
+    // Guarded by `simulationMutex`.
+    bool simulationThreadActive{false};
+    bool simulationThreadStop{false};
+
+    // Arguments of a `goToMenu` call made on the simulation thread, carried
+    // out on the window thread.
+    struct GoToMenuRequest
+    {
+        bool sendScores;
+        bool error;
+    };
+
+    sf::base::Optional<GoToMenuRequest> pendingGoToMenu;
+
+    // Set by `goToMenu` and reset by `newGame`, the simulation thread is not
+    // resumed once the game is left.
+    bool leftGame{false};
+
+    [[nodiscard]] bool isSimulationThreaded() const;
+    [[nodiscard]] bool onSimulationThread() const;
+    [[nodiscard]] std::unique_lock<std::mutex> lockSimulation();
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> lockLua();
+    void runSimulationThread();
+    void updateSimulationThread(const float mFT);
 
 public:
     std::function<void(const bool)> fnGoToMenu;
@@ -508,9 +627,32 @@ public:
         float customScore;
     };
 
+    enum class GameExecutionStatus : std::uint8_t
+    {
+        Paused,   // Budget exhausted, resume with `executeGameSlice`.
+        Finished, // The player died, see `getGameExecutionResult`.
+        Diverged  // The replay did not match its recorded state hashes.
+    };
+
+    // Runs at most `maxTicks` ticks, or until `maxDuration` has elapsed. The
+    // game can be resumed by calling this again, so that many executions can
+    // be interleaved fairly on the same threads.
+    [[nodiscard]] GameExecutionStatus executeGameSlice(const int maxTicks,
+        const std::chrono::microseconds maxDuration, const float timescale);
+
+    [[nodiscard]] GameExecutionResult getGameExecutionResult() const;
+
     [[nodiscard]] sf::base::Optional<GameExecutionResult> executeGameUntilDeath(
         const int maxProcessingSeconds, const float timescale);
 
+    // Whether the state of the replay being executed did not match one of the
+    // state hashes recorded in its replay file.
+    [[nodiscard]] bool hasReplayDiverged() const noexcept;
+
+    // Starts a new game that executes `mReplayFile`, to be run with
+    // `executeGameSlice` or `executeGameUntilDeath`.
+    void startReplayExecution(const replay_file& mReplayFile);
+
     [[nodiscard]] sf::base::Optional<GameExecutionResult>
     runReplayUntilDeathAndGetScore(const replay_file& mReplayFile,
         const int maxProcessingSeconds, const float timescale);
@@ -547,6 +689,7 @@ public:
     [[nodiscard]] float getWallAngleRight() const noexcept;
     [[nodiscard]] HexagonGameStatus& getStatus() noexcept;
     [[nodiscard]] const HexagonGameStatus& getStatus() const noexcept;
+    [[nodiscard]] std::uint32_t getLastFrameDrawCalls() const noexcept;
     [[nodiscard]] LevelStatus& getLevelStatus();
     [[nodiscard]] HGAssets& getAssets();
     [[nodiscard]] sf::Color getColorMain() const;
@@ -10,6 +10,10 @@
 
 #include "SSVOpenHexagon/Online/Sodium.hpp"
 #include "SSVOpenHexagon/Online/DatabaseRecords.hpp"
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
+#include "SSVOpenHexagon/Online/ReplayArchive.hpp"
+#include "SSVOpenHexagon/Online/UserScoreCache.hpp"
 
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
@@ -32,6 +36,7 @@ class HGAssets;
 class HexagonGame;
 struct GameVersion;
 struct replay_file;
+struct compressed_replay_file;
 
 class HexagonServer
 {
@@ -39,8 +44,8 @@ private:
     HGAssets& _assets;
     HexagonGame& _hexagonGame;
 
-    const std::unordered_set<std::string> _supportedLevelValidators;
-    const std::vector<std::string> _supportedLevelValidatorsVector;
+    const LevelValidatorTable _supportedLevelValidators;
+    const std::vector<LevelValidatorMapping> _supportedLevelValidatorsVector;
 
     const sf::IpAddress _serverIp;
     const unsigned short _serverPort;
@@ -88,7 +93,7 @@ private:
         struct GameStatus
         {
             Utils::SCTimePoint _startTP;
-            std::string _levelValidator;
+            LevelValidatorId _levelValidatorId;
         };
 
         sf::base::Optional<GameStatus> _gameStatus;
@@ -107,6 +112,13 @@ private:
     Utils::SCTimePoint _lastTokenPurge;
     Utils::SCTimePoint _lastLogsFlush;
 
+    ReplayArchiveWriter _replayArchive;
+
+    LeaderboardHistory _leaderboardHistory;
+
+    // Used to skip replays that cannot improve on the stored score.
+    UserScoreCache _userScoreCache;
+
     [[nodiscard]] bool initializeControlSocket();
     [[nodiscard]] bool initializeTcpListener();
     [[nodiscard]] bool initializeSocketSelector();
@@ -131,18 +143,31 @@ private:
     [[nodiscard]] bool sendDeleteAccountFailure(
         ConnectedClient& c, const std::string& error);
     [[nodiscard]] bool sendTopScores(ConnectedClient& c,
-        const std::string& levelValidator,
+        const LevelValidatorId levelValidatorId,
         const std::vector<Database::ProcessedScore>& scores);
     [[nodiscard]] bool sendOwnScore(ConnectedClient& c,
-        const std::string& levelValidator,
+        const LevelValidatorId levelValidatorId,
         const Database::ProcessedScore& score);
     [[nodiscard]] bool sendTopScoresAndOwnScore(ConnectedClient& c,
-        const std::string& levelValidator,
+        const LevelValidatorId levelValidatorId,
         const std::vector<Database::ProcessedScore>& scores,
         const sf::base::Optional<Database::ProcessedScore>& ownScore);
+    [[nodiscard]] bool sendTopScoresUnchanged(ConnectedClient& c,
+        const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion version);
+    [[nodiscard]] bool sendTopScoresDelta(ConnectedClient& c,
+        const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion baseVersion, const LeaderboardVersion version,
+        const LeaderboardDelta& delta,
+        const sf::base::Optional<Database::ProcessedScore>& ownScore);
+    [[nodiscard]] bool sendTopScoresBatchRejected(ConnectedClient& c,
+        const std::vector<LevelValidatorId>& levelValidatorIds,
+        const std::string& error);
+    [[nodiscard]] bool sendReplayAccepted(ConnectedClient& c,
+        const LevelValidatorId levelValidatorId, const double score);
     [[nodiscard]] bool sendServerStatus(ConnectedClient& c,
         const ProtocolVersion& protocolVersion, const GameVersion& gameVersion,
-        const std::vector<std::string>& supportedLevelValidators);
+        const std::vector<LevelValidatorMapping>& supportedLevelValidators);
 
     [[nodiscard]] bool kickAndRemoveClient(ConnectedClient& c);
 
@@ -159,7 +184,8 @@ private:
         const std::uint64_t ctspLoginToken);
 
     [[nodiscard]] bool processReplay(ConnectedClient& c,
-        const std::uint64_t loginToken, const replay_file& rf);
+        const std::uint64_t loginToken, const replay_file& rf,
+        const compressed_replay_file* crf);
 
     template <typename T>
     void printCTSPDataVerbose(
@@ -171,7 +197,17 @@ private:
     [[nodiscard]] bool fail(const Ts&...);
 
     [[nodiscard]] bool isLevelSupported(
-        const std::string& levelValidator) const;
+        const LevelValidatorId levelValidatorId) const;
+
+    [[nodiscard]] const std::vector<Database::ProcessedScore>& getTopScores(
+        const LevelValidatorId levelValidatorId);
+
+    [[nodiscard]] const sf::base::Optional<double>& getCachedUserScore(
+        const LevelValidatorId levelValidatorId, const std::uint64_t steamId);
+
+    [[nodiscard]] bool sendVersionedTopScoresAndOwnScore(ConnectedClient& c,
+        const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion cachedVersion);
 
 public:
     explicit HexagonServer(HGAssets& assets, HexagonGame& hexagonGame,
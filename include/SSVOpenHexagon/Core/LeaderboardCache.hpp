@@ -5,6 +5,8 @@
 #pragma once
 
 #include "SSVOpenHexagon/Online/DatabaseRecords.hpp"
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
 
 #include "SSVOpenHexagon/Utils/Clock.hpp"
 
@@ -22,31 +24,68 @@ private:
     {
         std::vector<Database::ProcessedScore> _scores;
         sf::base::Optional<Database::ProcessedScore> _ownScore;
-        HRTimePoint _cacheTime;
+        LeaderboardVersion _version{noLeaderboardVersion};
+        bool _received{false};
+        HRTimePoint _receiveTime{};
+        sf::base::Optional<HRTimePoint> _requestTime;
+        HRTimePoint _accessTime{};
     };
 
-    std::unordered_map<std::string, CachedScores> _levelValidatorToScores;
+    std::unordered_map<LevelValidatorId, CachedScores>
+        _levelValidatorIdToScores;
+
+    std::vector<LevelValidatorId> _pendingRequests;
+
+    void enqueueRequest(const LevelValidatorId levelValidatorId);
+    void discardVersion(const LevelValidatorId levelValidatorId);
 
 public:
-    void receivedScores(const std::string& levelValidator,
+    void receivedScores(const LevelValidatorId levelValidatorId,
         const std::vector<Database::ProcessedScore>& scores);
 
-    void receivedOwnScore(const std::string& levelValidator,
+    void receivedOwnScore(const LevelValidatorId levelValidatorId,
         const Database::ProcessedScore& score);
 
-    void requestedScores(const std::string& levelValidator);
+    // Versioned replies to batch requests. Return `false` if the reply does
+    // not match the cached leaderboard, which is then requested again in full.
+    [[nodiscard]] bool receivedScoresUnchanged(
+        const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion version);
+
+    [[nodiscard]] bool receivedScoresDelta(
+        const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion baseVersion, const LeaderboardVersion version,
+        const LeaderboardDelta& delta,
+        const sf::base::Optional<Database::ProcessedScore>& ownScore);
+
+    void requestedScores(const LevelValidatorId levelValidatorId);
+
+    // The request will not be answered, so the scores can be requested again
+    // right away instead of waiting for the request to time out.
+    void requestRejected(const LevelValidatorId levelValidatorId);
 
     [[nodiscard]] bool shouldRequestScores(
-        const std::string& levelValidator) const;
+        const LevelValidatorId levelValidatorId) const;
+
+    // Marks the leaderboard as being viewed (or about to be viewed), and
+    // queues a request for it if the cached scores are missing or expired.
+    void prefetch(const LevelValidatorId levelValidatorId);
+
+    // Queues requests for all recently viewed leaderboards whose cached scores
+    // expired, so that they are refreshed in the background.
+    void collectScoresToRefresh();
+
+    [[nodiscard]] bool hasPendingRequests() const noexcept;
+    [[nodiscard]] std::vector<CachedLeaderboardVersion> takePendingRequests();
 
     [[nodiscard]] const std::vector<Database::ProcessedScore>& getScores(
-        const std::string& levelValidator) const;
+        const LevelValidatorId levelValidatorId) const;
 
     [[nodiscard]] const Database::ProcessedScore* getOwnScore(
-        const std::string& levelValidator) const;
+        const LevelValidatorId levelValidatorId) const;
 
-    [[nodiscard]] bool getSupported(const std::string& levelValidator) const;
-    [[nodiscard]] bool hasInformation(const std::string& levelValidator) const;
+    [[nodiscard]] bool hasInformation(
+        const LevelValidatorId levelValidatorId) const;
 };
 
 } // namespace hg
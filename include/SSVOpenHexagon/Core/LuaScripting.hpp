@@ -37,7 +37,8 @@ void init(Lua::LuaContext& lua, random_number_generator& rng, const bool inMenu,
     const std::function<void(const std::string&)>& fRunLuaFile,
     std::vector<std::string>& execScriptPackPathContext,
     const std::function<const std::string&()>& fPackPathGetter,
-    const std::function<const PackData&()>& fGetPackData, const bool headless);
+    const std::function<const PackData&()>& fGetPackData, const bool headless,
+    const bool shadersDisabled);
 
 void printDocs();
 
@@ -13,6 +13,7 @@
 #include "SSVOpenHexagon/Utils/Clock.hpp"
 #include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
 #include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
+#include "SSVOpenHexagon/Utils/TextLayoutCache.hpp"
 #include "SSVOpenHexagon/Utils/UniquePtr.hpp"
 
 #include <SSVStart/Camera/Camera.hpp>
@@ -36,6 +37,7 @@
 #include <SFML/Base/Optional.hpp>
 #include <string_view>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -112,6 +114,8 @@ private:
     HexagonDialogBox dialogBox;
     Utils::UniquePtr<LeaderboardCache> leaderboardCache;
 
+    Utils::TextLayoutCache textLayoutCache;
+
     Lua::LuaContext lua;
     std::vector<std::string> execScriptPackPathContext;
     const PackData* currentPack;
@@ -210,6 +214,7 @@ private:
 
     void update(float mFT);
     void setIndex(int mIdx);
+    void prefetchLeaderboards();
     void refreshCamera();
     void reloadAssets(const bool reloadEntirePack);
     void setIgnoreAllInputs(const unsigned int presses);
@@ -401,6 +406,32 @@ private:
         bool isFavorites{false};
     };
 
+    // Uppercased labels of a row of the level list, cached by level id.
+    struct LevelRowLabels
+    {
+        std::string sourceName;
+        std::string sourceAuthor;
+        std::string name;
+        std::string author;
+    };
+
+    // A row of the level list that is on screen in the current frame.
+    struct VisibleLevelRow
+    {
+        const LevelRowLabels* labels;
+        float top;
+        float textIndent;
+        sf::Color bodyColor;
+        bool mouseOverlap;
+        bool ranked;
+    };
+
+    std::unordered_map<std::string, LevelRowLabels> levelRowLabels;
+    std::vector<VisibleLevelRow> visibleLevelRows;
+
+    [[nodiscard]] const LevelRowLabels& getLevelRowLabels(
+        const std::string& levelId, const LevelData& levelData);
+
     bool isLevelFavorite;
     std::vector<std::string> favoriteLevelDataIds;
     LevelDrawer lvlSlct;
@@ -11,6 +11,8 @@
 
 #include <random>
 
+#include <cstdint>
+
 namespace hg {
 
 class random_number_generator
@@ -29,6 +31,10 @@ public:
 
     [[nodiscard]] seed_type seed() const noexcept;
 
+    // Value that changes whenever the internal state of the engine changes,
+    // without advancing it. Used to hash the simulation state.
+    [[nodiscard]] std::uint32_t state_fingerprint() const noexcept;
+
     template <typename T>
     [[nodiscard, gnu::always_inline]] inline T get_int(
         const T min, const T max) noexcept
@@ -0,0 +1,52 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Layers3D.hpp"
+
+#include <SFML/Graphics/View.hpp>
+
+#include <SFML/Base/Optional.hpp>
+
+#include <vector>
+
+namespace hg {
+
+// Everything needed to draw the game geometry of a single frame, built from
+// the simulation state by `HexagonGame::buildRenderSnapshot`. Drawing a
+// snapshot does not read the simulation state, so that snapshots can be built
+// and drawn on different threads. Snapshots are reused from frame to frame to
+// keep the allocations of their vertex vectors.
+struct RenderSnapshot
+{
+    // Empty until the snapshot is built for the first time.
+    sf::base::Optional<sf::View> backgroundView;
+    sf::base::Optional<sf::View> overlayView;
+
+    Utils::FastVertexVectorTris backgroundTris;
+    Utils::FastVertexVectorTris wallQuads;
+    Utils::FastVertexVectorTris pivotQuads;
+    Utils::FastVertexVectorTris playerTris;
+    Utils::FastVertexVectorTris capTris;
+    Utils::FastVertexVectorTris wallQuads3D;
+    Utils::FastVertexVectorTris pivotQuads3D;
+    Utils::FastVertexVectorTris playerTris3D;
+
+    // Layers of the 3D effect, deepest first. If `layers3DWithShader` is set,
+    // every layer is drawn by offsetting the flat geometry. Otherwise, the
+    // layers were emitted on the CPU into the `...3D` vertex vectors above.
+    std::vector<Utils::Layer3D> layers3D;
+    bool layers3DWithShader{false};
+
+    // Particles, drawn with a single draw call per texture. Trail and swap
+    // particles share the small circle texture.
+    Utils::FastVertexVectorTris starParticleTris;
+    Utils::FastVertexVectorTris smallCircleParticleTris;
+
+    Utils::FastVertexVectorTris flashPolygon;
+};
+
+} // namespace hg
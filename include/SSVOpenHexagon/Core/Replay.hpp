@@ -73,6 +73,10 @@ private:
     std::vector<input_bitset> _inputs;
 
 public:
+    // Keeps the allocated storage, so that it can be reused by the next game.
+    void clear() noexcept;
+    void reserve(const std::size_t n);
+
     void record_input(const bool left, const bool right, const bool swap,
         const bool focus) noexcept;
 
@@ -95,6 +99,39 @@ public:
         const std::byte* buffer, const std::byte* const buffer_end);
 };
 
+// Hashes of the simulation state taken every `_interval` ticks, used to
+// detect a diverging replay without simulating it to the end.
+class replay_state_hashes
+{
+private:
+    std::uint32_t _interval{0};
+    std::vector<std::uint64_t> _hashes;
+
+public:
+    // Keeps the allocated storage, so that it can be reused by the next game.
+    void clear() noexcept;
+    void reserve(const std::size_t n);
+
+    void set_interval(const std::uint32_t interval) noexcept;
+    void record_hash(const std::uint64_t hash);
+
+    [[nodiscard]] std::uint32_t interval() const noexcept;
+    [[nodiscard]] std::uint64_t at(const std::size_t index) const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]] bool operator==(
+        const replay_state_hashes& rhs) const noexcept;
+    [[nodiscard]] bool operator!=(
+        const replay_state_hashes& rhs) const noexcept;
+
+    [[nodiscard]] serialization_result serialize(
+        std::byte* buffer, const std::byte* const buffer_end) const;
+
+    [[nodiscard]] deserialization_result deserialize(
+        const std::byte* buffer, const std::byte* const buffer_end);
+};
+
 class replay_player
 {
 private:
@@ -109,6 +146,13 @@ public:
     void reset() noexcept;
 };
 
+// Bumped whenever the simulation changes in a way that alters its results, as
+// replays recorded with a different version cannot play back identically.
+// History:
+// - 1: deterministic `sinCos` and cached wall curves.
+// - 2: strict math layer (fenced products, deterministic `atan2`).
+inline constexpr std::uint32_t replay_format_version{2};
+
 struct replay_file
 {
     using seed_type = random_number_generator_seed_type;
@@ -123,6 +167,7 @@ struct replay_file
     float _difficulty_mult;   // Played difficulty multiplier.
     double _played_score; // Played score (This can be an overridden score or
                           // frametime, excluding pauses).
+    replay_state_hashes _state_hashes; // Optional periodic state hashes.
 
     [[nodiscard]] bool operator==(const replay_file& rhs) const noexcept;
     [[nodiscard]] bool operator!=(const replay_file& rhs) const noexcept;
@@ -0,0 +1,157 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+
+#include <vrm/pp/cat.hpp>
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Instrumented stages of `HexagonGame::update`, `HexagonGame::draw`, and of
+// the scheduled Lua garbage collection steps. `TickInterval` and `TickJitter`
+// are not stages: they are the time between the starts of two consecutive
+// live ticks, and its absolute deviation from the fixed time step.
+enum class TickStage : std::uint8_t
+{
+    Update,
+    UpdateLuaOnUpdate,
+    UpdateTimeline,
+    UpdateCustomTimelines,
+    UpdateWalls,
+    UpdateCustomWalls,
+    UpdatePulse3D,
+    PostUpdate,
+    Draw,
+    DrawBackground,
+    DrawGeometry,
+    Draw3D,
+    DrawRender,
+    DrawText,
+    LuaGC,
+    TickInterval,
+    TickJitter,
+
+    Count
+};
+
+inline constexpr std::size_t tickStageCount =
+    static_cast<std::size_t>(TickStage::Count);
+
+[[nodiscard]] const char* getTickStageName(const TickStage stage) noexcept;
+
+// Records the duration of the last `sampleCount` executions of each stage.
+class TickProfiler
+{
+public:
+    static constexpr std::size_t sampleCount = 512;
+
+    struct Stats
+    {
+        std::size_t samples;
+        float minMs;
+        float avgMs;
+        float p99Ms;
+    };
+
+    class Scope
+    {
+    private:
+        TickProfiler& _profiler;
+        const TickStage _stage;
+        const HRTimePoint _start;
+
+    public:
+        [[nodiscard, gnu::always_inline]] explicit Scope(
+            TickProfiler& profiler, const TickStage stage) noexcept
+            : _profiler{profiler}, _stage{stage}, _start{HRClock::now()}
+        {}
+
+        [[gnu::always_inline]] ~Scope() noexcept
+        {
+            _profiler.record(_stage,
+                std::chrono::duration<float, std::milli>(
+                    HRClock::now() - _start)
+                    .count());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    struct StageSamples
+    {
+        std::array<float, sampleCount> _samplesMs;
+        std::size_t _next{0};
+        std::size_t _size{0};
+    };
+
+    std::array<StageSamples, tickStageCount> _stages{};
+
+    HRTimePoint _lastTickStart{};
+    bool _hasLastTickStart{false};
+
+public:
+    [[gnu::always_inline]] void record(
+        const TickStage stage, const float ms) noexcept
+    {
+        StageSamples& s = _stages[static_cast<std::size_t>(stage)];
+
+        s._samplesMs[s._next] = ms;
+        s._next = (s._next + 1) % sampleCount;
+
+        if (s._size < sampleCount)
+        {
+            ++s._size;
+        }
+    }
+
+    // Records a `TickInterval` and a `TickJitter` sample, from the start of
+    // the previous tick to `now`. `expectedMs` is the fixed time step.
+    void recordTickStart(
+        const HRTimePoint now, const float expectedMs) noexcept;
+
+    void clear() noexcept;
+
+    [[nodiscard]] Stats getStats(const TickStage stage) const;
+
+    void dump(std::ostream& os) const;
+};
+
+} // namespace hg
+
+// Profiling is compiled in only if `SSVOH_ENABLE_TICK_PROFILER` is defined,
+// otherwise the scopes expand to nothing.
+#ifdef SSVOH_ENABLE_TICK_PROFILER
+
+#define SSVOH_PROFILE_SCOPE(profiler, stage)                           \
+    const ::hg::TickProfiler::Scope VRM_PP_CAT(profileScope, __LINE__) \
+    {                                                                  \
+        profiler, ::hg::TickStage::stage                               \
+    }
+
+#define SSVOH_PROFILE_TICK_START(profiler, expectedMs) \
+    profiler.recordTickStart(::hg::HRClock::now(), expectedMs)
+
+#define SSVOH_PROFILE_RECORD(profiler, stage, ms) \
+    profiler.record(::hg::TickStage::stage, ms)
+
+#else
+
+#define SSVOH_PROFILE_SCOPE(profiler, stage) static_cast<void>(0)
+
+#define SSVOH_PROFILE_TICK_START(profiler, expectedMs) static_cast<void>(0)
+
+#define SSVOH_PROFILE_RECORD(profiler, stage, ms) static_cast<void>(ms)
+
+#endif
@@ -47,6 +47,12 @@ private:
     sf::Color current3DOverrideColor{sf::Color::Black};
     std::vector<sf::Color> currentColors;
 
+    // Unit directions of the two outer edges of every background sector. They
+    // only depend on the side count and on `BGRotOff`, so they are recomputed
+    // when either changes instead of on every frame.
+    mutable std::vector<sf::Vector2f> sectorEdges;
+    mutable float sectorEdgesRotOff{0.f};
+
     [[nodiscard]] static sf::Color calculateColor(const float mCurrentHue,
         const float mPulseFactor, const ColorData& mColorData);
 
@@ -54,6 +60,9 @@ private:
         const ssvuj::Obj& mRoot, const std::string& mKey,
         const ColorData& mDefault);
 
+    [[nodiscard]] const std::vector<sf::Vector2f>& getSectorEdges(
+        const unsigned int sides) const;
+
     void drawBackgroundImpl(Utils::FastVertexVectorTris& vertices,
         const sf::Vector2f& mCenterPos, const unsigned int sides,
         const bool darkenUnevenBackgroundChunk, const bool blackAndWhite) const;
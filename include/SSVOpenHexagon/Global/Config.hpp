@@ -98,6 +98,7 @@ void setPlaySwapReadySound(bool x);
 void setShowSwapBlinkingEffect(bool x);
 void setUseLuaFileCache(bool x);
 void setDisableGameRendering(bool x);
+void setThreadedSimulation(bool x);
 
 [[nodiscard]] bool getOfficial();
 [[nodiscard]] const std::string& getUneligibilityReason();
@@ -177,6 +178,7 @@ void setDisableGameRendering(bool x);
 [[nodiscard]] bool getShowSwapBlinkingEffect();
 [[nodiscard]] bool getUseLuaFileCache();
 [[nodiscard]] bool getDisableGameRendering();
+[[nodiscard]] bool getThreadedSimulation();
 
 // keyboard binds
 
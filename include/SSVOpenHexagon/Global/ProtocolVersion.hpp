@@ -10,6 +10,6 @@ namespace hg {
 
 using ProtocolVersion = std::uint8_t;
 
-inline constexpr ProtocolVersion PROTOCOL_VERSION = 0;
+inline constexpr ProtocolVersion PROTOCOL_VERSION = 4;
 
 } // namespace hg
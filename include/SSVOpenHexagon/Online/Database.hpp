@@ -41,16 +41,25 @@ void addLoginToken(const LoginToken& loginToken);
 [[nodiscard]] std::vector<LoginToken> getAllStaleLoginTokens();
 void removeAllStaleLoginTokens();
 
+[[nodiscard]] std::uint32_t getOrAddLevelValidatorId(
+    const std::string& validator);
+
 [[nodiscard]] std::vector<ProcessedScore> getTopScores(
-    const int topLimit, const std::string& levelValidator);
+    const int topLimit, const std::uint32_t levelValidatorId);
 
 [[nodiscard]] bool isLoginTokenValid(std::uint64_t token);
 
-void addScore(const std::string& levelValidator, const std::uint64_t timestamp,
-    const std::uint64_t userSteamId, const double value);
+void addScore(const std::uint32_t levelValidatorId,
+    const std::uint64_t timestamp, const std::uint64_t userSteamId,
+    const double value);
+
+// Value of the score stored for the given user, without computing its
+// position in the leaderboard.
+[[nodiscard]] sf::base::Optional<double> getUserScoreValue(
+    const std::uint32_t levelValidatorId, const std::uint64_t userSteamId);
 
 [[nodiscard]] sf::base::Optional<ProcessedScore> getScore(
-    const std::string& levelValidator, const std::uint64_t userSteamId);
+    const std::uint32_t levelValidatorId, const std::uint64_t userSteamId);
 
 [[nodiscard]] sf::base::Optional<std::string> execute(const std::string& query);
 
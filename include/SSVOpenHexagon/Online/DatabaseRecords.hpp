@@ -27,7 +27,22 @@ struct LoginToken
     std::uint64_t token;
 };
 
+struct LevelValidator
+{
+    std::uint32_t id;
+    std::string validator;
+};
+
 struct Score
+{
+    std::uint32_t id;
+    std::uint32_t levelValidatorId;
+    std::uint64_t timestamp;
+    std::uint64_t userSteamId;
+    double value;
+};
+
+struct LegacyScore // only read during schema migration
 {
     std::uint32_t id;
     std::string levelValidator;
@@ -0,0 +1,111 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Online/DatabaseRecords.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Version of a leaderboard, bumped by the server every time a score for the
+// corresponding level validator changes. Zero means "nothing cached".
+using LeaderboardVersion = std::uint64_t;
+
+inline constexpr LeaderboardVersion noLeaderboardVersion = 0;
+
+struct CachedLeaderboardVersion
+{
+    LevelValidatorId levelValidatorId;
+    LeaderboardVersion version;
+};
+
+// A score already known by the client that ended up at a different index.
+struct LeaderboardMovedScore
+{
+    std::uint32_t index;
+    std::uint32_t oldIndex;
+};
+
+// A score unknown to the client, sent in full.
+struct LeaderboardInsertedScore
+{
+    std::uint32_t index;
+    Database::ProcessedScore score;
+};
+
+// Transforms an old top scores list into a new one. Indices not mentioned in
+// `moved` or `inserted` keep the score they had in the old list.
+struct LeaderboardDelta
+{
+    std::uint32_t size;
+    std::vector<LeaderboardMovedScore> moved;
+    std::vector<LeaderboardInsertedScore> inserted;
+};
+
+[[nodiscard]] LeaderboardDelta makeLeaderboardDelta(
+    const std::vector<Database::ProcessedScore>& oldScores,
+    const std::vector<Database::ProcessedScore>& newScores);
+
+// Returns `nullOpt` if the delta does not fit `oldScores`, in which case the
+// cached leaderboard has to be discarded and requested again.
+[[nodiscard]] sf::base::Optional<std::vector<Database::ProcessedScore>>
+applyLeaderboardDelta(const std::vector<Database::ProcessedScore>& oldScores,
+    const LeaderboardDelta& delta);
+
+// Server-side record of the last few versions of every leaderboard, used to
+// compute deltas against whatever version a client has cached.
+class LeaderboardHistory
+{
+public:
+    struct Snapshot
+    {
+        LeaderboardVersion version;
+        std::vector<Database::ProcessedScore> scores;
+    };
+
+private:
+    struct Entry
+    {
+        std::deque<Snapshot> _snapshots;
+        bool _dirty{true};
+    };
+
+    std::unordered_map<LevelValidatorId, Entry> _entries;
+    LeaderboardVersion _nextVersion;
+    std::size_t _maxSnapshots;
+
+public:
+    // `firstVersion` should grow across server restarts (e.g. be derived from
+    // the startup time), so that versions cached by clients before a restart
+    // are never mistaken for current ones.
+    explicit LeaderboardHistory(
+        const LeaderboardVersion firstVersion, const std::size_t maxSnapshots);
+
+    void invalidate(const LevelValidatorId levelValidatorId);
+    void invalidateAll();
+
+    [[nodiscard]] bool isUpToDate(
+        const LevelValidatorId levelValidatorId) const;
+
+    const Snapshot& update(const LevelValidatorId levelValidatorId,
+        std::vector<Database::ProcessedScore>&& scores);
+
+    [[nodiscard]] const Snapshot& getLatest(
+        const LevelValidatorId levelValidatorId) const;
+
+    [[nodiscard]] const Snapshot* find(const LevelValidatorId levelValidatorId,
+        const LeaderboardVersion version) const;
+};
+
+} // namespace hg
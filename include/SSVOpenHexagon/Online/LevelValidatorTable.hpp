@@ -0,0 +1,55 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <SFML/Base/Optional.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Compact identifier for a level validator string (e.g.
+// `ohvrvanilla_vittorio_romeo_cube_1_apeirogon_m_1.6`). Assigned by the server
+// database and sent to clients once as part of `STCPServerStatus`.
+using LevelValidatorId = std::uint32_t;
+
+struct LevelValidatorMapping
+{
+    LevelValidatorId id;
+    std::string validator;
+};
+
+class LevelValidatorTable
+{
+private:
+    std::unordered_map<std::string, LevelValidatorId> _validatorToId;
+    std::unordered_map<LevelValidatorId, std::string> _idToValidator;
+
+public:
+    void add(const LevelValidatorId id, const std::string& validator);
+    void add(const std::vector<LevelValidatorMapping>& mappings);
+    void clear();
+
+    [[nodiscard]] bool contains(const std::string& validator) const;
+    [[nodiscard]] bool contains(const LevelValidatorId id) const;
+
+    [[nodiscard]] sf::base::Optional<LevelValidatorId> getId(
+        const std::string& validator) const;
+
+    [[nodiscard]] const std::string* getValidator(
+        const LevelValidatorId id) const;
+
+    [[nodiscard]] std::vector<LevelValidatorMapping> toMappings() const;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+};
+
+} // namespace hg
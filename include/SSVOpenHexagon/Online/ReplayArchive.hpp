@@ -0,0 +1,138 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Level validators are short strings made of a level id and a difficulty
+// multiplier. Longer validators are never archived, and index records
+// claiming longer ones are treated as corrupt.
+inline constexpr std::size_t maxArchivedLevelValidatorSize{1024};
+
+// Compressed replays take a few hundred KiB at most, even for runs lasting
+// hours. Larger replays are never archived, and index records claiming larger
+// ones are treated as corrupt, instead of being trusted for allocations.
+inline constexpr std::uint64_t maxArchivedReplaySize{16 * 1024 * 1024};
+
+// Location of a single accepted replay inside the archive. Replays are stored
+// back-to-back (still compressed) in large segment files, and every stored
+// replay gets one record in the append-only index file.
+struct ReplayArchiveEntry
+{
+    std::string levelValidator;
+    std::uint64_t steamId;
+    double score;
+    std::uint64_t timestamp;
+    std::uint32_t segment;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+class ReplayArchiveWriter
+{
+private:
+    struct PendingReplay
+    {
+        std::string _levelValidator;
+        std::uint64_t _steamId;
+        double _score;
+        std::uint64_t _timestamp;
+        compressed_replay_file _compressedReplayFile;
+
+        // Set for replays that were received uncompressed, they are compressed
+        // by the background thread before being written.
+        sf::base::Optional<replay_file> _replayFile;
+    };
+
+    const std::filesystem::path _directory;
+    const std::uint64_t _maxSegmentBytes;
+
+    std::ofstream _segmentStream;
+    std::ofstream _indexStream;
+    std::uint32_t _currentSegment;
+    std::uint64_t _currentSegmentBytes;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<PendingReplay> _queue;
+    bool _stopping;
+
+    std::thread _thread;
+
+    void recover();
+
+    [[nodiscard]] bool openSegment(const std::uint32_t segment);
+    [[nodiscard]] bool write(PendingReplay& pr);
+
+    void run();
+
+public:
+    explicit ReplayArchiveWriter(const std::filesystem::path& directory,
+        const std::uint64_t maxSegmentBytes = 256 * 1024 * 1024);
+
+    ~ReplayArchiveWriter();
+
+    ReplayArchiveWriter(const ReplayArchiveWriter&) = delete;
+    ReplayArchiveWriter(ReplayArchiveWriter&&) = delete;
+
+    // Never blocks on I/O: the replay is queued and written by the background
+    // thread. Pending replays are flushed on destruction.
+    void append(const std::string& levelValidator, const std::uint64_t steamId,
+        const double score, const std::uint64_t timestamp,
+        compressed_replay_file&& crf);
+
+    // Same as above, but the replay is also compressed by the background
+    // thread.
+    void append(const std::string& levelValidator, const std::uint64_t steamId,
+        const double score, const std::uint64_t timestamp, replay_file&& rf);
+
+    [[nodiscard]] std::size_t getPendingCount();
+};
+
+class ReplayArchiveReader
+{
+private:
+    const std::filesystem::path _directory;
+    std::vector<ReplayArchiveEntry> _entries;
+
+public:
+    explicit ReplayArchiveReader(const std::filesystem::path& directory);
+
+    // Re-reads the index file, picking up replays appended since the last
+    // load. A truncated trailing record (e.g. after a crash) is ignored.
+    [[nodiscard]] bool loadIndex();
+
+    [[nodiscard]] const std::vector<ReplayArchiveEntry>&
+    getEntries() const noexcept;
+
+    [[nodiscard]] std::vector<ReplayArchiveEntry> getEntriesForLevel(
+        const std::string& levelValidator) const;
+
+    [[nodiscard]] sf::base::Optional<ReplayArchiveEntry> getBestEntry(
+        const std::string& levelValidator) const;
+
+    [[nodiscard]] sf::base::Optional<ReplayArchiveEntry> getBestEntryForUser(
+        const std::string& levelValidator, const std::uint64_t steamId) const;
+
+    [[nodiscard]] sf::base::Optional<compressed_replay_file> read(
+        const ReplayArchiveEntry& entry) const;
+};
+
+} // namespace hg
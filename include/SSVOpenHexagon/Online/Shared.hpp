@@ -6,6 +6,8 @@
 
 #include "SSVOpenHexagon/Online/Sodium.hpp"
 #include "SSVOpenHexagon/Online/DatabaseRecords.hpp"
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
 
 #include "SSVOpenHexagon/Core/Replay.hpp"
 
@@ -22,7 +24,7 @@
 #include <string>
 #include <vector>
 
-#include <cstdint>
+#include <cstddef>
 #include <cstdint>
 
 namespace sf {
@@ -57,22 +59,28 @@ struct PEncryptedMsg
 
 // ----------------------------------------------------------------------------
 
+// Maximum number of leaderboards in a `CTSPRequestTopScoresAndOwnScoreBatch`.
+// The client splits larger requests, the server rejects the entries past the
+// limit with a `STCPTopScoresBatchRejected` reply.
+inline constexpr std::size_t maxLeaderboardBatchSize{32};
+
 // clang-format off
-struct CTSPHeartbeat                   { };
-struct CTSPDisconnect                  { };
-struct CTSPPublicKey                   { SodiumPublicKeyArray key; };
-struct CTSPRegister                    { std::uint64_t steamId; std::string name; std::string passwordHash; };
-struct CTSPLogin                       { std::uint64_t steamId; std::string name; std::string passwordHash; };
-struct CTSPLogout                      { std::uint64_t steamId; };
-struct CTSPDeleteAccount               { std::uint64_t steamId; std::string passwordHash; };
-struct CTSPRequestTopScores            { std::uint64_t loginToken; std::string levelValidator; };
-struct CTSPReplay                      { std::uint64_t loginToken; replay_file replayFile; };
-struct CTSPRequestOwnScore             { std::uint64_t loginToken; std::string levelValidator; };
-struct CTSPRequestTopScoresAndOwnScore { std::uint64_t loginToken; std::string levelValidator; };
-struct CTSPStartedGame                 { std::uint64_t loginToken; std::string levelValidator; };
-struct CTSPCompressedReplay            { std::uint64_t loginToken; compressed_replay_file compressedReplayFile; };
-struct CTSPRequestServerStatus         { std::uint64_t loginToken; };
-struct CTSPReady                       { std::uint64_t loginToken; };
+struct CTSPHeartbeat                        { };
+struct CTSPDisconnect                       { };
+struct CTSPPublicKey                        { SodiumPublicKeyArray key; };
+struct CTSPRegister                         { std::uint64_t steamId; std::string name; std::string passwordHash; };
+struct CTSPLogin                            { std::uint64_t steamId; std::string name; std::string passwordHash; };
+struct CTSPLogout                           { std::uint64_t steamId; };
+struct CTSPDeleteAccount                    { std::uint64_t steamId; std::string passwordHash; };
+struct CTSPRequestTopScores                 { std::uint64_t loginToken; LevelValidatorId levelValidatorId; };
+struct CTSPReplay                           { std::uint64_t loginToken; replay_file replayFile; };
+struct CTSPRequestOwnScore                  { std::uint64_t loginToken; LevelValidatorId levelValidatorId; };
+struct CTSPRequestTopScoresAndOwnScore      { std::uint64_t loginToken; LevelValidatorId levelValidatorId; };
+struct CTSPStartedGame                      { std::uint64_t loginToken; LevelValidatorId levelValidatorId; };
+struct CTSPCompressedReplay                 { std::uint64_t loginToken; compressed_replay_file compressedReplayFile; };
+struct CTSPRequestServerStatus              { std::uint64_t loginToken; };
+struct CTSPReady                            { std::uint64_t loginToken; };
+struct CTSPRequestTopScoresAndOwnScoreBatch { std::uint64_t loginToken; std::vector<CachedLeaderboardVersion> cachedVersions; };
 // clang-format on
 
 #define SSVOH_CTS_PACKETS                                         \
@@ -80,7 +88,8 @@ struct CTSPReady                       { std::uint64_t loginToken; };
         CTSPRegister, CTSPLogin, CTSPLogout, CTSPDeleteAccount,   \
         CTSPRequestTopScores, CTSPReplay, CTSPRequestOwnScore,    \
         CTSPRequestTopScoresAndOwnScore, CTSPStartedGame,         \
-        CTSPCompressedReplay, CTSPRequestServerStatus, CTSPReady)
+        CTSPCompressedReplay, CTSPRequestServerStatus, CTSPReady, \
+        CTSPRequestTopScoresAndOwnScoreBatch)
 
 using PVClientToServer = std::variant<PInvalid, PEncryptedMsg,
     VRM_PP_TPL_EXPLODE(SSVOH_CTS_PACKETS)>;
@@ -111,10 +120,14 @@ struct STCPLogoutSuccess          { };
 struct STCPLogoutFailure          { };
 struct STCPDeleteAccountSuccess   { };
 struct STCPDeleteAccountFailure   { std::string error; };
-struct STCPTopScores              { std::string levelValidator; std::vector<Database::ProcessedScore> scores; };
-struct STCPOwnScore               { std::string levelValidator; Database::ProcessedScore score; };
-struct STCPTopScoresAndOwnScore   { std::string levelValidator; std::vector<Database::ProcessedScore> scores; sf::base::Optional<Database::ProcessedScore> ownScore; };
-struct STCPServerStatus           { ProtocolVersion protocolVersion; GameVersion gameVersion; std::vector<std::string> supportedLevelValidators; };
+struct STCPTopScores              { LevelValidatorId levelValidatorId; std::vector<Database::ProcessedScore> scores; };
+struct STCPOwnScore               { LevelValidatorId levelValidatorId; Database::ProcessedScore score; };
+struct STCPTopScoresAndOwnScore   { LevelValidatorId levelValidatorId; std::vector<Database::ProcessedScore> scores; sf::base::Optional<Database::ProcessedScore> ownScore; };
+struct STCPServerStatus           { ProtocolVersion protocolVersion; GameVersion gameVersion; std::vector<LevelValidatorMapping> supportedLevelValidators; };
+struct STCPTopScoresUnchanged     { LevelValidatorId levelValidatorId; LeaderboardVersion version; };
+struct STCPTopScoresDelta         { LevelValidatorId levelValidatorId; LeaderboardVersion baseVersion; LeaderboardVersion version; LeaderboardDelta delta; sf::base::Optional<Database::ProcessedScore> ownScore; };
+struct STCPTopScoresBatchRejected { std::vector<LevelValidatorId> levelValidatorIds; std::string error; };
+struct STCPReplayAccepted         { LevelValidatorId levelValidatorId; double score; };
 // clang-format on
 
 #define SSVOH_STC_PACKETS                                               \
@@ -122,7 +135,9 @@ struct STCPServerStatus           { ProtocolVersion protocolVersion; GameVersion
         STCPRegistrationFailure, STCPLoginSuccess, STCPLoginFailure,    \
         STCPLogoutSuccess, STCPLogoutFailure, STCPDeleteAccountSuccess, \
         STCPDeleteAccountFailure, STCPTopScores, STCPOwnScore,          \
-        STCPTopScoresAndOwnScore, STCPServerStatus)
+        STCPTopScoresAndOwnScore, STCPServerStatus,                     \
+        STCPTopScoresUnchanged, STCPTopScoresDelta,                     \
+        STCPTopScoresBatchRejected, STCPReplayAccepted)
 
 using PVServerToClient = std::variant<PInvalid, PEncryptedMsg,
     VRM_PP_TPL_EXPLODE(SSVOH_STC_PACKETS)>;
@@ -0,0 +1,60 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <map>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+// Upper bound on the time played in a replay with `inputCount` recorded
+// inputs, as every input is exactly one tick.
+[[nodiscard]] double getMaxReplayPlayedSeconds(const std::size_t inputCount);
+
+// Whether a replay played for at most `maxPlayedSeconds` could improve on
+// `storedScore`. `Database::addScore` ignores scores that do not, so such
+// replays are not worth simulating.
+[[nodiscard]] bool canImproveOnStoredScore(
+    const sf::base::Optional<double>& storedScore,
+    const double maxPlayedSeconds);
+
+// Server-side cache of the score stored in the database for every user that
+// submitted a replay, filled lazily.
+class UserScoreCache
+{
+private:
+    using Key = std::pair<LevelValidatorId, std::uint64_t>;
+
+    // An empty optional means that the user has no stored score.
+    std::map<Key, sf::base::Optional<double>> _scores;
+
+public:
+    // Returns `nullptr` if the score of the user has not been loaded yet.
+    [[nodiscard]] const sf::base::Optional<double>* find(
+        const LevelValidatorId levelValidatorId,
+        const std::uint64_t steamId) const;
+
+    const sf::base::Optional<double>& store(
+        const LevelValidatorId levelValidatorId, const std::uint64_t steamId,
+        const sf::base::Optional<double>& score);
+
+    // Records a score passed to `Database::addScore`, which only keeps the
+    // best score of every user.
+    void addScore(const LevelValidatorId levelValidatorId,
+        const std::uint64_t steamId, const double score);
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const;
+};
+
+} // namespace hg
@@ -0,0 +1,70 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace hg::Utils {
+
+// Number of calls to the global `operator new` made by the current thread.
+// Only updated in executables that expand `SSVOH_DEFINE_ALLOCATION_COUNTER`.
+inline thread_local std::uint64_t threadAllocationCount{0};
+
+[[nodiscard, gnu::always_inline]] inline std::uint64_t
+getThreadAllocationCount() noexcept
+{
+    return threadAllocationCount;
+}
+
+// Counts the allocations performed by the current thread since construction.
+class AllocationCounterScope
+{
+private:
+    const std::uint64_t _begin;
+
+public:
+    [[nodiscard]] explicit AllocationCounterScope() noexcept
+        : _begin{getThreadAllocationCount()}
+    {}
+
+    [[nodiscard]] std::uint64_t count() const noexcept
+    {
+        return getThreadAllocationCount() - _begin;
+    }
+};
+
+} // namespace hg::Utils
+
+// Replaces the global `operator new` and `operator delete` with versions that
+// update `threadAllocationCount`. Meant for tests and benchmarks: expand once,
+// at global scope, in a single translation unit of the executable.
+#define SSVOH_DEFINE_ALLOCATION_COUNTER                  \
+    void* operator new(const std::size_t size)           \
+    {                                                    \
+        ++::hg::Utils::threadAllocationCount;            \
+                                                         \
+        if (void* p = std::malloc(size == 0 ? 1 : size)) \
+        {                                                \
+            return p;                                    \
+        }                                                \
+                                                         \
+        throw std::bad_alloc{};                          \
+    }                                                    \
+                                                         \
+    void operator delete(void* p) noexcept               \
+    {                                                    \
+        std::free(p);                                    \
+    }                                                    \
+                                                         \
+    void operator delete(void* p, std::size_t) noexcept  \
+    {                                                    \
+        std::free(p);                                    \
+    }                                                    \
+                                                         \
+    static_assert(true, "require a semicolon after the macro")
@@ -0,0 +1,119 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+
+#include <iosfwd>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sf {
+class Shader;
+class Texture;
+} // namespace sf
+
+namespace hg::Utils {
+
+// Records the draw calls issued by the game, so that rendering cost can be
+// measured and tested without a window or an OpenGL context. Only the calls
+// of the current frame are kept, the totals span all the recorded frames.
+class DrawTrace
+{
+public:
+    struct Call
+    {
+        std::size_t vertexCount;
+        sf::PrimitiveType primitiveType;
+        const sf::Texture* texture;
+        const sf::Shader* shader;
+    };
+
+private:
+    std::vector<Call> _calls;
+    std::uint64_t _frameCount{0};
+    std::uint64_t _totalCallCount{0};
+    std::uint64_t _totalVertexCount{0};
+
+    template <typename T>
+    [[nodiscard]] static Call makeCall(const T& drawable,
+        const sf::Texture* texture, const sf::Shader* shader) noexcept
+    {
+        if constexpr (requires { T::primitiveType; })
+        {
+            // `FastVertexVector`.
+            return Call{drawable.size(), T::primitiveType, texture, shader};
+        }
+        else if constexpr (requires { drawable.getVertices().size(); })
+        {
+            // Text.
+            return Call{drawable.getVertices().size(),
+                sf::PrimitiveType::Triangles, texture, shader};
+        }
+        else if constexpr (requires {
+                               drawable.getFillVertices().size();
+                               drawable.getOutlineVertices().size();
+                           })
+        {
+            // Shapes.
+            return Call{drawable.getFillVertices().size() +
+                            drawable.getOutlineVertices().size(),
+                sf::PrimitiveType::Triangles, texture, shader};
+        }
+        else
+        {
+            // Sprites are drawn as a single quad.
+            return Call{4, sf::PrimitiveType::TriangleStrip, texture, shader};
+        }
+    }
+
+public:
+    // Discards the calls of the previous frame.
+    void beginFrame() noexcept;
+
+    void record(const Call& call);
+
+    template <typename T>
+    void recordDraw(const T& drawable)
+    {
+        record(makeCall(drawable, nullptr, nullptr));
+    }
+
+    template <typename T>
+    void recordDraw(const T& drawable, const sf::RenderStates& states)
+    {
+        record(makeCall(drawable, states.texture, states.shader));
+    }
+
+    template <typename T>
+    void recordDraw(const T& drawable, const sf::Texture& texture)
+    {
+        record(makeCall(drawable, &texture, nullptr));
+    }
+
+    template <typename T>
+    void recordDraw(const T& drawable, const sf::Texture* texture,
+        const sf::RenderStates& states = sf::RenderStates::Default)
+    {
+        record(makeCall(drawable, texture, states.shader));
+    }
+
+    void clear() noexcept;
+
+    [[nodiscard]] const std::vector<Call>& getFrameCalls() const noexcept;
+    [[nodiscard]] std::size_t getFrameVertexCount() const noexcept;
+
+    [[nodiscard]] std::uint64_t getFrameCount() const noexcept;
+    [[nodiscard]] std::uint64_t getTotalCallCount() const noexcept;
+    [[nodiscard]] std::uint64_t getTotalVertexCount() const noexcept;
+
+    // Prints the calls of the current frame, one per line.
+    void dumpFrame(std::ostream& os) const;
+};
+
+} // namespace hg::Utils
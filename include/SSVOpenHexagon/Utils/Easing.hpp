@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
+
 namespace hg::Utils {
 
 [[nodiscard, gnu::pure, gnu::always_inline]] inline float getSaturated(
@@ -26,14 +28,14 @@ namespace hg::Utils {
     const float edge0, const float edge1, float x)
 {
     x = getSaturated((x - edge0) / (edge1 - edge0));
-    return x * x * (3.f - 2.f * x);
+    return x * x * Strict::mulAdd(-2.f, x, 3.f);
 }
 
 [[nodiscard, gnu::pure, gnu::always_inline]] inline float getSmootherStep(
     const float edge0, const float edge1, float x)
 {
     x = getSaturated((x - edge0) / (edge1 - edge0));
-    return x * x * x * (x * (x * 6.f - 15.f) + 10.f);
+    return x * x * x * Strict::mulAdd(x, Strict::mulAdd(x, 6.f, -15.f), 10.f);
 }
 
 } // namespace hg::Utils
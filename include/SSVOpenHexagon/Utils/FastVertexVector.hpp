@@ -42,6 +42,8 @@ private:
     std::size_t _capacity{};
 
 public:
+    static constexpr sf::PrimitiveType primitiveType = TPrimitive;
+
     [[gnu::always_inline]] void reserve_more(const std::size_t n)
     {
         reserve(_size * 2 + n);
@@ -201,6 +203,21 @@ public:
         unsafe_emplace_back(ne, colorNE);
     }
 
+    [[gnu::always_inline]] void unsafe_emplace_back_textured_quad( //
+        const sf::Color& color,                                    //
+        const sf::Vector2f& nw, const sf::Vector2f& texCoordsNW,   //
+        const sf::Vector2f& sw, const sf::Vector2f& texCoordsSW,   //
+        const sf::Vector2f& se, const sf::Vector2f& texCoordsSE,   //
+        const sf::Vector2f& ne, const sf::Vector2f& texCoordsNE)
+    {
+        unsafe_emplace_back(nw, color, texCoordsNW);
+        unsafe_emplace_back(sw, color, texCoordsSW);
+        unsafe_emplace_back(se, color, texCoordsSE);
+        unsafe_emplace_back(nw, color, texCoordsNW);
+        unsafe_emplace_back(se, color, texCoordsSE);
+        unsafe_emplace_back(ne, color, texCoordsNE);
+    }
+
     [[gnu::always_inline]] void reserve_more_quad(const std::size_t n)
     {
         reserve_more(n * 6);
@@ -0,0 +1,57 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <span>
+
+#include <cstddef>
+
+namespace hg::Utils {
+
+// Offset and colors of a single layer of the 3D effect. Every layer is a copy
+// of the flat geometry, moved by `offset` and drawn with a single color per
+// kind of geometry.
+struct Layer3D
+{
+    sf::Vector2f offset;
+    sf::Color pivotColor;
+    sf::Color wallColor;
+    sf::Color playerColor;
+};
+
+// CPU fallback of the 3D effect: appends one copy of `base` per layer to
+// `out`, moved by the offset of the layer and recolored with `layerColor`.
+template <sf::PrimitiveType TPrimitive>
+void emitLayers3D(FastVertexVector<TPrimitive>& out,
+    const FastVertexVector<TPrimitive>& base,
+    const std::span<const Layer3D> layers,
+    sf::Color Layer3D::*const layerColor)
+{
+    const std::size_t n = base.size();
+    out.reserve(out.size() + n * layers.size());
+
+    for (const Layer3D& layer : layers)
+    {
+        const std::size_t begin = out.size();
+        out.unsafe_emplace_other(base);
+
+        const sf::Color& color = layer.*layerColor;
+
+        for (std::size_t k = begin; k < begin + n; ++k)
+        {
+            out[k].position += layer.offset;
+            out[k].color = color;
+        }
+    }
+}
+
+} // namespace hg::Utils
@@ -0,0 +1,49 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include <cstddef>
+
+namespace hg::Utils {
+
+// Half-open range of rows, `[begin, end)`.
+struct RowRange
+{
+    std::size_t begin;
+    std::size_t end;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return end - begin;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const RowRange&) const = default;
+};
+
+// Returns the rows of a list of `rowCount` rows, all `rowHeight` tall and
+// starting at `listTop`, that intersect the vertical span `[viewTop,
+// viewBottom]`. Used to only lay out and draw the visible part of long lists.
+[[nodiscard]] inline RowRange getVisibleRows(const float listTop,
+    const float rowHeight, const std::size_t rowCount, const float viewTop,
+    const float viewBottom) noexcept
+{
+    if (rowCount == 0 || rowHeight <= 0.f || viewBottom < viewTop)
+    {
+        return {0, 0};
+    }
+
+    const float first = std::floor((viewTop - listTop) / rowHeight);
+    const float last = std::ceil((viewBottom - listTop) / rowHeight);
+
+    const float count = static_cast<float>(rowCount);
+
+    return {static_cast<std::size_t>(std::clamp(first, 0.f, count)),
+        static_cast<std::size_t>(std::clamp(last, 0.f, count))};
+}
+
+} // namespace hg::Utils
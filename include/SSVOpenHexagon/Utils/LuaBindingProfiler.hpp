@@ -0,0 +1,111 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "SSVOpenHexagon/Utils/Clock.hpp"
+
+#include <chrono>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <cstdint>
+
+namespace hg::Utils {
+
+// Counts the invocations of the C++ functions bound to Lua, and accumulates
+// the time spent in each of them. The time of a binding includes the time of
+// any Lua code it executes. Not thread-safe.
+class LuaBindingProfiler
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        std::uint64_t calls{0};
+        std::chrono::nanoseconds totalTime{0};
+    };
+
+    class Scope
+    {
+    private:
+        Entry& _entry;
+        const HRTimePoint _start;
+
+    public:
+        [[nodiscard, gnu::always_inline]] explicit Scope(Entry& entry) noexcept
+            : _entry{entry}, _start{HRClock::now()}
+        {}
+
+        [[gnu::always_inline]] ~Scope() noexcept
+        {
+            ++_entry.calls;
+            _entry.totalTime += HRClock::now() - _start;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    // Entries are never removed, so that bindings can refer to them directly.
+    std::deque<Entry> _entries;
+    std::unordered_map<std::string_view, Entry*> _entriesByName;
+
+public:
+    [[nodiscard]] Entry& getEntry(const std::string& name);
+
+    void clear() noexcept;
+
+    // Called entries, sorted by descending total time.
+    [[nodiscard]] std::vector<const Entry*> getSortedEntries() const;
+
+    void dump(std::ostream& os) const;
+};
+
+[[nodiscard]] LuaBindingProfiler& getLuaBindingProfiler();
+
+namespace Impl {
+
+template <typename F, typename R, typename... Args>
+[[nodiscard]] auto makeProfiledLuaBinding(LuaBindingProfiler::Entry& entry,
+    F&& f, R (std::decay_t<F>::*)(Args...) const)
+{
+    return [&entry, f = SSVOH_FWD(f)](Args... args) -> R
+    {
+        const LuaBindingProfiler::Scope scope{entry};
+        return f(static_cast<Args&&>(args)...);
+    };
+}
+
+template <typename F, typename R, typename... Args>
+[[nodiscard]] auto makeProfiledLuaBinding(LuaBindingProfiler::Entry& entry,
+    F&& f, R (std::decay_t<F>::*)(Args...))
+{
+    return [&entry, f = SSVOH_FWD(f)](Args... args) mutable -> R
+    {
+        const LuaBindingProfiler::Scope scope{entry};
+        return f(static_cast<Args&&>(args)...);
+    };
+}
+
+} // namespace Impl
+
+// Wraps `f` in a function object with the same signature that records its
+// invocations under `name`.
+template <typename F>
+[[nodiscard]] auto makeProfiledLuaBinding(const std::string& name, F&& f)
+{
+    return Impl::makeProfiledLuaBinding(getLuaBindingProfiler().getEntry(name),
+        SSVOH_FWD(f), &std::decay_t<F>::operator());
+}
+
+} // namespace hg::Utils
@@ -140,6 +140,73 @@ public:
     /// read or written by LuaContext
     class Table;
 
+    /// \brief Non-owning view of a Lua array of numbers, received as a
+    /// parameter of a C++ function called by Lua \details Elements are
+    /// read on access, without copying the array. The view is only valid
+    /// for the duration of the call
+    template <typename T>
+    class ArrayView
+    {
+        static_assert(std::is_arithmetic_v<T>);
+
+    private:
+        lua_State* _state;
+        int _index;
+        std::size_t _size;
+
+    public:
+        [[nodiscard]] explicit ArrayView(
+            lua_State* state, const int absoluteIndex) noexcept
+            : _state{state},
+              _index{absoluteIndex},
+              _size{lua_objlen(state, absoluteIndex)}
+        {}
+
+        [[nodiscard, gnu::always_inline]] inline std::size_t size()
+            const noexcept
+        {
+            return _size;
+        }
+
+        /// \brief Returns the element at zero-based index `i` \details
+        /// Elements that are not numbers (e.g. strings or `nil`) are read
+        /// as `0`, use `tryGet` to detect them
+        [[nodiscard, gnu::always_inline]] inline T operator[](
+            const std::size_t i) const
+        {
+            T result{};
+            (void)tryGet(i, result);
+            return result;
+        }
+
+        /// \brief Reads the element at zero-based index `i` into `out`
+        /// \details Returns `false`, leaving `out` unchanged, if the element
+        /// is neither a number nor a string convertible to one
+        [[nodiscard, gnu::always_inline]] inline bool tryGet(
+            const std::size_t i, T& out) const
+        {
+            SSVOH_ASSERT(i < _size);
+            lua_rawgeti(_state, _index, static_cast<int>(i + 1));
+
+            const bool isNumber = lua_isnumber(_state, -1) != 0;
+
+            if (isNumber)
+            {
+                if constexpr (std::is_integral_v<T>)
+                {
+                    out = static_cast<T>(lua_tointeger(_state, -1));
+                }
+                else
+                {
+                    out = static_cast<T>(lua_tonumber(_state, -1));
+                }
+            }
+
+            lua_pop(_state, 1);
+            return isNumber;
+        }
+    };
+
     /// \brief Thrown when an error happens during execution (like not
     /// enough parameters for a function)
     struct ExecutionErrorException : std::runtime_error
@@ -306,6 +373,34 @@ public:
         _setGlobal(mVarName);
     }
 
+    /// \brief Stops or restarts the automatic garbage collector \details
+    /// While stopped, garbage is only collected by `stepGarbageCollector`
+    /// and `collectGarbage`
+    [[gnu::always_inline]] inline void setAutomaticGarbageCollection(
+        const bool enabled)
+    {
+        lua_gc(_state, enabled ? LUA_GCRESTART : LUA_GCSTOP, 0);
+    }
+
+    /// \brief Performs an incremental garbage collection step of size
+    /// `stepSize` \details Returns true if the step finished a cycle
+    [[gnu::always_inline]] inline bool stepGarbageCollector(const int stepSize)
+    {
+        return lua_gc(_state, LUA_GCSTEP, stepSize) == 1;
+    }
+
+    /// \brief Performs a full garbage collection cycle
+    [[gnu::always_inline]] inline void collectGarbage()
+    {
+        lua_gc(_state, LUA_GCCOLLECT, 0);
+    }
+
+    /// \brief Returns the memory in use by the Lua state, in kilobytes
+    [[nodiscard, gnu::always_inline]] inline int getMemoryUsageKB() const
+    {
+        return lua_gc(_state, LUA_GCCOUNT, 0);
+    }
+
     /// \brief Returns the content of a variable \throw
     /// VariableDoesntExistException if variable doesn't exist \note If you
     /// wrote a ObjectWrapper<T> into a variable, you can only read its
@@ -674,7 +769,7 @@ private:
 
     [[gnu::always_inline]] inline int _push(std::string_view s)
     {
-        lua_pushstring(_state, s.data());
+        lua_pushlstring(_state, s.data(), s.size());
         return 1;
     }
 
@@ -988,6 +1083,25 @@ private:
         return lua_tostring(_state, index);
     }
 
+    // string view
+    // unlike the std::string overload this does not copy anything, so the
+    // result is only valid while the value stays on the stack (e.g. for the
+    // parameters of a C++ function called by Lua)
+    [[gnu::always_inline]] inline std::string_view _read(
+        const int index, std::string_view const* = nullptr) const
+    {
+        if (lua_isuserdata(_state, index))
+        {
+            throw WrongTypeException{};
+        }
+
+        std::size_t size{0};
+        const char* const data = lua_tolstring(_state, index, &size);
+
+        return data != nullptr ? std::string_view{data, size}
+                               : std::string_view{};
+    }
+
     // maps
     template <typename Key, typename Value>
     std::map<Key, Value> _read(
@@ -1014,6 +1128,22 @@ private:
         return retValue;
     }
 
+    // array views
+    // the stack index is made absolute, so that the view stays valid while
+    // other values are pushed on the stack
+    template <typename T>
+    [[gnu::always_inline]] inline ArrayView<T> _read(
+        const int index, ArrayView<T> const* = nullptr) const
+    {
+        if (!lua_istable(_state, index))
+        {
+            throw WrongTypeException{};
+        }
+
+        return ArrayView<T>{
+            _state, index < 0 ? lua_gettop(_state) + index + 1 : index};
+    }
+
     // reading array
     Table _read(int index, Table const* = nullptr) const
     {
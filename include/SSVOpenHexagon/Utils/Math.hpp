@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+
 namespace hg::Utils {
 
 inline constexpr float pi{3.14159265359f};
@@ -22,4 +25,83 @@ template <typename T>
     return (T(0) < mX) - (mX < T(0));
 }
 
+struct SinCos
+{
+    float sin;
+    float cos;
+};
+
+namespace Impl {
+
+// `sin(pi/2 * t)` for `t` in `[0, 1]`, both in Q30 fixed point. Evaluated as
+// a degree 13 polynomial with integer arithmetic only, so that the result
+// does not depend on the compiler, its flags or the platform's libm.
+[[nodiscard, gnu::always_inline]] inline constexpr std::int64_t sinQuarterQ30(
+    const std::int64_t t) noexcept
+{
+    constexpr std::int64_t c1 = 1686629713;
+    constexpr std::int64_t c3 = -693598668;
+    constexpr std::int64_t c5 = 85569306;
+    constexpr std::int64_t c7 = -5026995;
+    constexpr std::int64_t c9 = 172272;
+    constexpr std::int64_t c11 = -3864;
+    constexpr std::int64_t c13 = 61;
+
+    const std::int64_t t2 = (t * t) >> 30;
+
+    std::int64_t p = c13;
+    p = c11 + ((p * t2) >> 30);
+    p = c9 + ((p * t2) >> 30);
+    p = c7 + ((p * t2) >> 30);
+    p = c5 + ((p * t2) >> 30);
+    p = c3 + ((p * t2) >> 30);
+    p = c1 + ((p * t2) >> 30);
+
+    return (p * t) >> 30;
+}
+
+} // namespace Impl
+
+// Sine and cosine of `rad`, bit-exact on every platform. Only a single
+// double-precision multiplication is performed in floating point, the rest
+// is integer arithmetic. The absolute error is below `5e-8`. Used by the
+// simulation so that replays play back identically everywhere.
+[[nodiscard]] inline SinCos sinCos(const float rad) noexcept
+{
+    // A full turn is `2^32` phase units.
+    constexpr double radToPhase = 683565275.5764316;
+    constexpr double phaseLimit = 4611686018427387904.0; // 2^62
+    constexpr double phaseTurn = 4294967296.0;           // 2^32
+
+    double phase = static_cast<double>(rad) * radToPhase;
+
+    if (!(std::abs(phase) < phaseLimit))
+    {
+        phase = std::isfinite(phase) ? std::fmod(phase, phaseTurn) : 0.0;
+    }
+
+    const auto p = static_cast<std::uint32_t>(static_cast<std::int64_t>(phase));
+
+    constexpr std::int64_t one = std::int64_t{1} << 30;
+
+    const std::uint32_t quadrant = p >> 30;
+    const std::int64_t t = p & (one - 1);
+
+    const std::int64_t a = Impl::sinQuarterQ30(t);
+    const std::int64_t b = Impl::sinQuarterQ30(one - t);
+
+    constexpr float scale = 1.f / static_cast<float>(one);
+
+    const auto toFloat = [](const std::int64_t x)
+    { return static_cast<float>(x) * scale; };
+
+    switch (quadrant)
+    {
+        case 0: return {toFloat(a), toFloat(b)};
+        case 1: return {toFloat(b), toFloat(-a)};
+        case 2: return {toFloat(-a), toFloat(-b)};
+        default: return {toFloat(-b), toFloat(a)};
+    }
+}
+
 } // namespace hg::Utils
@@ -0,0 +1,123 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+
+#include <cstddef>
+
+namespace hg::Utils {
+
+// Textured particles stored as a structure of arrays. All the particles of a
+// system share the same texture rectangle and origin, so that they can be
+// emitted as quads into a single vertex array and drawn at once.
+class ParticleSystem
+{
+public:
+    struct Particle
+    {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        float rotationDeg;
+        float angularVelocityDeg;
+        float scale;
+        sf::Color color;
+    };
+
+private:
+    std::vector<sf::Vector2f> _positions;
+    std::vector<sf::Vector2f> _velocities;
+    std::vector<float> _rotationsDeg;
+    std::vector<float> _angularVelocitiesDeg;
+    std::vector<float> _scales;
+    std::vector<sf::Color> _colors;
+
+    void moveParticle(const std::size_t from, const std::size_t to) noexcept;
+    void resize(const std::size_t n);
+
+public:
+    void reserve(const std::size_t n);
+    void clear() noexcept;
+
+    void emplace(const Particle& p);
+
+    // Removes the particles whose index satisfies `pred`, preserving the
+    // order of the remaining ones.
+    template <typename F>
+    void eraseIf(F&& pred)
+    {
+        std::size_t kept = 0;
+
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            if (pred(i))
+            {
+                continue;
+            }
+
+            if (kept != i)
+            {
+                moveParticle(i, kept);
+            }
+
+            ++kept;
+        }
+
+        resize(kept);
+    }
+
+    // Moves every particle by its velocity and rotates it by its angular
+    // velocity, scaled by `mFT`.
+    void integrate(const float mFT) noexcept;
+
+    // Appends two textured triangles per particle to `out`. `textureRect` is
+    // in texture pixels, `origin` is the local center of rotation and scale.
+    void emitQuads(FastVertexVectorTris& out, const sf::FloatRect& textureRect,
+        const sf::Vector2f& origin) const;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _positions.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _positions.empty();
+    }
+
+    [[nodiscard]] std::vector<sf::Vector2f>& positions() noexcept
+    {
+        return _positions;
+    }
+
+    [[nodiscard]] std::vector<float>& scales() noexcept
+    {
+        return _scales;
+    }
+
+    [[nodiscard]] std::vector<sf::Color>& colors() noexcept
+    {
+        return _colors;
+    }
+
+    [[nodiscard]] const std::vector<sf::Vector2f>& positions() const noexcept
+    {
+        return _positions;
+    }
+
+    [[nodiscard]] const std::vector<sf::Color>& colors() const noexcept
+    {
+        return _colors;
+    }
+};
+
+} // namespace hg::Utils
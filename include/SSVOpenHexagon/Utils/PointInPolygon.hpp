@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
+
 #include <SFML/System/Vector2.hpp>
 
 namespace hg::Utils {
@@ -45,10 +47,10 @@ pointInFourVertexPolygon(const sf::Vector2f& a, const sf::Vector2f& b,
     const sf::Vector2f cp_cd = point - c;
     const sf::Vector2f dp_da = point - d;
 
-    const float ab_x_ap = ab.cross(ap_ab);
-    const float bc_x_bp = bc.cross(bp_bc);
-    const float cd_x_cp = cd.cross(cp_cd);
-    const float da_x_dp = da.cross(dp_da);
+    const float ab_x_ap = Strict::cross(ab, ap_ab);
+    const float bc_x_bp = Strict::cross(bc, bp_bc);
+    const float cd_x_cp = Strict::cross(cd, cp_cd);
+    const float da_x_dp = Strict::cross(da, dp_da);
 
     return (ab_x_ap <= 0.f && bc_x_bp <= 0.f && cd_x_cp <= 0.f &&
                da_x_dp <= 0.f) ||
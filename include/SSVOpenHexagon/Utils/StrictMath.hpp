@@ -0,0 +1,185 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include "SSVOpenHexagon/Utils/Math.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cmath>
+
+// Strict-deterministic math used by the simulation. Replays are recorded and
+// validated on different platforms and builds, so the simulation must produce
+// the same bits everywhere. Single IEEE 754 operations (`+`, `-`, `*`, `/` and
+// `sqrt`) are correctly rounded and therefore deterministic, but compilers are
+// allowed to contract `a * b + c` into a fused multiply-add, which rounds only
+// once and changes the result. Every product below goes through `fence`, so
+// it is rounded on its own whatever the compiler flags. This keeps the
+// simulation replay-identical in `-O3`, `-march=native` and
+// `-ffp-contract=fast` builds. `-ffast-math` is not supported, as it allows
+// reassociating sums as well.
+namespace hg::Utils::Strict {
+
+// Returns `x` unchanged, hiding it from the optimizer so that the operation
+// that produced it cannot be fused with the ones that consume it.
+[[nodiscard, gnu::always_inline]] inline float fence(float x) noexcept
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__SSE_MATH__))
+    asm("" : "+x"(x));
+#elif defined(__GNUC__) && defined(__aarch64__)
+    asm("" : "+w"(x));
+#elif defined(__GNUC__)
+    asm("" : "+m"(x));
+#endif
+    // MSVC does not contract floating point operations unless `/fp:contract`
+    // or `/fp:fast` are used.
+    return x;
+}
+
+[[nodiscard, gnu::always_inline]] inline double fence(double x) noexcept
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__SSE2_MATH__))
+    asm("" : "+x"(x));
+#elif defined(__GNUC__) && defined(__aarch64__)
+    asm("" : "+w"(x));
+#elif defined(__GNUC__)
+    asm("" : "+m"(x));
+#endif
+    return x;
+}
+
+[[nodiscard, gnu::always_inline]] inline float mul(
+    const float a, const float b) noexcept
+{
+    return fence(a * b);
+}
+
+[[nodiscard, gnu::always_inline]] inline float mulAdd(
+    const float a, const float b, const float c) noexcept
+{
+    return mul(a, b) + c;
+}
+
+[[nodiscard, gnu::always_inline]] inline double mulAdd(
+    const double a, const double b, const double c) noexcept
+{
+    return fence(a * b) + c;
+}
+
+[[nodiscard, gnu::always_inline]] inline sf::Vector2f mul(
+    const sf::Vector2f& v, const float s) noexcept
+{
+    return {mul(v.x, s), mul(v.y, s)};
+}
+
+// `v * s + offset`.
+[[nodiscard, gnu::always_inline]] inline sf::Vector2f mulAdd(
+    const sf::Vector2f& v, const float s, const sf::Vector2f& offset) noexcept
+{
+    return {mulAdd(v.x, s, offset.x), mulAdd(v.y, s, offset.y)};
+}
+
+[[nodiscard, gnu::always_inline]] inline float dot(
+    const sf::Vector2f& a, const sf::Vector2f& b) noexcept
+{
+    return mul(a.x, b.x) + mul(a.y, b.y);
+}
+
+[[nodiscard, gnu::always_inline]] inline float cross(
+    const sf::Vector2f& a, const sf::Vector2f& b) noexcept
+{
+    return mul(a.x, b.y) - mul(a.y, b.x);
+}
+
+[[nodiscard, gnu::always_inline]] inline float lengthSq(
+    const sf::Vector2f& v) noexcept
+{
+    return dot(v, v);
+}
+
+[[nodiscard, gnu::always_inline]] inline sf::Vector2f normalized(
+    const sf::Vector2f& v) noexcept
+{
+    const float length = std::sqrt(lengthSq(v));
+    return {v.x / length, v.y / length};
+}
+
+// Rotates `v` around `center` by the angle whose sine and cosine are `sc`.
+[[nodiscard, gnu::always_inline]] inline sf::Vector2f rotatedAround(
+    const sf::Vector2f& v, const sf::Vector2f& center,
+    const SinCos& sc) noexcept
+{
+    const float x = v.x - center.x;
+    const float y = v.y - center.y;
+
+    return {(mul(x, sc.cos) - mul(y, sc.sin)) + center.x,
+        (mul(x, sc.sin) + mul(y, sc.cos)) + center.y};
+}
+
+// Deterministic equivalent of `sf::Vector2f::movedTowards`.
+[[nodiscard, gnu::always_inline]] inline sf::Vector2f movedTowards(
+    const sf::Vector2f& pos, const float distance, const float rad) noexcept
+{
+    const SinCos sc = sinCos(rad);
+    return {mulAdd(distance, sc.cos, pos.x), mulAdd(distance, sc.sin, pos.y)};
+}
+
+// Deterministic `std::atan2`, accurate to about `2e-7` radians. Range
+// reduction followed by the single precision polynomial from Cephes, with
+// every operation rounded on its own.
+[[nodiscard]] inline float atan2(const float y, const float x) noexcept
+{
+    if (x == 0.f && y == 0.f)
+    {
+        return 0.f;
+    }
+
+    const float ax = std::abs(x);
+    const float ay = std::abs(y);
+
+    const bool swapped = ay > ax;
+    const float t = swapped ? ax / ay : ay / ax; // In `[0, 1]`.
+
+    // `atan(t) = pi/4 + atan((t - 1) / (t + 1))` brings `t` below
+    // `tan(pi/8)`, where the polynomial is accurate.
+    constexpr float tanPiOver8 = 0.414213562373f;
+    const bool shifted = t > tanPiOver8;
+    const float u = shifted ? (t - 1.f) / (t + 1.f) : t;
+
+    const float z = mul(u, u);
+
+    float p = 8.05374449538e-2f;
+    p = mulAdd(p, z, -1.38776856032e-1f);
+    p = mulAdd(p, z, 1.99777106478e-1f);
+    p = mulAdd(p, z, -3.33329491539e-1f);
+
+    float r = mulAdd(mul(p, z), u, u);
+
+    if (shifted)
+    {
+        r += pi / 4.f;
+    }
+
+    if (swapped)
+    {
+        r = pi / 2.f - r;
+    }
+
+    if (x < 0.f)
+    {
+        r = pi - r;
+    }
+
+    return y < 0.f ? -r : r;
+}
+
+// Deterministic equivalent of `sf::Vector2f::angle().asRadians()`.
+[[nodiscard, gnu::always_inline]] inline float angle(
+    const sf::Vector2f& v) noexcept
+{
+    return atan2(v.y, v.x);
+}
+
+} // namespace hg::Utils::Strict
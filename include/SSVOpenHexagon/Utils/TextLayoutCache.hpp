@@ -0,0 +1,113 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <SFML/Graphics/Text.hpp>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sf {
+class Font;
+}
+
+namespace hg::Utils {
+
+// Keeps laid-out copies of texts that are drawn with many different strings
+// every frame, such as the menu texts. Glyph quads are only re-shaped when
+// the string, font, character size, style or outline thickness of a text
+// actually change, instead of every time a shared `sf::Text` is reused.
+class TextLayoutCache
+{
+private:
+    struct KeyView
+    {
+        std::string_view string;
+        const sf::Font* font;
+        unsigned int characterSize;
+        std::uint32_t style;
+        float outlineThickness;
+
+        [[nodiscard]] bool operator==(const KeyView&) const = default;
+    };
+
+    struct Key
+    {
+        std::string string;
+        const sf::Font* font;
+        unsigned int characterSize;
+        std::uint32_t style;
+        float outlineThickness;
+
+        [[nodiscard]] KeyView view() const noexcept
+        {
+            return {string, font, characterSize, style, outlineThickness};
+        }
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(const KeyView& k) const noexcept;
+
+        [[nodiscard]] std::size_t operator()(const Key& k) const noexcept
+        {
+            return (*this)(k.view());
+        }
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] static KeyView view(const KeyView& k) noexcept
+        {
+            return k;
+        }
+
+        [[nodiscard]] static KeyView view(const Key& k) noexcept
+        {
+            return k.view();
+        }
+
+        template <typename A, typename B>
+        [[nodiscard]] bool operator()(const A& a, const B& b) const noexcept
+        {
+            return view(a) == view(b);
+        }
+    };
+
+    struct Entry
+    {
+        sf::Text text;
+        std::uint64_t lastUsedFrame;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash, KeyEqual> _entries;
+    std::uint64_t _frame{0};
+
+public:
+    // Entries not used for this many frames are evicted by `nextFrame`.
+    static constexpr std::uint64_t maxIdleFrames = 120;
+
+    // Returns a text laid out like `prototype`, with `string` as its string.
+    // The colors, origin, rotation and scale of `prototype` are copied into
+    // the returned text every time, the position is left to the caller.
+    [[nodiscard]] sf::Text& get(
+        const sf::Text& prototype, const std::string_view string);
+
+    // Advances to the next frame, evicting the idle entries.
+    void nextFrame();
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+} // namespace hg::Utils
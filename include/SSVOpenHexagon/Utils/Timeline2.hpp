@@ -4,26 +4,141 @@
 
 #pragma once
 
+#include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
 #include "SSVOpenHexagon/Utils/FixedFunction.hpp"
 #include "SSVOpenHexagon/Utils/TinyVariant.hpp"
 
 #include <chrono>
 #include <SFML/Base/Optional.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <vector>
 
 namespace hg::Utils {
 
-class timeline2
+// Vector of recyclable slots. Released slots are reused by the next
+// `acquire` calls, and existing slots never move in memory, even when new
+// ones are added while a slot is being used.
+template <typename T>
+class recycling_pool
+{
+private:
+    std::deque<T> _items;
+    std::vector<std::uint32_t> _free_indices;
+
+public:
+    template <typename... Ts>
+    [[nodiscard]] std::uint32_t acquire(Ts&&... xs)
+    {
+        if (_free_indices.empty())
+        {
+            _items.emplace_back(SSVOH_FWD(xs)...);
+            return static_cast<std::uint32_t>(_items.size() - 1);
+        }
+
+        const std::uint32_t index = _free_indices.back();
+        _free_indices.pop_back();
+
+        _items[index] = T{SSVOH_FWD(xs)...};
+        return index;
+    }
+
+    void release(const std::uint32_t index)
+    {
+        SSVOH_ASSERT(index < _items.size());
+
+        _items[index] = T{};
+        _free_indices.emplace_back(index);
+    }
+
+    void reserve(const std::size_t n)
+    {
+        _free_indices.reserve(n);
+    }
+
+    [[nodiscard, gnu::always_inline]] T& operator[](
+        const std::uint32_t index) noexcept
+    {
+        SSVOH_ASSERT(index < _items.size());
+        return _items[index];
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _items.size();
+    }
+};
+
+// Storage for the functions of the actions of many timelines, shared so that
+// timelines that are cleared and refilled reuse each other's slots.
+//
+// A function run through `run_do_fn` can clear timelines, including the one
+// it belongs to (e.g. `t_clear` inside `t_eval`). Slots released while a
+// function is running are only recycled once it returns, so that the running
+// function is neither destroyed nor overwritten by a new `acquire`.
+class timeline2_arena
 {
 public:
     using clock = std::chrono::high_resolution_clock;
     using time_point = clock::time_point;
+
+    using do_fn = Utils::FixedFunction<void(), 64>;
+    using time_point_fn = Utils::FixedFunction<time_point(), 32>;
+
+private:
+    recycling_pool<do_fn> _do_fns;
+    recycling_pool<time_point_fn> _time_point_fns;
+
+    std::uint32_t _running_fns{0};
+    std::vector<std::uint32_t> _deferred_do_fns;
+    std::vector<std::uint32_t> _deferred_time_point_fns;
+
+    void release_deferred_fns();
+
+public:
+    template <typename F>
+    [[nodiscard]] std::uint32_t acquire_do_fn(F&& func)
+    {
+        return _do_fns.acquire(SSVOH_FWD(func));
+    }
+
+    template <typename F>
+    [[nodiscard]] std::uint32_t acquire_time_point_fn(F&& tp_fn)
+    {
+        return _time_point_fns.acquire(SSVOH_FWD(tp_fn));
+    }
+
+    void release_do_fn(const std::uint32_t index);
+    void release_time_point_fn(const std::uint32_t index);
+
+    void reserve(const std::size_t n);
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    void run_do_fn(const std::uint32_t index);
+
+    [[nodiscard, gnu::always_inline]] time_point_fn& get_time_point_fn(
+        const std::uint32_t index) noexcept
+    {
+        return _time_point_fns[index];
+    }
+};
+
+class timeline2
+{
+public:
+    using clock = timeline2_arena::clock;
+    using time_point = timeline2_arena::time_point;
     using duration = clock::duration;
 
+    // Actions only refer to their function, stored in the arena, so that
+    // they stay small and waits do not pay for an unused function.
     struct action_do
     {
-        Utils::FixedFunction<void(), 64> _func;
+        std::uint32_t _fn_index;
     };
 
     struct action_wait_for
@@ -38,24 +153,40 @@ public:
 
     struct action_wait_until_fn
     {
-        Utils::FixedFunction<time_point(), 32> _time_point_fn;
+        std::uint32_t _fn_index;
     };
 
     using action = vittorioromeo::tinyvariant<action_do, action_wait_for,
         action_wait_until, action_wait_until_fn>;
 
 private:
+    timeline2_arena* _arena;
     std::vector<action> _actions;
 
+    void release_all_fns();
+
 public:
+    explicit timeline2(timeline2_arena& arena) noexcept;
+    ~timeline2();
+
+    timeline2(const timeline2&) = delete;
+    timeline2& operator=(const timeline2&) = delete;
+
+    timeline2(timeline2&& rhs) noexcept;
+    timeline2& operator=(timeline2&& rhs) noexcept;
+
+    // Keeps the allocated storage, so that refilling the timeline after it
+    // has been cleared (e.g. on every `onStep`) does not allocate. The slots
+    // of the functions are returned to the arena.
     void clear();
+    void reserve(const std::size_t n);
 
     template <typename F>
     void append_do(F&& func)
     {
         _actions.emplace_back(
             vittorioromeo::impl::tinyvariant_inplace_type_t<action_do>{},
-            SSVOH_FWD(func));
+            action_do{_arena->acquire_do_fn(SSVOH_FWD(func))});
     }
 
     void append_wait_for(const duration d);
@@ -68,11 +199,13 @@ public:
     {
         _actions.emplace_back(vittorioromeo::impl::tinyvariant_inplace_type_t<
                                   action_wait_until_fn>{},
-            SSVOH_FWD(tp_fn));
+            action_wait_until_fn{
+                _arena->acquire_time_point_fn(SSVOH_FWD(tp_fn))});
     }
 
     [[nodiscard]] std::size_t size() const noexcept;
-    [[nodiscard]] action& action_at(const std::size_t i) noexcept;
+    [[nodiscard]] const action& action_at(const std::size_t i) const noexcept;
+    [[nodiscard]] timeline2_arena& arena() noexcept;
 };
 
 class timeline2_runner
@@ -0,0 +1,74 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <cstdint>
+
+namespace hg::Utils {
+
+// Lock-free single-producer single-consumer triple buffer. The producer fills
+// the write buffer and publishes it, the consumer picks up the most recently
+// published buffer. Neither side ever waits for the other, and the buffer
+// being read is never the one being written. Buffers are reused, so their
+// allocations are kept across publications.
+template <typename T>
+class TripleBuffer
+{
+private:
+    // Set in `_middle` when it holds a buffer that has not been consumed yet.
+    static constexpr std::uint8_t freshBit = 0b100;
+    static constexpr std::uint8_t indexMask = 0b011;
+
+    std::array<T, 3> _buffers{};
+
+    std::uint8_t _back{0};                // Only used by the producer.
+    std::atomic<std::uint8_t> _middle{1}; // Exchanged by both sides.
+    std::uint8_t _front{2};               // Only used by the consumer.
+
+public:
+    // Producer: the buffer to fill before calling `publish`. It still holds
+    // the contents of an older publication.
+    [[nodiscard]] T& getWriteBuffer() noexcept
+    {
+        return _buffers[_back];
+    }
+
+    // Producer: makes the write buffer available to the consumer.
+    void publish() noexcept
+    {
+        const std::uint8_t prev = _middle.exchange(
+            static_cast<std::uint8_t>(_back | freshBit),
+            std::memory_order_acq_rel);
+
+        _back = prev & indexMask;
+    }
+
+    // Consumer: switches to the most recently published buffer, if any was
+    // published since the last call. Returns whether the buffer changed.
+    [[nodiscard]] bool consume() noexcept
+    {
+        if ((_middle.load(std::memory_order_relaxed) & freshBit) == 0)
+        {
+            return false;
+        }
+
+        const std::uint8_t prev =
+            _middle.exchange(_front, std::memory_order_acq_rel);
+
+        _front = prev & indexMask;
+        return true;
+    }
+
+    // Consumer: the buffer obtained by the last successful `consume`.
+    [[nodiscard]] const T& getReadBuffer() const noexcept
+    {
+        return _buffers[_front];
+    }
+};
+
+} // namespace hg::Utils
@@ -13,6 +13,7 @@
 #include "SSVOpenHexagon/Utils/Math.hpp"
 #include "SSVOpenHexagon/Utils/MoveTowards.hpp"
 #include "SSVOpenHexagon/Utils/PointInPolygon.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 #include "SSVOpenHexagon/Utils/Ticker.hpp"
 
 #include <SFML/System/Angle.hpp>
@@ -173,11 +174,12 @@ void CPlayer::kill(const bool fatal)
 
         // Avoid moving back position if the player had just swapped or the
         // player was forcibly moved by a lot via Lua scripting.
-        if (!_justSwapped && (_lastPos - _pos).length() < 24.f)
+        if (!_justSwapped &&
+            Utils::Strict::lengthSq(_lastPos - _pos) < 24.f * 24.f)
         {
             // Move back position to graphically show the tip of the triangle
             // hitting the wall rather than the center of the triangle.
-            _pos = _lastPos.movedTowards(-_size, sf::radians(_angle));
+            _pos = Utils::Strict::movedTowards(_lastPos, -_size, _angle);
         }
     }
 }
@@ -206,7 +208,7 @@ template <typename Wall>
 
     const auto assignResult = [&]()
     {
-        tempDistance = (vec1 - pos).lengthSq();
+        tempDistance = Utils::Strict::lengthSq(vec1 - pos);
         if (tempDistance < safeDistance)
         {
             pos = vec1;
@@ -233,7 +235,8 @@ template <typename Wall>
 
             case 2u:
             {
-                if ((vec1 - pos).lengthSq() > (vec2 - pos).lengthSq())
+                if (Utils::Strict::lengthSq(vec1 - pos) >
+                    Utils::Strict::lengthSq(vec2 - pos))
                 {
                     vec1 = vec2;
                 }
@@ -282,10 +285,12 @@ template <typename Wall>
     {
         const sf::Vector2f posDiff = testPos - _prePushPos;
         const sf::Vector2f posDiffNormalized =
-            posDiff == sf::Vector2f::Zero ? posDiff : posDiff.normalized();
+            posDiff == sf::Vector2f::Zero ? posDiff
+                                          : Utils::Strict::normalized(posDiff);
 
-        _pos = testPos + posDiffNormalized * (2.f * collisionPadding);
-        _angle = _pos.angle().asRadians();
+        _pos = Utils::Strict::mulAdd(
+            posDiffNormalized, 2.f * collisionPadding, testPos);
+        _angle = Utils::Strict::angle(_pos);
         updatePosition(radius);
         return wall.isOverlapping(_pos);
     }
@@ -315,8 +320,10 @@ template <typename Wall>
     // If player survived assign it the saving testPos, but displace it further
     // out the wall border, otherwise player would be lying right on top of the
     // border.
-    _pos = testPos + (testPos - _prePushPos).normalized() * collisionPadding;
-    _angle = _pos.angle().asRadians();
+    _pos = Utils::Strict::mulAdd(
+        Utils::Strict::normalized(testPos - _prePushPos), collisionPadding,
+        testPos);
+    _angle = Utils::Strict::angle(_pos);
     updatePosition(radius);
     return false;
 }
@@ -365,7 +372,9 @@ template <typename Wall>
                     i2, _lastPos, wVertexes[i], wVertexes[j], radiusSquared))
             {
                 pushVel = i2 - i1;
-                if (std::abs(pushVel.normalized().dot(_lastPos.normalized())) >
+                if (std::abs(Utils::Strict::dot(
+                        Utils::Strict::normalized(pushVel),
+                        Utils::Strict::normalized(_lastPos))) >
                     pushDotThreshold)
                 {
                     pushVel = {0.f, 0.f};
@@ -379,8 +388,10 @@ template <typename Wall>
     if (!movementDir && !_forcedMove)
     {
         _pos += pushVel;
-        _pos += (_pos - _prePushPos).normalized() * (2.f * collisionPadding);
-        _angle = _pos.angle().asRadians();
+        _pos = Utils::Strict::mulAdd(
+            Utils::Strict::normalized(_pos - _prePushPos),
+            2.f * collisionPadding, _pos);
+        _angle = Utils::Strict::angle(_pos);
         updatePosition(radius);
         return wall.isOverlapping(_pos);
     }
@@ -396,8 +407,10 @@ template <typename Wall>
     // If player survived assign it the saving testPos, but displace it further
     // out the wall border, otherwise player would be lying right on top of the
     // border.
-    _pos = testPos + (testPos - _prePushPos).normalized() * collisionPadding;
-    _angle = _pos.angle().asRadians();
+    _pos = Utils::Strict::mulAdd(
+        Utils::Strict::normalized(testPos - _prePushPos), collisionPadding,
+        testPos);
+    _angle = Utils::Strict::angle(_pos);
     updatePosition(radius);
 
     return false;
@@ -461,7 +474,7 @@ void CPlayer::updateInputMovement(const float movementDir,
     const float playerSpeedMult, const bool focused, const float ft)
 {
     _currentSpeed = playerSpeedMult * (focused ? _focusSpeed : _speed) * ft;
-    _angle += Utils::toRad(_currentSpeed * movementDir);
+    _angle += Utils::Strict::fence(Utils::toRad(_currentSpeed * movementDir));
 
     const float inc = ft / 10.f;
 
@@ -486,13 +499,16 @@ void CPlayer::updatePosition(const float radius)
 {
     _radius = radius;
 
-    _prePushPos = _pos = _startPos.movedTowards(_radius, sf::radians(_angle));
-    _lastPos = _startPos.movedTowards(_radius, sf::radians(_lastAngle));
+    _prePushPos = _pos =
+        Utils::Strict::movedTowards(_startPos, _radius, _angle);
+    _lastPos = Utils::Strict::movedTowards(_startPos, _radius, _lastAngle);
+
+    const float nextAngle =
+        _lastAngle + Utils::Strict::fence(Utils::toRad(_currentSpeed));
 
     _maxSafeDistance =
-        (_lastPos - _startPos.movedTowards(_radius,
-                        sf::radians(_lastAngle + Utils::toRad(_currentSpeed))))
-            .lengthSq() +
+        Utils::Strict::lengthSq(_lastPos -
+            Utils::Strict::movedTowards(_startPos, _radius, nextAngle)) +
         32.f;
 }
 
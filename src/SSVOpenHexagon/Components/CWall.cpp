@@ -5,6 +5,7 @@
 #include "SSVOpenHexagon/Components/CWall.hpp"
 
 #include "SSVOpenHexagon/Utils/Math.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 #include "SSVOpenHexagon/Utils/Color.hpp"
 
 #include <SFML/System/Vector2.hpp>
@@ -16,25 +17,31 @@ CWall::CWall(const unsigned int sides, const float wallAngleLeft,
     const float wallSkewRight, const sf::Vector2f& centerPos, const int side,
     const float thickness, const float distance, const SpeedData& speed,
     const SpeedData& curve, const float hueMod)
-    : _speed{speed}, _curve{curve}, _hueMod{hueMod}, _killed{false}
+    : _speed{speed},
+      _curve{curve},
+      _curveRad{0.f},
+      _curveSinCos{0.f, 1.f},
+      _hueMod{hueMod},
+      _killed{false}
 {
     const float div{Utils::tau / static_cast<float>(sides) * 0.5f};
-    const float angle{div * 2.f * static_cast<float>(side)};
+    const float angle{
+        Utils::Strict::mul(div * 2.f, static_cast<float>(side))};
 
     const float angleN = angle - div;
     const float angleP = angle + div;
 
-    _vertexPositions[0] = centerPos.movedTowards(distance, sf::radians(angleN));
+    _vertexPositions[0] =
+        Utils::Strict::movedTowards(centerPos, distance, angleN);
 
-    _vertexPositions[1] = centerPos.movedTowards(distance, sf::radians(angleP));
+    _vertexPositions[1] =
+        Utils::Strict::movedTowards(centerPos, distance, angleP);
 
-    _vertexPositions[2] =
-        centerPos.movedTowards(distance + thickness + wallSkewLeft,
-            sf::radians(angleP + wallAngleLeft));
+    _vertexPositions[2] = Utils::Strict::movedTowards(centerPos,
+        distance + thickness + wallSkewLeft, angleP + wallAngleLeft);
 
-    _vertexPositions[3] =
-        centerPos.movedTowards(distance + thickness + wallSkewRight,
-            sf::radians(angleN + wallAngleRight));
+    _vertexPositions[3] = Utils::Strict::movedTowards(centerPos,
+        distance + thickness + wallSkewRight, angleN + wallAngleRight);
 }
 
 void CWall::draw(sf::Color color, Utils::FastVertexVectorTris& wallQuads)
@@ -86,7 +93,8 @@ void CWall::moveTowardsCenter(const float wallSpawnDist, const float radius,
             ++pointsOutOfBounds;
         }
 
-        vp += (centerPos - vp).normalized() * _speed._speed * 5.f * ft;
+        vp += Utils::Strict::mul(Utils::Strict::normalized(centerPos - vp),
+            _speed._speed * 5.f * ft);
     }
 
     if (pointsOnCenter == 4 || pointsOutOfBounds == 4)
@@ -98,12 +106,16 @@ void CWall::moveTowardsCenter(const float wallSpawnDist, const float radius,
 void CWall::moveCurve(const sf::Vector2f& centerPos, const float ft)
 {
     const float rad = getCurveRadians(ft);
-    const float radSin = std::sin(rad);
-    const float radCos = std::cos(rad);
+
+    if (rad != _curveRad)
+    {
+        _curveRad = rad;
+        _curveSinCos = Utils::sinCos(rad);
+    }
 
     for (sf::Vector2f& vp : _vertexPositions)
     {
-        moveVertexAlongCurveImpl(vp, centerPos, radSin, radCos);
+        moveVertexAlongCurveImpl(vp, centerPos, _curveSinCos);
     }
 }
 
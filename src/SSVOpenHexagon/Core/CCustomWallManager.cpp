@@ -70,6 +70,50 @@ namespace hg {
     return checkValidVertexIdx(h, vertexIdx, msg) && checkValidHandle(h, msg);
 }
 
+[[nodiscard]] bool CCustomWallManager::checkValidBatchSize(
+    const std::size_t handleCount, const std::size_t valueCount,
+    const std::size_t valuesPerHandle, const char* msg)
+{
+    if (valueCount != handleCount * valuesPerHandle) [[unlikely]]
+    {
+        ssvu::lo("CustomWallManager")
+            << "Attempted to " << msg << " of " << handleCount
+            << " custom walls with " << valueCount << " values instead of "
+            << handleCount * valuesPerHandle << '\n';
+
+        return false;
+    }
+
+    return true;
+}
+
+template <typename F>
+void CCustomWallManager::forEachValidHandle(
+    std::span<const CCustomWallHandle> cwHandles, const char* msg, F&& f)
+{
+    std::size_t invalidCount = 0;
+
+    for (std::size_t i = 0; i < cwHandles.size(); ++i)
+    {
+        const CCustomWallHandle h = cwHandles[i];
+
+        if (!isValidHandle(h) || _handleAvailable[h]) [[unlikely]]
+        {
+            ++invalidCount;
+            continue;
+        }
+
+        f(_customWalls[h], i);
+    }
+
+    if (invalidCount > 0) [[unlikely]]
+    {
+        ssvu::lo("CustomWallManager")
+            << "Attempted to " << msg << " of " << invalidCount
+            << " invalid custom walls\n";
+    }
+}
+
 [[nodiscard]] CCustomWallHandle CCustomWallManager::create(
     void (*fAfterCreate)(CCustomWall&))
 {
@@ -322,6 +366,66 @@ void CCustomWallManager::setVertexColor4Same(
     customWall.setVertexColor(3, color);
 }
 
+void CCustomWallManager::setVertexPos4Many(
+    std::span<const CCustomWallHandle> cwHandles,
+    std::span<const sf::Vector2f> positions)
+{
+    constexpr const char* msg = "set four vertex pos";
+
+    if (!checkValidBatchSize(cwHandles.size(), positions.size(), 4, msg))
+    {
+        return;
+    }
+
+    forEachValidHandle(cwHandles, msg,
+        [&](CCustomWall& customWall, const std::size_t i)
+        {
+            const sf::Vector2f* p = positions.data() + i * 4;
+
+            customWall.setVertexPos(0, p[0]);
+            customWall.setVertexPos(1, p[1]);
+            customWall.setVertexPos(2, p[2]);
+            customWall.setVertexPos(3, p[3]);
+        });
+}
+
+void CCustomWallManager::moveVertexPos4SameMany(
+    std::span<const CCustomWallHandle> cwHandles,
+    std::span<const sf::Vector2f> offsets)
+{
+    constexpr const char* msg = "add four vertex pos same";
+
+    if (!checkValidBatchSize(cwHandles.size(), offsets.size(), 1, msg))
+    {
+        return;
+    }
+
+    forEachValidHandle(cwHandles, msg,
+        [&](CCustomWall& customWall, const std::size_t i)
+        { customWall.moveVertexPos4Same(offsets[i]); });
+}
+
+void CCustomWallManager::setVertexColor4SameMany(
+    std::span<const CCustomWallHandle> cwHandles,
+    std::span<const sf::Color> colors)
+{
+    constexpr const char* msg = "set four vertex color same";
+
+    if (!checkValidBatchSize(cwHandles.size(), colors.size(), 1, msg))
+    {
+        return;
+    }
+
+    forEachValidHandle(cwHandles, msg,
+        [&](CCustomWall& customWall, const std::size_t i)
+        {
+            customWall.setVertexColor(0, colors[i]);
+            customWall.setVertexColor(1, colors[i]);
+            customWall.setVertexColor(2, colors[i]);
+            customWall.setVertexColor(3, colors[i]);
+        });
+}
+
 void CCustomWallManager::clear()
 {
     _freeHandles.clear();
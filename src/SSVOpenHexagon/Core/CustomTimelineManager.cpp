@@ -15,25 +15,35 @@
 
 namespace hg {
 
-CustomTimelineManager::CustomTimelineManager() = default;
+CustomTimelineManager::CustomTimelineManager(Utils::timeline2_arena& arena)
+    : _arena{arena}
+{}
 
 CustomTimelineManager::~CustomTimelineManager() = default;
 
 [[nodiscard]] bool CustomTimelineManager::isHandleValid(
     const CustomTimelineHandle h) const noexcept
 {
-    return h >= 0 && h < static_cast<CustomTimelineHandle>(_timelines.size());
+    return h >= 0 && h < static_cast<CustomTimelineHandle>(_count);
 }
 
-void CustomTimelineManager::clear() noexcept
+void CustomTimelineManager::clear()
 {
-    _timelines.clear();
+    // Return the slots of the functions to the arena right away.
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        _timelines[i]._timeline.clear();
+    }
+
+    _count = 0;
 }
 
 void CustomTimelineManager::updateAllTimelines(const HRTimePoint tp)
 {
-    for (CustomTimeline& t : _timelines)
+    for (std::size_t i = 0; i < _count; ++i)
     {
+        CustomTimeline& t = _timelines[i];
+
         if (const auto o = t._runner.update(t._timeline, tp);
             o == Utils::timeline2_runner::outcome::finished)
         {
@@ -45,8 +55,18 @@ void CustomTimelineManager::updateAllTimelines(const HRTimePoint tp)
 
 [[nodiscard]] CustomTimelineHandle CustomTimelineManager::create()
 {
-    _timelines.emplace_back();
-    const CustomTimelineHandle h = _timelines.size() - 1;
+    if (_count == _timelines.size())
+    {
+        _timelines.emplace_back(_arena);
+    }
+    else
+    {
+        CustomTimeline& t = _timelines[_count];
+        t._timeline.clear();
+        t._runner = {};
+    }
+
+    const CustomTimelineHandle h = _count++;
 
     SSVOH_ASSERT(isHandleValid(h));
     return h;
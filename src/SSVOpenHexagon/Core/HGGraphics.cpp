@@ -3,6 +3,8 @@
 // AFL License page: https://opensource.org/licenses/AFL-3.0
 
 #include "SSVOpenHexagon/Core/HexagonGame.hpp"
+#include "SSVOpenHexagon/Core/RenderSnapshot.hpp"
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
 
 #include "SSVOpenHexagon/Components/CWall.hpp"
 
@@ -24,8 +26,17 @@
 #include <SSVUtils/Core/Utils/Rnd.hpp>
 
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cctype>
 #include <cstdint>
 
 namespace hg {
@@ -38,8 +49,20 @@ namespace hg {
 template <typename... Ts>
 void HexagonGame::render(Ts&&... xs)
 {
+    ++frameDrawCalls;
+
+    if (drawTrace != nullptr)
+    {
+        drawTrace->recordDraw(xs...);
+    }
+
     if (window == nullptr)
     {
+        if (drawTrace != nullptr)
+        {
+            return;
+        }
+
         ssvu::lo("hg::HexagonGame::render")
             << "Attempted to render without a game window\n";
 
@@ -51,37 +74,32 @@ void HexagonGame::render(Ts&&... xs)
 
 void HexagonGame::draw()
 {
-    if (window == nullptr || Config::getDisableGameRendering())
+    if ((window == nullptr && drawTrace == nullptr) ||
+        Config::getDisableGameRendering())
     {
         return;
     }
 
-    const auto getRenderStates = [this](
-                                     const RenderStage rs) -> sf::RenderStates
-    {
-        if (!Config::getShaders())
-        {
-            return sf::RenderStates::Default;
-        }
+    SSVOH_PROFILE_SCOPE(tickProfiler, Draw);
 
-        const sf::base::Optional<std::size_t> fragmentShaderId =
-            status.fragmentShaderIds[static_cast<std::size_t>(rs)];
-
-        if (!fragmentShaderId.hasValue())
-        {
-            return sf::RenderStates::Default;
-        }
+    if (!isSimulationThreaded())
+    {
+        buildRenderSnapshot(renderSnapshot);
+        drawRenderSnapshot(renderSnapshot);
+        return;
+    }
 
-        runLuaFunctionIfExists<int, float>(
-            "onRenderStage", static_cast<int>(rs), 60.f / window->getFPS());
-        return sf::RenderStates{assets.getShaderByShaderId(*fragmentShaderId)};
-    };
+    // The simulation thread publishes a new snapshot after every tick, the
+    // last one is drawn again if no tick happened since the previous frame.
+    (void)renderSnapshots.consume();
+    drawRenderSnapshot(renderSnapshots.getReadBuffer());
+}
 
+void HexagonGame::buildRenderSnapshot(RenderSnapshot& snapshot)
+{
     SSVOH_ASSERT(backgroundCamera.hasValue());
     SSVOH_ASSERT(overlayCamera.hasValue());
 
-    window->clear(sf::Color::Black);
-
     if (!status.hasDied)
     {
         if (levelStatus.cameraShake > 0.f)
@@ -104,58 +122,65 @@ void HexagonGame::draw()
         }
     }
 
+    snapshot.backgroundView.emplace(backgroundCamera->apply());
+    snapshot.backgroundTris.clear();
+
     if (!Config::getNoBackground())
     {
-        window->setView(backgroundCamera->apply());
+        SSVOH_PROFILE_SCOPE(tickProfiler, DrawBackground);
 
-        backgroundTris.clear();
-
-        styleData.drawBackground(backgroundTris, sf::Vector2f::Zero,
+        styleData.drawBackground(snapshot.backgroundTris, sf::Vector2f::Zero,
             levelStatus.sides,
             Config::getDarkenUnevenBackgroundChunk() &&
                 levelStatus.darkenUnevenBackgroundChunk,
             Config::getBlackAndWhite());
-
-        render(backgroundTris, getRenderStates(RenderStage::BackgroundTris));
     }
 
-    window->setView(backgroundCamera->apply());
+    Utils::FastVertexVectorTris& wallQuads = snapshot.wallQuads;
+    Utils::FastVertexVectorTris& pivotQuads = snapshot.pivotQuads;
+    Utils::FastVertexVectorTris& playerTris = snapshot.playerTris;
+    std::vector<Utils::Layer3D>& layers3D = snapshot.layers3D;
 
-    wallQuads3D.clear();
-    pivotQuads3D.clear();
-    playerTris3D.clear();
-    wallQuads.clear();
-    pivotQuads.clear();
-    playerTris.clear();
-    capTris.clear();
+    {
+        SSVOH_PROFILE_SCOPE(tickProfiler, DrawGeometry);
 
-    // Reserve right amount of memory for all walls and custom walls
-    wallQuads.reserve_more_quad(walls.size() + cwManager.count());
+        snapshot.wallQuads3D.clear();
+        snapshot.pivotQuads3D.clear();
+        snapshot.playerTris3D.clear();
+        layers3D.clear();
+        wallQuads.clear();
+        pivotQuads.clear();
+        playerTris.clear();
+        snapshot.capTris.clear();
 
-    for (CWall& w : walls)
-    {
-        w.draw(getColorWall(), wallQuads);
-    }
+        // Reserve right amount of memory for all walls and custom walls
+        wallQuads.reserve_more_quad(walls.size() + cwManager.count());
+
+        for (CWall& w : walls)
+        {
+            w.draw(getColorWall(), wallQuads);
+        }
 
-    cwManager.draw(wallQuads);
+        cwManager.draw(wallQuads);
 
-    if (status.started)
-    {
-        player.draw(getSides(), getColorMain(), getColorPlayer(), pivotQuads,
-            capTris, playerTris, getColorCap(), Config::getAngleTiltIntensity(),
-            Config::getShowSwapBlinkingEffect());
+        if (status.started)
+        {
+            player.draw(getSides(), getColorMain(), getColorPlayer(),
+                pivotQuads, snapshot.capTris, playerTris, getColorCap(),
+                Config::getAngleTiltIntensity(),
+                Config::getShowSwapBlinkingEffect());
+        }
     }
 
+    snapshot.layers3DWithShader = canDrawLayers3DWithShader();
+
     if (Config::get3D())
     {
+        SSVOH_PROFILE_SCOPE(tickProfiler, Draw3D);
+
         const float depth(styleData._3dDepth);
-        const std::size_t numWallQuads(wallQuads.size());
-        const std::size_t numPivotQuads(pivotQuads.size());
-        const std::size_t numPlayerTris(playerTris.size());
 
-        wallQuads3D.reserve(numWallQuads * depth);
-        pivotQuads3D.reserve(numPivotQuads * depth);
-        playerTris3D.reserve(numPlayerTris * depth);
+        layers3D.reserve(static_cast<std::size_t>(depth));
 
         const float pulse3D{Config::getNoPulse() ? 1.f : status.pulse3D};
         const float effect{
@@ -169,13 +194,6 @@ void HexagonGame::draw()
         const float sinRot(std::sin(radRot));
         const float cosRot(std::cos(radRot));
 
-        for (std::size_t i = 0; i < depth; ++i)
-        {
-            wallQuads3D.unsafe_emplace_other(wallQuads);
-            pivotQuads3D.unsafe_emplace_other(pivotQuads);
-            playerTris3D.unsafe_emplace_other(playerTris);
-        }
-
         const auto adjustAlpha = [&](sf::Color& c, const float i)
         {
             if (styleData._3dAlphaMult == 0.f)
@@ -198,7 +216,8 @@ void HexagonGame::draw()
                                (float(i + 1.f) * styleData._3dPerspectiveMult) *
                                (effect * 3.6f) * 1.4f);
 
-            const sf::Vector2f newPos(offset * cosRot, offset * sinRot);
+            Utils::Layer3D& layer = layers3D.emplace_back();
+            layer.offset = sf::Vector2f{offset * cosRot, offset * sinRot};
 
             sf::Color overrideColor;
 
@@ -215,13 +234,7 @@ void HexagonGame::draw()
             }
             adjustAlpha(overrideColor, i);
 
-            // Draw pivot layers
-            for (std::size_t k = j * numPivotQuads; k < (j + 1) * numPivotQuads;
-                 ++k)
-            {
-                pivotQuads3D[k].position += newPos;
-                pivotQuads3D[k].color = overrideColor;
-            }
+            layer.pivotColor = overrideColor;
 
             if (styleData.get3DOverrideColor() == styleData.getMainColor())
             {
@@ -231,13 +244,7 @@ void HexagonGame::draw()
                 adjustAlpha(overrideColor, i);
             }
 
-            // Draw wall layers
-            for (std::size_t k = j * numWallQuads; k < (j + 1) * numWallQuads;
-                 ++k)
-            {
-                wallQuads3D[k].position += newPos;
-                wallQuads3D[k].color = overrideColor;
-            }
+            layer.wallColor = overrideColor;
 
             // Apply player color if no 3D override is present.
             if (styleData.get3DOverrideColor() == styleData.getMainColor())
@@ -248,60 +255,205 @@ void HexagonGame::draw()
                 adjustAlpha(overrideColor, i);
             }
 
-            // Draw player layers
-            for (std::size_t k = j * numPlayerTris; k < (j + 1) * numPlayerTris;
-                 ++k)
-            {
-                playerTris3D[k].position += newPos;
-                playerTris3D[k].color = overrideColor;
-            }
+            layer.playerColor = overrideColor;
+        }
+
+        if (!snapshot.layers3DWithShader)
+        {
+            Utils::emitLayers3D(snapshot.wallQuads3D, wallQuads, layers3D,
+                &Utils::Layer3D::wallColor);
+
+            Utils::emitLayers3D(snapshot.pivotQuads3D, pivotQuads, layers3D,
+                &Utils::Layer3D::pivotColor);
+
+            Utils::emitLayers3D(snapshot.playerTris3D, playerTris, layers3D,
+                &Utils::Layer3D::playerColor);
         }
     }
 
-    render(wallQuads3D, getRenderStates(RenderStage::WallQuads3D));
-    render(pivotQuads3D, getRenderStates(RenderStage::PivotQuads3D));
-    render(playerTris3D, getRenderStates(RenderStage::PlayerTris3D));
+    emitParticles(snapshot);
 
-    if (Config::getShowPlayerTrail() && status.showPlayerTrail)
+    snapshot.overlayView.emplace(overlayCamera->apply());
+
+    snapshot.flashPolygon.clear();
+    snapshot.flashPolygon.reserve(flashPolygon.size());
+    snapshot.flashPolygon.unsafe_emplace_other(flashPolygon);
+}
+
+void HexagonGame::drawRenderSnapshot(const RenderSnapshot& snapshot)
+{
+    frameDrawCalls = 0;
+
+    if (drawTrace != nullptr)
     {
-        drawTrailParticles();
+        drawTrace->beginFrame();
     }
 
-    if (Config::getShowSwapParticles())
+    const float fpsFactor = window != nullptr ? 60.f / window->getFPS() : 1.f;
+
+    const auto setView = [this](const sf::View& view)
+    {
+        if (window != nullptr)
+        {
+            window->setView(view);
+        }
+    };
+
+    // Shaders are driven by Lua, which is only available on the window thread
+    // when the simulation is not threaded.
+    const bool shadersEnabled =
+        Config::getShaders() && !isSimulationThreaded();
+
+    // Levels defining `onRenderStages` set up the uniforms of all the render
+    // stages with a single call per frame, instead of one `onRenderStage`
+    // call per stage.
+    const bool renderStagesBatched =
+        shadersEnabled &&
+        std::any_of(status.fragmentShaderIds.begin(),
+            status.fragmentShaderIds.end(),
+            [](const sf::base::Optional<std::size_t>& id)
+            { return id.hasValue(); }) &&
+        lua.doesVariableExist("onRenderStages");
+
+    if (renderStagesBatched)
     {
-        drawSwapParticles();
+        runVoidLuaFunctionIfExists("onRenderStages", fpsFactor);
     }
 
-    render(wallQuads, getRenderStates(RenderStage::WallQuads));
-    render(capTris, getRenderStates(RenderStage::CapTris));
-    render(pivotQuads, getRenderStates(RenderStage::PivotQuads));
-    render(playerTris, getRenderStates(RenderStage::PlayerTris));
+    const auto getRenderStates = [this, fpsFactor, shadersEnabled,
+                                     renderStagesBatched](
+                                     const RenderStage rs) -> sf::RenderStates
+    {
+        if (!shadersEnabled)
+        {
+            return sf::RenderStates::Default;
+        }
 
-    window->setView(overlayCamera->apply());
+        const sf::base::Optional<std::size_t> fragmentShaderId =
+            status.fragmentShaderIds[static_cast<std::size_t>(rs)];
 
-    drawParticles();
-    drawText(getRenderStates(RenderStage::Text));
+        if (!fragmentShaderId.hasValue())
+        {
+            return sf::RenderStates::Default;
+        }
 
-    // ------------------------------------------------------------------------
-    // Draw key icons.
-    if (Config::getShowKeyIcons() || mustShowReplayUI())
+        if (!renderStagesBatched)
+        {
+            runLuaFunctionIfExists<int, float>(
+                "onRenderStage", static_cast<int>(rs), fpsFactor);
+        }
+
+        return sf::RenderStates{assets.getShaderByShaderId(*fragmentShaderId)};
+    };
+
+    if (window != nullptr)
     {
-        drawKeyIcons();
+        window->clear(sf::Color::Black);
     }
 
-    // ------------------------------------------------------------------------
-    // Draw level info.
-    if (Config::getShowLevelInfo() || mustShowReplayUI())
+    if (snapshot.backgroundView.hasValue())
     {
-        drawLevelInfo(getRenderStates(RenderStage::Text));
+        SSVOH_ASSERT(snapshot.overlayView.hasValue());
+
+        setView(*snapshot.backgroundView);
+
+        {
+            SSVOH_PROFILE_SCOPE(tickProfiler, DrawRender);
+
+            if (!Config::getNoBackground())
+            {
+                render(snapshot.backgroundTris,
+                    getRenderStates(RenderStage::BackgroundTris));
+            }
+
+            if (!snapshot.layers3D.empty() && snapshot.layers3DWithShader)
+            {
+                drawLayers3DWithShader(snapshot.wallQuads, snapshot.layers3D,
+                    &Utils::Layer3D::wallColor);
+
+                drawLayers3DWithShader(snapshot.pivotQuads, snapshot.layers3D,
+                    &Utils::Layer3D::pivotColor);
+
+                drawLayers3DWithShader(snapshot.playerTris, snapshot.layers3D,
+                    &Utils::Layer3D::playerColor);
+            }
+            else
+            {
+                render(snapshot.wallQuads3D,
+                    getRenderStates(RenderStage::WallQuads3D));
+                render(snapshot.pivotQuads3D,
+                    getRenderStates(RenderStage::PivotQuads3D));
+                render(snapshot.playerTris3D,
+                    getRenderStates(RenderStage::PlayerTris3D));
+            }
+
+            drawPlayerParticles(snapshot);
+
+            render(
+                snapshot.wallQuads, getRenderStates(RenderStage::WallQuads));
+            render(snapshot.capTris, getRenderStates(RenderStage::CapTris));
+            render(
+                snapshot.pivotQuads, getRenderStates(RenderStage::PivotQuads));
+            render(
+                snapshot.playerTris, getRenderStates(RenderStage::PlayerTris));
+        }
+
+        setView(*snapshot.overlayView);
+
+        drawParticles(snapshot);
+    }
+
+    {
+        // The text, key icons and level info are laid out from the game state
+        // on the window thread, in between simulation ticks.
+        const std::unique_lock<std::mutex> lock = lockSimulation();
+
+        if (isSimulationThreaded())
+        {
+            if (!debugPause)
+            {
+                if (Config::getShowKeyIcons() || mustShowReplayUI())
+                {
+                    updateKeyIcons();
+                }
+
+                if (Config::getShowLevelInfo() || mustShowReplayUI())
+                {
+                    updateLevelInfo();
+                }
+            }
+
+            updateText(fpsFactor);
+        }
+
+        {
+            SSVOH_PROFILE_SCOPE(tickProfiler, DrawText);
+            drawText(getRenderStates(RenderStage::Text));
+        }
+
+        // --------------------------------------------------------------------
+        // Draw key icons.
+        if (Config::getShowKeyIcons() || mustShowReplayUI())
+        {
+            drawKeyIcons();
+        }
+
+        // --------------------------------------------------------------------
+        // Draw level info.
+        if (Config::getShowLevelInfo() || mustShowReplayUI())
+        {
+            drawLevelInfo(getRenderStates(RenderStage::Text));
+        }
     }
 
     // ------------------------------------------------------------------------
     if (Config::getFlash())
     {
-        render(flashPolygon);
+        render(snapshot.flashPolygon);
     }
 
+    lastFrameDrawCalls = frameDrawCalls;
+
     if (mustTakeScreenshot)
     {
         if (window != nullptr)
@@ -358,6 +510,12 @@ void HexagonGame::initFlashEffect(int r, int g, int b)
 
 void HexagonGame::drawKeyIcons()
 {
+    if (txKeyIconLeft == nullptr)
+    {
+        // Textures are not loaded when drawing without a window.
+        return;
+    }
+
     constexpr std::uint8_t offOpacity = 90;
     constexpr std::uint8_t onOpacity = 255;
 
@@ -399,27 +557,157 @@ void HexagonGame::drawLevelInfo(const sf::RenderStates& mStates)
     }
 }
 
-void HexagonGame::drawParticles()
+void HexagonGame::emitParticles(RenderSnapshot& snapshot)
 {
-    for (Particle& p : particles)
+    snapshot.starParticleTris.clear();
+    snapshot.smallCircleParticleTris.clear();
+
+    if (!particles.empty() && txStarParticle != nullptr)
     {
-        render(p.sprite, *txStarParticle);
+        particles.emitQuads(snapshot.starParticleTris,
+            txStarParticle->getRect(), sf::Vector2f::Zero);
+    }
+
+    if (txSmallCircle == nullptr)
+    {
+        return;
+    }
+
+    const sf::FloatRect textureRect = txSmallCircle->getRect();
+    const sf::Vector2f origin =
+        txSmallCircle->getSize().to<sf::Vector2f>() / 2.f;
+
+    if (Config::getShowPlayerTrail() && status.showPlayerTrail)
+    {
+        trailParticles.emitQuads(
+            snapshot.smallCircleParticleTris, textureRect, origin);
+    }
+
+    if (Config::getShowSwapParticles())
+    {
+        swapParticles.emitQuads(
+            snapshot.smallCircleParticleTris, textureRect, origin);
     }
 }
 
-void HexagonGame::drawTrailParticles()
+void HexagonGame::drawParticles(const RenderSnapshot& snapshot)
 {
-    for (TrailParticle& p : trailParticles)
+    if (snapshot.starParticleTris.size() == 0)
     {
-        render(p.sprite, *txSmallCircle);
+        return;
     }
+
+    sf::RenderStates states;
+    states.texture = txStarParticle;
+
+    render(snapshot.starParticleTris, states);
 }
 
-void HexagonGame::drawSwapParticles()
+void HexagonGame::drawPlayerParticles(const RenderSnapshot& snapshot)
 {
-    for (SwapParticle& p : swapParticles)
+    if (snapshot.smallCircleParticleTris.size() == 0)
     {
-        render(p.sprite, *txSmallCircle);
+        return;
+    }
+
+    sf::RenderStates states;
+    states.texture = txSmallCircle;
+
+    render(snapshot.smallCircleParticleTris, states);
+}
+
+void HexagonGame::loadLayer3DShader()
+{
+    SSVOH_ASSERT(graphicsContext != nullptr);
+
+    // Replaces the color of the flat geometry with the color of the layer.
+    // Like the shaders of the packs, it has no `#version` directive and only
+    // a fragment stage, so that SFML's own vertex stage is used.
+    constexpr const char* layer3DFragmentShader = R"(uniform vec4 u_layerColor;
+
+void main() {
+    gl_FragColor = u_layerColor;
+}
+)";
+
+    layer3DShader = sf::Shader::loadFromMemory(
+        *graphicsContext, layer3DFragmentShader, sf::Shader::Type::Fragment);
+
+    if (!layer3DShader.hasValue())
+    {
+        ssvu::lo("hg::HexagonGame::loadLayer3DShader")
+            << "Failed to load the 3D layer shader, falling back to CPU "
+               "layers\n";
+
+        return;
+    }
+
+    const auto location = layer3DShader->getUniformLocation("u_layerColor");
+
+    if (!location.hasValue())
+    {
+        ssvu::lo("hg::HexagonGame::loadLayer3DShader")
+            << "Missing 3D layer color uniform, falling back to CPU layers\n";
+
+        layer3DShader.reset();
+        return;
+    }
+
+    layer3DColorLocation = *location;
+}
+
+[[nodiscard]] bool HexagonGame::canDrawLayers3DWithShader() const
+{
+    if (!layer3DShader.hasValue())
+    {
+        return false;
+    }
+
+    if (!Config::getShaders())
+    {
+        return false;
+    }
+
+    // Custom shaders of the 3D render stages expect the layers to be emitted
+    // as a single vertex array.
+    for (const RenderStage rs : {RenderStage::WallQuads3D,
+             RenderStage::PivotQuads3D, RenderStage::PlayerTris3D})
+    {
+        if (status.fragmentShaderIds[static_cast<std::size_t>(rs)].hasValue())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void HexagonGame::drawLayers3DWithShader(
+    const Utils::FastVertexVectorTris& base,
+    const std::vector<Utils::Layer3D>& layers3D,
+    sf::Color Utils::Layer3D::*layerColor)
+{
+    SSVOH_ASSERT(layer3DShader.hasValue());
+
+    if (base.size() == 0)
+    {
+        return;
+    }
+
+    sf::RenderStates states;
+    states.shader = &*layer3DShader;
+
+    for (const Utils::Layer3D& layer : layers3D)
+    {
+        const sf::Color& c = layer.*layerColor;
+
+        layer3DShader->setUniform(layer3DColorLocation,
+            sf::Glsl::Vec4{c.r / 255.f, c.g / 255.f, c.b / 255.f, c.a / 255.f});
+
+        states.transform = sf::Transform::Identity;
+        states.transform.translate(layer.offset);
+
+        render(base, states);
     }
 }
 
@@ -504,6 +792,8 @@ void HexagonGame::updateText(float mFT)
         const auto& trackedVariables(levelStatus.trackedVariables);
         if (Config::getShowTrackedVariables() && !trackedVariables.empty())
         {
+            const std::unique_lock<std::recursive_mutex> luaLock = lockLua();
+
             os << '\n';
             for (const auto& [variableName, display] : trackedVariables)
             {
@@ -512,11 +802,15 @@ void HexagonGame::updateText(float mFT)
                     continue;
                 }
 
-                const std::string value{
-                    lua.readVariable<std::string>(variableName)};
+                std::string value{lua.readVariable<std::string>(variableName)};
+                Utils::uppercasify(value);
+
+                for (const char c : display)
+                {
+                    os.put(static_cast<char>(std::toupper(c)));
+                }
 
-                os << Utils::toUppercase(display) << ": "
-                   << Utils::toUppercase(value) << '\n';
+                os << ": " << value << '\n';
             }
         }
     }
@@ -528,23 +822,31 @@ void HexagonGame::updateText(float mFT)
 
     os.flush();
 
+    // Strings are only converted and set into their text when they change,
+    // so that the text is not re-laid out every frame.
+    const auto setStringIfChanged =
+        [](sf::Text& text, std::string& current, const std::string_view str)
+    {
+        if (current != str)
+        {
+            current = str;
+            text.setString(current);
+        }
+    };
+
     // Set in game timer text
     if (!levelStatus.scoreOverridden)
     {
         // By default, use the timer for scoring
-        if (status.started)
-        {
-            textUI->timeText.setString(formatTime(status.getTimeSeconds()));
-        }
-        else
-        {
-            textUI->timeText.setString("0");
-        }
+        setStringIfChanged(textUI->timeText, textUI->timeTextString,
+            status.started ? formatTime(status.getTimeSeconds()) : "0");
     }
     else
     {
         // Alternative scoring
-        textUI->timeText.setString(
+        const std::unique_lock<std::recursive_mutex> luaLock = lockLua();
+
+        setStringIfChanged(textUI->timeText, textUI->timeTextString,
             lua.readVariable<std::string>(levelStatus.scoreOverride));
     }
 
@@ -557,7 +859,7 @@ void HexagonGame::updateText(float mFT)
     textUI->timeText.setCharacterSize(getScaledCharacterSize(70.f));
 
     // Set information text
-    textUI->text.setString(os.str());
+    setStringIfChanged(textUI->text, textUI->textString, os.view());
     textUI->text.setCharacterSize(getScaledCharacterSize(20.f));
     textUI->text.setOrigin({0.f, 0.f});
 
@@ -741,6 +1043,11 @@ void HexagonGame::drawText_PersonalBest(
 
 void HexagonGame::drawText(const sf::RenderStates& mStates)
 {
+    if (!textUI.hasValue())
+    {
+        return;
+    }
+
     const sf::Color offsetColor{
         Config::getBlackAndWhite() || styleData.getColors().empty()
             ? sf::Color::Black
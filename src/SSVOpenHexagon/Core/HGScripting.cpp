@@ -21,6 +21,7 @@
 #include "SSVOpenHexagon/Global/Macros.hpp"
 
 #include "SSVOpenHexagon/Utils/Concat.hpp"
+#include "SSVOpenHexagon/Utils/LuaBindingProfiler.hpp"
 #include "SSVOpenHexagon/Utils/LuaMetadata.hpp"
 #include "SSVOpenHexagon/Utils/LuaMetadataProxy.hpp"
 #include "SSVOpenHexagon/Utils/ScopeGuard.hpp"
@@ -35,6 +36,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <cmath>
 
@@ -45,7 +47,11 @@ Utils::LuaMetadataProxy addLuaFn(
     Lua::LuaContext& lua, const std::string& name, F&& f)
 {
     // TODO (P2): reduce instantiations by using captureless lambdas
+#ifdef SSVOH_ENABLE_LUA_BINDING_PROFILER
+    lua.writeVariable(name, Utils::makeProfiledLuaBinding(name, SSVOH_FWD(f)));
+#else
     lua.writeVariable(name, SSVOH_FWD(f));
+#endif
     return Utils::LuaMetadataProxy{
         Utils::TypeWrapper<F>{}, LuaScripting::getMetadata(), name};
 }
@@ -313,9 +319,10 @@ static void waitUntilSImpl(const double mDuration,
 void HexagonGame::initLua_MainTimeline()
 {
     addLuaFn(lua, "t_eval",
-        [this](const std::string& mCode) {
-            timeline.append_do(
-                [this, mCode] { Utils::runLuaCode(lua, mCode); });
+        [this](const std::string_view mCode)
+        {
+            timeline.append_do([this, code = internLuaCode(mCode)]
+                { Utils::runLuaCode(lua, *code); });
         })
         .arg("code")
         .doc(
@@ -354,9 +361,10 @@ void HexagonGame::initLua_MainTimeline()
 void HexagonGame::initLua_EventTimeline()
 {
     addLuaFn(lua, "e_eval",
-        [this](const std::string& mCode) {
-            eventTimeline.append_do(
-                [=, this] { Utils::runLuaCode(lua, mCode); });
+        [this](const std::string_view mCode)
+        {
+            eventTimeline.append_do([this, code = internLuaCode(mCode)]
+                { Utils::runLuaCode(lua, *code); });
         })
         .arg("code")
         .doc(
@@ -485,7 +493,8 @@ void HexagonGame::initLua_CustomTimelines()
     };
 
     addLuaFn(lua, "ct_eval",
-        [checkHandle, this](CustomTimelineHandle cth, const std::string& mCode)
+        [checkHandle, this](
+            CustomTimelineHandle cth, const std::string_view mCode)
         {
             if (!checkHandle(cth, "ct_eval"))
             {
@@ -493,7 +502,8 @@ void HexagonGame::initLua_CustomTimelines()
             }
 
             _customTimelineManager.get(cth)._timeline.append_do(
-                [this, mCode] { Utils::runLuaCode(lua, mCode); });
+                [this, code = internLuaCode(mCode)]
+                { Utils::runLuaCode(lua, *code); });
         })
         .arg("handle")
         .arg("code")
@@ -1116,7 +1126,8 @@ void HexagonGame::initLua()
         { runLuaFile(filename); }, execScriptPackPathContext,
         [this]() -> const std::string& { return levelData->packPath; },
         [this]() -> const PackData& { return getPackData(); },
-        (window == nullptr) /* headless */);
+        (window == nullptr) /* headless */,
+        isSimulationThreaded() /* shadersDisabled */);
 
     initLua_Utils();
     initLua_AudioControl();
@@ -5,6 +5,7 @@
 #include "SSVOpenHexagon/Core/HGStatus.hpp"
 
 #include "SSVOpenHexagon/Utils/Clock.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 
 #include <chrono>
 
@@ -54,7 +55,7 @@ void HexagonGameStatus::start() noexcept
 
 void HexagonGameStatus::pauseTime(const double seconds) noexcept
 {
-    currentPause += seconds * 60.0;
+    currentPause = Utils::Strict::mulAdd(seconds, 60.0, currentPause);
 }
 
 void HexagonGameStatus::resetIncrementTime() noexcept
@@ -15,10 +15,12 @@
 
 #include "SSVOpenHexagon/Utils/Clock.hpp"
 #include "SSVOpenHexagon/Utils/Concat.hpp"
+#include "SSVOpenHexagon/Utils/LuaBindingProfiler.hpp"
 #include "SSVOpenHexagon/Utils/Easing.hpp"
 #include "SSVOpenHexagon/Utils/Math.hpp"
 #include "SSVOpenHexagon/Utils/MoveTowards.hpp"
 #include "SSVOpenHexagon/Utils/Split.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 #include "SSVOpenHexagon/Utils/String.hpp"
 
 #include "SSVOpenHexagon/Core/Discord.hpp"
@@ -26,6 +28,7 @@
 #include "SSVOpenHexagon/Core/Joystick.hpp"
 #include "SSVOpenHexagon/Core/LuaScripting.hpp"
 #include "SSVOpenHexagon/Core/Steam.hpp"
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
 
 #include <SSVUtils/Core/Utils/Rnd.hpp>
 #include <SSVUtils/Core/Common/Frametime.hpp>
@@ -40,6 +43,8 @@
 #include <SFML/System/Vector2.hpp>
 
 #include <SFML/Base/Optional.hpp>
+#include <chrono>
+#include <mutex>
 #include <stdexcept>
 
 #include <cstring>
@@ -123,12 +128,7 @@ void HexagonGame::update(float mFT, const float timescale)
         return;
     }
 
-    // ------------------------------------------------------------------------
-    // Update client
-    if (hexagonClient != nullptr)
-    {
-        hexagonClient->update();
-    }
+    SSVOH_PROFILE_SCOPE(tickProfiler, Update);
 
     // ------------------------------------------------------------------------
     // Scale simulation delta frame time
@@ -138,29 +138,9 @@ void HexagonGame::update(float mFT, const float timescale)
     // Update Discord and Steam "rich presence".
     // Discord "rich presence" is also updated in `HexagonGame::start`.
 
-    if (window != nullptr)
+    if (window != nullptr && !onSimulationThread())
     {
-        std::string nameStr = levelData->name;
-        nameFormat(nameStr);
-
-        const std::string diffStr = diffFormat(difficultyMult);
-        const std::string timeStr = timeFormat(status.getTimeSeconds());
-
-        constexpr float DELAY_TO_UPDATE = 5.f; // X seconds
-        timeUntilRichPresenceUpdate -= ssvu::getFTToSeconds(mFT);
-
-        if (timeUntilRichPresenceUpdate <= 0.f)
-        {
-            if (steamManager != nullptr)
-            {
-                steamManager->set_rich_presence_in_game(
-                    nameStr, diffStr, timeStr);
-            }
-
-            timeUntilRichPresenceUpdate = DELAY_TO_UPDATE;
-        }
-
-        updateRichPresenceCallbacks();
+        updateRichPresence(mFT);
     }
 
     // ------------------------------------------------------------------------
@@ -185,7 +165,8 @@ void HexagonGame::update(float mFT, const float timescale)
 
             if (!status.started)
             {
-                if (window != nullptr && window->hasTimer())
+                if (window != nullptr && window->hasTimer() &&
+                    !onSimulationThread())
                 {
                     // This avoids initial speedup when viewing replays.
                     window->getTimerBase().reset();
@@ -217,17 +198,19 @@ void HexagonGame::update(float mFT, const float timescale)
         }
 
         // --------------------------------------------------------------------
-        // Update key icons.
-        if (Config::getShowKeyIcons() || mustShowReplayUI())
+        // Update key icons and level info. With a threaded simulation, they
+        // are updated by `draw` instead.
+        if (!onSimulationThread())
         {
-            updateKeyIcons();
-        }
+            if (Config::getShowKeyIcons() || mustShowReplayUI())
+            {
+                updateKeyIcons();
+            }
 
-        // --------------------------------------------------------------------
-        // Update level info.
-        if (Config::getShowLevelInfo() || mustShowReplayUI())
-        {
-            updateLevelInfo();
+            if (Config::getShowLevelInfo() || mustShowReplayUI())
+            {
+                updateLevelInfo();
+            }
         }
 
         // --------------------------------------------------------------------
@@ -362,6 +345,8 @@ void HexagonGame::update(float mFT, const float timescale)
                 rng.advance(fixup(status.flashEffect));
                 rng.advance(fixup(levelStatus.rotationSpeed));
                 // TODO (P1): stuff from style?
+
+                updateStateHashes();
             }
         }
 
@@ -387,27 +372,18 @@ void HexagonGame::update(float mFT, const float timescale)
         }
     }
 
-    updateText(mFT);
+    // With a threaded simulation, the text is updated by `draw` and state
+    // changes are carried out on the window thread by `updateSimulationThread`.
+    if (!onSimulationThread())
+    {
+        updateText(mFT);
+    }
 
     if (status.started)
     {
-        if (status.mustStateChange != StateChange::None)
+        if (!onSimulationThread() && !updateStateChange())
         {
-            const bool executeLastReplay =
-                status.mustStateChange == StateChange::MustReplay;
-
-            if (!executeLastReplay && !assets.anyLocalProfileActive())
-            {
-                // If playing a replay from file, there is no local profile
-                // active, so just go to the menu when attempting to restart
-                // the level.
-
-                goToMenu();
-                return;
-            }
-
-            newGame(getPackId(), restartId, restartFirstTime, difficultyMult,
-                executeLastReplay);
+            return;
         }
 
 // TODO (P2): score invalidation due to performance
@@ -423,17 +399,72 @@ void HexagonGame::update(float mFT, const float timescale)
             invalidateScore("3D REQUIRED");
         }
 
-        if (!Config::getShaders() && levelStatus.shadersRequired)
+        // Level shaders are not available with a threaded simulation.
+        if ((!Config::getShaders() || isSimulationThreaded()) &&
+            levelStatus.shadersRequired)
         {
             invalidateScore("SHADERS REQUIRED");
         }
     }
 }
 
+[[nodiscard]] bool HexagonGame::updateStateChange()
+{
+    if (status.mustStateChange == StateChange::None)
+    {
+        return true;
+    }
+
+    const bool executeLastReplay =
+        status.mustStateChange == StateChange::MustReplay;
+
+    if (!executeLastReplay && !assets.anyLocalProfileActive())
+    {
+        // If playing a replay from file, there is no local profile active, so
+        // just go to the menu when attempting to restart the level.
+
+        goToMenu();
+        return false;
+    }
+
+    newGame(getPackId(), restartId, restartFirstTime, difficultyMult,
+        executeLastReplay);
+
+    return true;
+}
+
+void HexagonGame::updateRichPresence(const float mFT)
+{
+    constexpr float DELAY_TO_UPDATE = 5.f; // X seconds
+    timeUntilRichPresenceUpdate -= ssvu::getFTToSeconds(mFT);
+
+    if (timeUntilRichPresenceUpdate <= 0.f)
+    {
+        if (steamManager != nullptr)
+        {
+            // Only formatted when needed, to avoid allocating every tick.
+            std::string nameStr = levelData->name;
+            nameFormat(nameStr);
+
+            const std::string diffStr = diffFormat(difficultyMult);
+            const std::string timeStr = timeFormat(status.getTimeSeconds());
+
+            steamManager->set_rich_presence_in_game(nameStr, diffStr, timeStr);
+        }
+
+        timeUntilRichPresenceUpdate = DELAY_TO_UPDATE;
+    }
+
+    updateRichPresenceCallbacks();
+}
+
 void HexagonGame::updateWalls(float mFT)
 {
+    SSVOH_PROFILE_SCOPE(tickProfiler, UpdateWalls);
+
     bool collided{false};
-    const float radiusSquared{status.radius * status.radius + 8.f};
+    const float radiusSquared{
+        Utils::Strict::mulAdd(status.radius, status.radius, 8.f)};
     const sf::Vector2f& pPos{player.getPosition()};
 
     for (CWall& w : walls)
@@ -493,6 +524,8 @@ void HexagonGame::updateWalls(float mFT)
 
 void HexagonGame::updateCustomWalls(float mFT)
 {
+    SSVOH_PROFILE_SCOPE(tickProfiler, UpdateCustomWalls);
+
     if (cwManager.handleCollision(getInputMovement(), getRadius(), player, mFT))
     {
         performPlayerKill();
@@ -685,10 +718,11 @@ void HexagonGame::updateInput()
         inputSwap = std::uniform_int_distribution<int>{0, 1}(en);
         inputFocused = std::uniform_int_distribution<int>{0, 1}(en);
     }
-    else
+    else if (!onSimulationThread())
     {
         // Keyboard and mouse state is handled by callbacks set in the
-        // constructor.
+        // constructor. With a threaded simulation, joystick and touchscreen
+        // state is polled by `updateSimulationThread`.
         updateInput_UpdateJoystickControls(); // Joystick state.
         updateInput_UpdateTouchControls();    // Touchscreen state.
     }
@@ -718,6 +752,7 @@ void HexagonGame::updateEvents(float)
 
 void HexagonGame::updateCustomTimelines()
 {
+    SSVOH_PROFILE_SCOPE(tickProfiler, UpdateCustomTimelines);
     _customTimelineManager.updateAllTimelines(status.getCurrentTP());
 }
 
@@ -746,7 +781,13 @@ void HexagonGame::updateLevel(float mFT)
         return;
     }
 
-    runLuaFunctionIfExists<float>("onUpdate", mFT);
+    {
+        SSVOH_PROFILE_SCOPE(tickProfiler, UpdateLuaOnUpdate);
+        runLuaFunctionIfExists<float>("onUpdate", mFT);
+    }
+
+    // Includes `onStep`, which is triggered by the end of the timeline.
+    SSVOH_PROFILE_SCOPE(tickProfiler, UpdateTimeline);
 
     const auto o = timelineRunner.update(timeline, status.getTimeTP());
 
@@ -772,7 +813,8 @@ void HexagonGame::updatePulse(float mFT)
                                        ? levelStatus.pulseMax
                                        : levelStatus.pulseMin};
 
-            status.pulse += pulseAdd * mFT * getMusicDMSyncFactor();
+            status.pulse = Utils::Strict::mulAdd(
+                pulseAdd * mFT, getMusicDMSyncFactor(), status.pulse);
 
             if ((status.pulseDirection > 0 && status.pulse >= pulseLimit) ||
                 (status.pulseDirection < 0 && status.pulse <= pulseLimit))
@@ -787,7 +829,8 @@ void HexagonGame::updatePulse(float mFT)
             }
         }
 
-        status.pulseDelay -= mFT * getMusicDMSyncFactor();
+        status.pulseDelay = Utils::Strict::mulAdd(
+            -mFT, getMusicDMSyncFactor(), status.pulseDelay);
     }
     refreshPulse();
 }
@@ -821,13 +864,15 @@ void HexagonGame::updateBeatPulse(float mFT)
         }
         else
         {
-            status.beatPulseDelay -= mFT * getMusicDMSyncFactor();
+            status.beatPulseDelay = Utils::Strict::mulAdd(
+                -mFT, getMusicDMSyncFactor(), status.beatPulseDelay);
         }
 
         if (status.beatPulse > 0)
         {
-            status.beatPulse -= (2.f * mFT * getMusicDMSyncFactor()) *
-                                levelStatus.beatPulseSpeedMult;
+            status.beatPulse = Utils::Strict::mulAdd(
+                -2.f * mFT * getMusicDMSyncFactor(),
+                levelStatus.beatPulseSpeedMult, status.beatPulse);
         }
     }
     refreshBeatPulse();
@@ -836,8 +881,8 @@ void HexagonGame::updateBeatPulse(float mFT)
 void HexagonGame::refreshBeatPulse()
 {
     const float radiusMin{Config::getBeatPulse() ? levelStatus.radiusMin : 75};
-    status.radius =
-        radiusMin * (status.pulse / levelStatus.pulseMin) + status.beatPulse;
+    status.radius = Utils::Strict::mulAdd(
+        radiusMin, status.pulse / levelStatus.pulseMin, status.beatPulse);
 }
 
 void HexagonGame::updateRotation(float mFT)
@@ -845,11 +890,12 @@ void HexagonGame::updateRotation(float mFT)
     auto nextRotation(getRotationSpeed() * 10.f);
     if (status.fastSpin > 0)
     {
-        nextRotation += std::abs((Utils::getSmootherStep(0,
-                                      levelStatus.fastSpin, status.fastSpin) /
-                                     3.5f) *
-                                 17.f) *
-                        Utils::getSign(nextRotation);
+        nextRotation = Utils::Strict::mulAdd(
+            std::abs((Utils::getSmootherStep(
+                          0, levelStatus.fastSpin, status.fastSpin) /
+                         3.5f) *
+                     17.f),
+            Utils::getSign(nextRotation), nextRotation);
 
         status.fastSpin -= mFT;
     }
@@ -920,6 +966,8 @@ void HexagonGame::updateFlash(float mFT)
 
 void HexagonGame::updatePulse3D(float mFT)
 {
+    SSVOH_PROFILE_SCOPE(tickProfiler, UpdatePulse3D);
+
     status.pulse3D += styleData._3dPulseSpeed * status.pulse3DDirection * mFT;
     if (status.pulse3D > styleData._3dPulseMax)
     {
@@ -935,10 +983,9 @@ void HexagonGame::updateParticles(float mFT)
 {
     SSVOH_ASSERT(window != nullptr);
 
-    const auto isOutOfBounds = [](const Particle& p)
+    const auto isOutOfBounds = [this](const std::size_t i)
     {
-        const sf::Sprite& sp = p.sprite;
-        const sf::Vector2f& pos = sp.getPosition();
+        const sf::Vector2f& pos = particles.positions()[i];
         constexpr float padding = 256.f;
 
         return (pos.x < 0 - padding || pos.x > Config::getWidth() + padding ||
@@ -947,41 +994,37 @@ void HexagonGame::updateParticles(float mFT)
 
     const auto makePBParticle = [this]
     {
-        SSVOH_ASSERT(txStarParticle != nullptr);
-        Particle p{sf::Sprite{txStarParticle->getRect()}};
-
-        p.sprite.setPosition(
-            {ssvu::getRndR(-64.f, Config::getWidth() + 64.f), -64.f});
-        p.sprite.setRotation(sf::degrees(ssvu::getRndR(0.f, 360.f)));
-
+        const sf::Vector2f position{
+            ssvu::getRndR(-64.f, Config::getWidth() + 64.f), -64.f};
+        const float rotationDeg = ssvu::getRndR(0.f, 360.f);
         const float scale = ssvu::getRndR(0.75f, 1.35f);
-        p.sprite.setScale({scale, scale});
 
         sf::Color c = getColorMain();
         c.a = ssvu::getRndI(90, 145);
-        p.sprite.setColor(c);
-
-        p.velocity = {ssvu::getRndR(-12.f, 12.f), ssvu::getRndR(4.f, 18.f)};
-        p.angularVelocity = ssvu::getRndR(-6.f, 6.f);
 
-        return p;
+        const sf::Vector2f velocity{
+            ssvu::getRndR(-12.f, 12.f), ssvu::getRndR(4.f, 18.f)};
+        const float angularVelocityDeg = ssvu::getRndR(-6.f, 6.f);
+
+        return Utils::ParticleSystem::Particle{
+            .position = position,                     //
+            .velocity = velocity,                     //
+            .rotationDeg = rotationDeg,               //
+            .angularVelocityDeg = angularVelocityDeg, //
+            .scale = scale,                           //
+            .color = c                                //
+        };
     };
 
-    eraseRemoveIf(particles, isOutOfBounds);
-
-    for (Particle& p : particles)
-    {
-        sf::Sprite& sp = p.sprite;
-        sp.setPosition(sp.getPosition() + p.velocity * mFT);
-        sp.setRotation(sp.getRotation() + sf::degrees(p.angularVelocity * mFT));
-    }
+    particles.eraseIf(isOutOfBounds);
+    particles.integrate(mFT);
 
     if (mustSpawnPBParticles)
     {
         nextPBParticleSpawn -= mFT;
         if (nextPBParticleSpawn <= 0.f)
         {
-            particles.emplace_back(makePBParticle());
+            particles.emplace(makePBParticle());
             nextPBParticleSpawn = 2.75f;
         }
     }
@@ -991,51 +1034,53 @@ void HexagonGame::updateTrailParticles(float mFT)
 {
     SSVOH_ASSERT(window != nullptr);
 
-    const auto isDead = [&](const TrailParticle& p)
-    { return p.sprite.getColor().a <= 3; };
+    const auto isDead = [this](const std::size_t i)
+    { return trailParticles.colors()[i].a <= 3; };
 
     const auto makeTrailParticle = [this]
     {
-        SSVOH_ASSERT(txSmallCircle != nullptr);
-        TrailParticle p{sf::Sprite{txSmallCircle->getRect()}};
-
-        p.sprite.setPosition(player.getPosition());
-        p.sprite.setOrigin(txSmallCircle->getSize().to<sf::Vector2f>() / 2.f);
-
-        const float scale = Config::getPlayerTrailScale();
-        p.sprite.setScale({scale, scale});
-
         sf::Color c = getColorPlayerTrail();
-
         c.a = Config::getPlayerTrailAlpha();
-        p.sprite.setColor(c);
-
-        p.angle = player.getPlayerAngle();
 
-        return p;
+        return Utils::ParticleSystem::Particle{
+            .position = player.getPosition(),       //
+            .velocity = {},                         //
+            .rotationDeg = 0.f,                     //
+            .angularVelocityDeg = 0.f,              //
+            .scale = Config::getPlayerTrailScale(), //
+            .color = c                              //
+        };
     };
 
-    eraseRemoveIf(trailParticles, isDead);
+    trailParticles.eraseIf(isDead);
 
-    for (TrailParticle& p : trailParticles)
+    // Trail particles stay on the player's path, in the direction of the
+    // position they were spawned at.
+    const float trailRadius = status.radius + 2.4f;
+
+    for (std::size_t i = 0; i < trailParticles.size(); ++i)
     {
-        sf::Color color = p.sprite.getColor();
+        sf::Color& color = trailParticles.colors()[i];
 
         const float newAlpha = Utils::getMoveTowardsZero(
             static_cast<float>(color.a), Config::getPlayerTrailDecay() * mFT);
 
         color.a = static_cast<std::uint8_t>(newAlpha);
-        p.sprite.setColor(color);
 
-        p.sprite.setScale(p.sprite.getScale() * 0.98f);
+        trailParticles.scales()[i] *= 0.98f;
+
+        sf::Vector2f& pos = trailParticles.positions()[i];
+        const float length = pos.length();
 
-        p.sprite.setPosition(sf::Vector2f::fromAngle(
-            status.radius + 2.4f, sf::radians(p.angle)));
+        if (length > 0.f)
+        {
+            pos *= trailRadius / length;
+        }
     }
 
     if (player.hasChangedAngle())
     {
-        trailParticles.emplace_back(makeTrailParticle());
+        trailParticles.emplace(makeTrailParticle());
     }
 }
 
@@ -1043,78 +1088,73 @@ void HexagonGame::updateSwapParticles(float mFT)
 {
     SSVOH_ASSERT(window != nullptr);
 
-    const auto isDead = [&](const SwapParticle& p)
-    { return p.sprite.getColor().a <= 3; };
+    const auto isDead = [this](const std::size_t i)
+    { return swapParticles.colors()[i].a <= 3; };
 
     const auto makeSwapParticle = [this](const SwapParticleSpawnInfo& si,
                                       const float expand, const float speedMult,
                                       const float scaleMult, const float alpha)
     {
-        SSVOH_ASSERT(txSmallCircle != nullptr);
-        SwapParticle p{sf::Sprite(txSmallCircle->getRect())};
-
-        p.sprite.setPosition(si.position);
-        p.sprite.setOrigin(txSmallCircle->getSize().to<sf::Vector2f>() / 2.f);
-
         const float scale = ssvu::getRndR(0.65f, 1.35f) * scaleMult;
-        p.sprite.setScale({scale, scale});
 
         sf::Color c = getColorPlayerTrail();
-
         c.a = alpha;
-        p.sprite.setColor(c);
 
-        p.velocity =
+        const sf::Vector2f velocity =
             sf::Vector2f::fromAngle(ssvu::getRndR(0.1f, 10.f) * speedMult,
                 sf::radians(si.angle + ssvu::getRndR(-expand, expand)));
 
-        return p;
+        return Utils::ParticleSystem::Particle{
+            .position = si.position,   //
+            .velocity = velocity,      //
+            .rotationDeg = 0.f,        //
+            .angularVelocityDeg = 0.f, //
+            .scale = scale,            //
+            .color = c                 //
+        };
     };
 
-    eraseRemoveIf(swapParticles, isDead);
+    swapParticles.eraseIf(isDead);
 
-    for (SwapParticle& p : swapParticles)
+    for (std::size_t i = 0; i < swapParticles.size(); ++i)
     {
-        sf::Color color = p.sprite.getColor();
+        sf::Color& color = swapParticles.colors()[i];
 
         const float newAlpha =
             Utils::getMoveTowardsZero(static_cast<float>(color.a), 3.5f * mFT);
 
         color.a = static_cast<std::uint8_t>(newAlpha);
-        p.sprite.setColor(color);
 
-        p.sprite.setScale(p.sprite.getScale() * 0.98f);
-        p.sprite.setPosition(p.sprite.getPosition() + p.velocity * mFT);
+        swapParticles.scales()[i] *= 0.98f;
     }
 
+    swapParticles.integrate(mFT);
+
     if (swapParticlesSpawnInfo.hasValue())
     {
         if (swapParticlesSpawnInfo->ready == false)
         {
             for (int i = 0; i < 20; ++i)
             {
-                swapParticles.emplace_back(
-                    makeSwapParticle(*swapParticlesSpawnInfo,
-                        0.45f /* expand */, 1.f /* speedMult */,
-                        1.f /* scaleMult */, 45.f /* alpha */));
+                swapParticles.emplace(makeSwapParticle(*swapParticlesSpawnInfo,
+                    0.45f /* expand */, 1.f /* speedMult */,
+                    1.f /* scaleMult */, 45.f /* alpha */));
             }
 
             for (int i = 0; i < 10; ++i)
             {
-                swapParticles.emplace_back(
-                    makeSwapParticle(*swapParticlesSpawnInfo,
-                        3.14f /* expand */, 0.45f /* speedMult */,
-                        0.75f /* scaleMult */, 35.f /* alpha */));
+                swapParticles.emplace(makeSwapParticle(*swapParticlesSpawnInfo,
+                    3.14f /* expand */, 0.45f /* speedMult */,
+                    0.75f /* scaleMult */, 35.f /* alpha */));
             }
         }
         else
         {
             for (int i = 0; i < 14; ++i)
             {
-                swapParticles.emplace_back(
-                    makeSwapParticle(*swapParticlesSpawnInfo,
-                        3.14f /* expand */, 1.3f /* speedMult */,
-                        0.4f /* scaleMult */, 140.f /* alpha */));
+                swapParticles.emplace(makeSwapParticle(*swapParticlesSpawnInfo,
+                    3.14f /* expand */, 1.3f /* speedMult */,
+                    0.4f /* scaleMult */, 140.f /* alpha */));
             }
         }
 
@@ -1321,6 +1361,8 @@ void HexagonGame::postUpdate_ImguiLuaConsole()
         return;
     }
 
+    const std::unique_lock<std::recursive_mutex> luaLock = lockLua();
+
     ImGui::SFML::Update(*window, ilcDeltaClock.restart());
 
     ImGui::SetNextWindowSize(ImVec2(600, 700), ImGuiCond_FirstUseEver);
@@ -1555,6 +1597,9 @@ void HexagonGame::postUpdate_ImguiLuaConsole()
     ImGui::Text("update ms: %.2f", window->getMsUpdate());
     ImGui::SameLine();
     ImGui::Text("draw ms: %.2f", window->getMsDraw());
+    ImGui::SameLine();
+    ImGui::Text(
+        "draw calls: %u", static_cast<unsigned int>(lastFrameDrawCalls));
 
     static float simSpeed = Config::getTimescale();
     ImGui::DragFloat("Timescale", &simSpeed, 0.005f);
@@ -1566,6 +1611,94 @@ void HexagonGame::postUpdate_ImguiLuaConsole()
     ImGui::Checkbox("Invincible", &invincible);
     Config::setInvincible(invincible);
 
+#ifdef SSVOH_ENABLE_TICK_PROFILER
+    if (ImGui::CollapsingHeader("Tick profiler"))
+    {
+        if (ImGui::BeginTable("TickProfiler", 4))
+        {
+            ImGui::TableSetupColumn("stage");
+            ImGui::TableSetupColumn("min ms");
+            ImGui::TableSetupColumn("avg ms");
+            ImGui::TableSetupColumn("p99 ms");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < tickStageCount; ++i)
+            {
+                const TickStage stage = static_cast<TickStage>(i);
+                const TickProfiler::Stats stats = tickProfiler.getStats(stage);
+
+                ImGui::TableNextRow();
+
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(getTickStageName(stage));
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.3f", stats.minMs);
+
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.3f", stats.avgMs);
+
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.3f", stats.p99Ms);
+            }
+
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Reset"))
+        {
+            tickProfiler.clear();
+        }
+    }
+#endif
+
+#ifdef SSVOH_ENABLE_LUA_BINDING_PROFILER
+    if (ImGui::CollapsingHeader("Lua binding profiler"))
+    {
+        Utils::LuaBindingProfiler& lbp = Utils::getLuaBindingProfiler();
+
+        if (ImGui::BeginTable("LuaBindingProfiler", 4))
+        {
+            ImGui::TableSetupColumn("binding");
+            ImGui::TableSetupColumn("calls");
+            ImGui::TableSetupColumn("total ms");
+            ImGui::TableSetupColumn("avg us");
+            ImGui::TableHeadersRow();
+
+            for (const Utils::LuaBindingProfiler::Entry* entry :
+                lbp.getSortedEntries())
+            {
+                const double totalMs =
+                    std::chrono::duration<double, std::milli>(entry->totalTime)
+                        .count();
+
+                ImGui::TableNextRow();
+
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(entry->name.c_str());
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu",
+                    static_cast<unsigned long long>(entry->calls));
+
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.3f", totalMs);
+
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.3f",
+                    totalMs * 1000.0 / static_cast<double>(entry->calls));
+            }
+
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Reset##LuaBindingProfiler"))
+        {
+            lbp.clear();
+        }
+    }
+#endif
+
     ImGui::Separator();
 
     {
@@ -1657,6 +1790,14 @@ void HexagonGame::postUpdate_ImguiLuaConsole()
 
 void HexagonGame::postUpdate()
 {
+    SSVOH_PROFILE_SCOPE(tickProfiler, PostUpdate);
+
+    // The Lua console lives on the window thread.
+    if (onSimulationThread())
+    {
+        return;
+    }
+
     postUpdate_ImguiLuaConsole();
 }
 
@@ -5,19 +5,21 @@
 #include "SSVOpenHexagon/Core/HexagonClient.hpp"
 
 #include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
 #include "SSVOpenHexagon/Global/Version.hpp"
 #include "SSVOpenHexagon/Core/Replay.hpp"
 #include "SSVOpenHexagon/Utils/Concat.hpp"
 #include "SSVOpenHexagon/Core/Steam.hpp"
 #include "SSVOpenHexagon/Online/Shared.hpp"
 #include "SSVOpenHexagon/Utils/Match.hpp"
-#include "SSVOpenHexagon/Utils/ScopeGuard.hpp"
 #include "SSVOpenHexagon/Online/Sodium.hpp"
 
 #include <SSVUtils/Core/Log/Log.hpp>
 
 #include <SFML/Network/Packet.hpp>
+#include <algorithm>
 
+#include <mutex>
 #include <thread>
 #include <chrono>
 
@@ -168,7 +170,7 @@ template <typename... Ts>
     {
         SSVOH_CLOG_ERROR << "Failure receiving packet from server\n";
 
-        disconnect();
+        disconnectImpl();
         return fail();
     }
 
@@ -176,7 +178,7 @@ template <typename... Ts>
     {
         SSVOH_CLOG_ERROR << "Disconnected while receiving packet from server\n";
 
-        disconnect();
+        disconnectImpl();
         return fail();
     }
 
@@ -302,54 +304,69 @@ template <typename T>
 }
 
 [[nodiscard]] bool HexagonClient::sendRequestTopScores(
-    const std::uint64_t loginToken, const std::string& levelValidator)
+    const std::uint64_t loginToken, const LevelValidatorId levelValidatorId)
 {
     SSVOH_CLOG_VERBOSE << "Sending top scores request to server...\n";
 
     return sendEncrypted( //
         CTSPRequestTopScores{
-            .loginToken = loginToken,        //
-            .levelValidator = levelValidator //
+            .loginToken = loginToken,            //
+            .levelValidatorId = levelValidatorId //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonClient::sendRequestOwnScore(
-    const std::uint64_t loginToken, const std::string& levelValidator)
+    const std::uint64_t loginToken, const LevelValidatorId levelValidatorId)
 {
     SSVOH_CLOG_VERBOSE << "Sending own score request to server...\n";
 
     return sendEncrypted( //
         CTSPRequestOwnScore{
-            .loginToken = loginToken,        //
-            .levelValidator = levelValidator //
+            .loginToken = loginToken,            //
+            .levelValidatorId = levelValidatorId //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonClient::sendRequestTopScoresAndOwnScore(
-    const std::uint64_t loginToken, const std::string& levelValidator)
+    const std::uint64_t loginToken, const LevelValidatorId levelValidatorId)
 {
     SSVOH_CLOG_VERBOSE
         << "Sending top scores and own score request to server...\n";
 
     return sendEncrypted( //
         CTSPRequestTopScoresAndOwnScore{
+            .loginToken = loginToken,            //
+            .levelValidatorId = levelValidatorId //
+        } //
+    );
+}
+
+[[nodiscard]] bool HexagonClient::sendRequestTopScoresAndOwnScoreBatch(
+    const std::uint64_t loginToken,
+    const std::vector<CachedLeaderboardVersion>& cachedVersions)
+{
+    SSVOH_CLOG_VERBOSE << "Sending top scores and own score request for '"
+                       << cachedVersions.size() << "' levels to server...\n";
+
+    return sendEncrypted( //
+        CTSPRequestTopScoresAndOwnScoreBatch{
             .loginToken = loginToken,        //
-            .levelValidator = levelValidator //
+            .cachedVersions = cachedVersions //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonClient::sendStartedGame(
-    const std::uint64_t loginToken, const std::string& levelValidator)
+    const std::uint64_t loginToken, const LevelValidatorId levelValidatorId)
 {
     SSVOH_CLOG_VERBOSE << "Sending started game packet to server...\n";
 
     return sendEncrypted( //
         CTSPStartedGame{
-            .loginToken = loginToken,        //
-            .levelValidator = levelValidator //
+            .loginToken = loginToken,            //
+            .levelValidatorId = levelValidatorId //
         } //
     );
 }
@@ -392,7 +409,7 @@ template <typename T>
     );
 }
 
-bool HexagonClient::connect()
+bool HexagonClient::connectImpl()
 {
     _state = State::Connecting;
 
@@ -447,10 +464,13 @@ HexagonClient::HexagonClient(Steam::steam_manager& steamManager,
       _lastHeartbeatTime{},
       _verbose{true},
       _clientPSKeys{generateSodiumPSKeys()},
+      _hasRTKeys{false},
       _state{State::Disconnected},
       _loginToken{},
       _loginName{},
-      _events{}
+      _commands{},
+      _events{},
+      _ioThreadRunning{true}
 {
     const auto sKeyPublic = sodiumKeyToString(_clientPSKeys.keyPublic);
     const auto sKeySecret = sodiumKeyToString(_clientPSKeys.keySecret);
@@ -466,20 +486,38 @@ HexagonClient::HexagonClient(Steam::steam_manager& steamManager,
         SSVOH_CLOG_ERROR << "Failure initializing client, no ticket Steam ID\n";
 
         _state = State::InitError;
-        return;
+    }
+    else
+    {
+        connect();
     }
 
-    connect();
+    _ioThread = std::thread{[this] { run(); }};
 }
 
 HexagonClient::~HexagonClient()
 {
     SSVOH_CLOG << "Uninitializing client...\n";
-    disconnect();
+
+    _ioThreadRunning = false;
+    _ioThread.join();
+
+    disconnectImpl();
+
     SSVOH_CLOG << "Client uninitialized\n";
 }
 
-void HexagonClient::disconnect()
+bool HexagonClient::connect()
+{
+    return _commands.enqueue([this] { (void)connectImpl(); });
+}
+
+bool HexagonClient::disconnect()
+{
+    return _commands.enqueue([this] { disconnectImpl(); });
+}
+
+void HexagonClient::disconnectImpl()
 {
     SSVOH_CLOG << "Disconnecting client...\n";
 
@@ -525,7 +563,7 @@ bool HexagonClient::sendHeartbeatIfNecessary()
             SSVOH_CLOG_ERROR
                 << "Error sending heartbeat, disconnecting client\n";
 
-            disconnect();
+            disconnectImpl();
             return fail();
         }
     }
@@ -570,7 +608,7 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
 
             addEvent(EKicked{});
 
-            disconnect();
+            disconnectImpl();
             return true;
         },
 
@@ -596,12 +634,14 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
             _clientRTKeys =
                 calculateClientSessionSodiumRTKeys(_clientPSKeys, stcp.key);
 
+            _hasRTKeys = _clientRTKeys.hasValue();
+
             if (!_clientRTKeys.hasValue())
             {
                 SSVOH_CLOG_ERROR << "Failed calculating RT keys, disconnecting "
                                     "from server\n";
 
-                disconnect();
+                disconnectImpl();
                 return fail();
             }
 
@@ -652,7 +692,11 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
             }
 
             _loginToken.emplace(stcp.loginToken);
-            _loginName.emplace(stcp.loginName);
+
+            {
+                std::lock_guard lock{_sharedDataMutex};
+                _loginName.emplace(stcp.loginName);
+            }
 
             _state = State::LoggedIn;
 
@@ -704,23 +748,25 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
 
         [&](const STCPTopScores& stcp)
         {
-            SSVOH_CLOG << "Received top scores from server, levelValidator: '"
-                       << stcp.levelValidator << "', size: '"
+            SSVOH_CLOG << "Received top scores from server, levelValidatorId: '"
+                       << stcp.levelValidatorId << "', size: '"
                        << stcp.scores.size() << "'\n";
 
             addEvent(EReceivedTopScores{
-                .levelValidator = stcp.levelValidator, .scores = stcp.scores});
+                .levelValidatorId = stcp.levelValidatorId,
+                .scores = stcp.scores});
 
             return true;
         },
 
         [&](const STCPOwnScore& stcp)
         {
-            SSVOH_CLOG << "Received own score from server, levelValidator: '"
-                       << stcp.levelValidator << "'\n";
+            SSVOH_CLOG << "Received own score from server, levelValidatorId: '"
+                       << stcp.levelValidatorId << "'\n";
 
             addEvent(EReceivedOwnScore{
-                .levelValidator = stcp.levelValidator, .score = stcp.score});
+                .levelValidatorId = stcp.levelValidatorId,
+                .score = stcp.score});
 
             return true;
         },
@@ -728,22 +774,81 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
         [&](const STCPTopScoresAndOwnScore& stcp)
         {
             SSVOH_CLOG << "Received top scores and own score from server, "
-                          "levelValidator: '"
-                       << stcp.levelValidator << "'\n";
+                          "levelValidatorId: '"
+                       << stcp.levelValidatorId << "'\n";
 
             addEvent(EReceivedTopScores{
-                .levelValidator = stcp.levelValidator, .scores = stcp.scores});
+                .levelValidatorId = stcp.levelValidatorId,
+                .scores = stcp.scores});
 
             if (stcp.ownScore.hasValue())
             {
-                addEvent(
-                    EReceivedOwnScore{.levelValidator = stcp.levelValidator,
-                        .score = *stcp.ownScore});
+                addEvent(EReceivedOwnScore{
+                    .levelValidatorId = stcp.levelValidatorId,
+                    .score = *stcp.ownScore});
             }
 
             return true;
         },
 
+        [&](const STCPTopScoresUnchanged& stcp)
+        {
+            SSVOH_CLOG_VERBOSE << "Received unchanged top scores from server, "
+                                  "levelValidatorId: '"
+                               << stcp.levelValidatorId << "'\n";
+
+            addEvent(EReceivedScoresUnchanged{
+                .levelValidatorId = stcp.levelValidatorId,
+                .version = stcp.version});
+
+            return true;
+        },
+
+        [&](const STCPTopScoresDelta& stcp)
+        {
+            SSVOH_CLOG << "Received top scores delta from server, "
+                          "levelValidatorId: '"
+                       << stcp.levelValidatorId << "', moved: '"
+                       << stcp.delta.moved.size() << "', inserted: '"
+                       << stcp.delta.inserted.size() << "'\n";
+
+            addEvent(EReceivedScoresDelta{
+                .levelValidatorId = stcp.levelValidatorId,
+                .baseVersion = stcp.baseVersion,
+                .version = stcp.version,
+                .delta = stcp.delta,
+                .ownScore = stcp.ownScore});
+
+            return true;
+        },
+
+        [&](const STCPTopScoresBatchRejected& stcp)
+        {
+            SSVOH_CLOG_ERROR << "Server rejected '"
+                             << stcp.levelValidatorIds.size()
+                             << "' leaderboard requests, error: '"
+                             << stcp.error << "'\n";
+
+            addEvent(EScoresBatchRejected{
+                .levelValidatorIds = stcp.levelValidatorIds,
+                .error = stcp.error});
+
+            return true;
+        },
+
+        [&](const STCPReplayAccepted& stcp)
+        {
+            SSVOH_CLOG << "Replay accepted by server, levelValidatorId: '"
+                       << stcp.levelValidatorId << "', score: '" << stcp.score
+                       << "'\n";
+
+            addEvent(EReplayAccepted{
+                .levelValidatorId = stcp.levelValidatorId,
+                .score = stcp.score});
+
+            return true;
+        },
+
         [&](const STCPServerStatus& stcp)
         {
             SSVOH_CLOG << "Received server status from server\n";
@@ -759,13 +864,17 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
             if (serverProtocolVersion != PROTOCOL_VERSION)
             {
                 addEvent(EProtocolVersionMismatch{});
-                disconnect();
+                disconnectImpl();
                 return true;
             }
 
-            _levelValidatorsSupportedByServer.insert(
-                supportedLevelValidatorsVector.begin(),
-                supportedLevelValidatorsVector.end());
+            {
+                std::lock_guard lock{_sharedDataMutex};
+
+                _levelValidatorsSupportedByServer.clear();
+                _levelValidatorsSupportedByServer.add(
+                    supportedLevelValidatorsVector);
+            }
 
             _state = State::LoggedIn_Ready;
             addEvent(ELoginSuccess{});
@@ -778,17 +887,46 @@ bool HexagonClient::receiveDataFromServer(sf::Packet& p)
     );
 }
 
-void HexagonClient::update()
+void HexagonClient::run()
 {
-    if (!_socketConnected)
+    // Requests queued right before shutdown (e.g. a final replay upload) are
+    // still executed before the thread exits.
+    while (_ioThreadRunning || _commands.size_approx() > 0)
     {
-        return;
+        runIteration();
     }
+}
+
+void HexagonClient::runIteration()
+{
+    // Upper bound on the time the I/O thread sleeps while idle, and thus on
+    // the latency of packets received from the server.
+    constexpr std::chrono::duration pollInterval =
+        std::chrono::milliseconds(10);
 
     try
     {
+        Command command;
+        if (_commands.wait_dequeue_timed(command, pollInterval))
+        {
+            do
+            {
+                command();
+            }
+            while (_commands.try_dequeue(command));
+        }
+
+        if (!_socketConnected)
+        {
+            return;
+        }
+
         sendHeartbeatIfNecessary();
-        receiveDataFromServer(_packetBuffer);
+
+        while (receiveDataFromServer(_packetBuffer))
+        {
+            // Process all the packets that are already available.
+        }
     }
     catch (const std::runtime_error& e)
     {
@@ -816,6 +954,72 @@ static std::string saltAndHashPwd(const std::string& password)
 
 bool HexagonClient::tryRegister(
     const std::string& name, const std::string& password)
+{
+    return _commands.enqueue(
+        [this, name, password] { (void)tryRegisterImpl(name, password); });
+}
+
+bool HexagonClient::tryLogin(
+    const std::string& name, const std::string& password)
+{
+    return _commands.enqueue(
+        [this, name, password] { (void)tryLoginImpl(name, password); });
+}
+
+bool HexagonClient::tryLogoutFromServer()
+{
+    return _commands.enqueue([this] { (void)tryLogoutFromServerImpl(); });
+}
+
+bool HexagonClient::tryDeleteAccount(const std::string& password)
+{
+    return _commands.enqueue(
+        [this, password] { (void)tryDeleteAccountImpl(password); });
+}
+
+bool HexagonClient::tryRequestTopScores(const LevelValidatorId levelValidatorId)
+{
+    return _commands.enqueue([this, levelValidatorId]
+        { (void)tryRequestTopScoresImpl(levelValidatorId); });
+}
+
+bool HexagonClient::tryRequestOwnScore(const LevelValidatorId levelValidatorId)
+{
+    return _commands.enqueue([this, levelValidatorId]
+        { (void)tryRequestOwnScoreImpl(levelValidatorId); });
+}
+
+bool HexagonClient::tryRequestTopScoresAndOwnScore(
+    const LevelValidatorId levelValidatorId)
+{
+    return _commands.enqueue([this, levelValidatorId]
+        { (void)tryRequestTopScoresAndOwnScoreImpl(levelValidatorId); });
+}
+
+bool HexagonClient::tryRequestTopScoresAndOwnScoreBatch(
+    std::vector<CachedLeaderboardVersion>&& cachedVersions)
+{
+    return _commands.enqueue(
+        [this, cvs = SSVOH_MOVE(cachedVersions)]
+        { (void)tryRequestTopScoresAndOwnScoreBatchImpl(cvs); });
+}
+
+bool HexagonClient::trySendStartedGame(const std::string& levelValidator)
+{
+    return _commands.enqueue([this, levelValidator]
+        { (void)trySendStartedGameImpl(levelValidator); });
+}
+
+bool HexagonClient::trySendCompressedReplay(const std::string& levelValidator,
+    const compressed_replay_file& compressedReplayFile)
+{
+    return _commands.enqueue(
+        [this, levelValidator, crf = compressedReplayFile]
+        { (void)trySendCompressedReplayImpl(levelValidator, crf); });
+}
+
+bool HexagonClient::tryRegisterImpl(
+    const std::string& name, const std::string& password)
 {
     if (!connectedAndInState(State::Connected))
     {
@@ -833,7 +1037,7 @@ bool HexagonClient::tryRegister(
     return sendRegister(_ticketSteamID.value(), name, saltAndHashPwd(password));
 }
 
-bool HexagonClient::tryLogin(
+bool HexagonClient::tryLoginImpl(
     const std::string& name, const std::string& password)
 {
     if (!connectedAndInState(State::Connected))
@@ -851,7 +1055,7 @@ bool HexagonClient::tryLogin(
     return sendLogin(_ticketSteamID.value(), name, saltAndHashPwd(password));
 }
 
-bool HexagonClient::tryLogoutFromServer()
+bool HexagonClient::tryLogoutFromServerImpl()
 {
     if (!connectedAndInAnyState(State::LoggedIn, State::LoggedIn_Ready))
     {
@@ -860,13 +1064,17 @@ bool HexagonClient::tryLogoutFromServer()
 
     _state = State::Connected;
     _loginToken.reset();
-    _loginName.reset();
+
+    {
+        std::lock_guard lock{_sharedDataMutex};
+        _loginName.reset();
+    }
 
     SSVOH_ASSERT(_ticketSteamID.hasValue());
     return sendLogout(_ticketSteamID.value());
 }
 
-bool HexagonClient::tryDeleteAccount(const std::string& password)
+bool HexagonClient::tryDeleteAccountImpl(const std::string& password)
 {
     if (!connectedAndInState(State::Connected))
     {
@@ -877,7 +1085,8 @@ bool HexagonClient::tryDeleteAccount(const std::string& password)
     return sendDeleteAccount(_ticketSteamID.value(), saltAndHashPwd(password));
 }
 
-bool HexagonClient::tryRequestTopScores(const std::string& levelValidator)
+bool HexagonClient::tryRequestTopScoresImpl(
+    const LevelValidatorId levelValidatorId)
 {
     if (!connectedAndInState(State::LoggedIn_Ready))
     {
@@ -885,10 +1094,11 @@ bool HexagonClient::tryRequestTopScores(const std::string& levelValidator)
     }
 
     SSVOH_ASSERT(_loginToken.hasValue());
-    return sendRequestTopScores(_loginToken.value(), levelValidator);
+    return sendRequestTopScores(_loginToken.value(), levelValidatorId);
 }
 
-bool HexagonClient::trySendCompressedReplay(const std::string& levelValidator,
+bool HexagonClient::trySendCompressedReplayImpl(
+    const std::string& levelValidator,
     const compressed_replay_file& compressedReplayFile)
 {
     if (!connectedAndInState(State::LoggedIn_Ready))
@@ -909,7 +1119,8 @@ bool HexagonClient::trySendCompressedReplay(const std::string& levelValidator,
         _loginToken.value(), levelValidator, compressedReplayFile);
 }
 
-bool HexagonClient::tryRequestOwnScore(const std::string& levelValidator)
+bool HexagonClient::tryRequestOwnScoreImpl(
+    const LevelValidatorId levelValidatorId)
 {
     if (!connectedAndInState(State::LoggedIn_Ready))
     {
@@ -917,11 +1128,11 @@ bool HexagonClient::tryRequestOwnScore(const std::string& levelValidator)
     }
 
     SSVOH_ASSERT(_loginToken.hasValue());
-    return sendRequestOwnScore(_loginToken.value(), levelValidator);
+    return sendRequestOwnScore(_loginToken.value(), levelValidatorId);
 }
 
-bool HexagonClient::tryRequestTopScoresAndOwnScore(
-    const std::string& levelValidator)
+bool HexagonClient::tryRequestTopScoresAndOwnScoreImpl(
+    const LevelValidatorId levelValidatorId)
 {
     if (!connectedAndInState(State::LoggedIn_Ready))
     {
@@ -929,18 +1140,59 @@ bool HexagonClient::tryRequestTopScoresAndOwnScore(
     }
 
     SSVOH_ASSERT(_loginToken.hasValue());
-    return sendRequestTopScoresAndOwnScore(_loginToken.value(), levelValidator);
+    return sendRequestTopScoresAndOwnScore(
+        _loginToken.value(), levelValidatorId);
 }
 
-bool HexagonClient::trySendStartedGame(const std::string& levelValidator)
+bool HexagonClient::tryRequestTopScoresAndOwnScoreBatchImpl(
+    const std::vector<CachedLeaderboardVersion>& cachedVersions)
+{
+    if (!connectedAndInState(State::LoggedIn_Ready))
+    {
+        return fail();
+    }
+
+    SSVOH_ASSERT(_loginToken.hasValue());
+
+    // The server rejects batches larger than the limit, so they are split.
+    for (std::size_t begin = 0; begin < cachedVersions.size();
+         begin += maxLeaderboardBatchSize)
+    {
+        const std::size_t end = std::min(
+            begin + maxLeaderboardBatchSize, cachedVersions.size());
+
+        if (!sendRequestTopScoresAndOwnScoreBatch(_loginToken.value(),
+                std::vector<CachedLeaderboardVersion>(
+                    cachedVersions.begin() + begin,
+                    cachedVersions.begin() + end)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool HexagonClient::trySendStartedGameImpl(const std::string& levelValidator)
 {
     if (!connectedAndInState(State::LoggedIn_Ready))
     {
         return fail();
     }
 
+    const sf::base::Optional<LevelValidatorId> levelValidatorId =
+        getLevelValidatorId(levelValidator);
+
+    if (!levelValidatorId.hasValue())
+    {
+        SSVOH_CLOG_VERBOSE << "Not sending started game for level '"
+                           << levelValidator << "', unsupported by server\n";
+
+        return true;
+    }
+
     SSVOH_ASSERT(_loginToken.hasValue());
-    return sendStartedGame(_loginToken.value(), levelValidator);
+    return sendStartedGame(_loginToken.value(), *levelValidatorId);
 }
 
 [[nodiscard]] HexagonClient::State HexagonClient::getState() const noexcept
@@ -950,18 +1202,19 @@ bool HexagonClient::trySendStartedGame(const std::string& levelValidator)
 
 [[nodiscard]] bool HexagonClient::hasRTKeys() const noexcept
 {
-    return _clientRTKeys.hasValue();
+    return _hasRTKeys;
 }
 
-[[nodiscard]] const sf::base::Optional<std::string>&
-HexagonClient::getLoginName() const noexcept
+[[nodiscard]] sf::base::Optional<std::string>
+HexagonClient::getLoginName() const
 {
+    std::lock_guard lock{_sharedDataMutex};
     return _loginName;
 }
 
 void HexagonClient::addEvent(const Event& e)
 {
-    _events.push_back(e);
+    _events.enqueue(e);
 }
 
 [[nodiscard]] bool HexagonClient::connectedAndInState(
@@ -978,19 +1231,27 @@ void HexagonClient::addEvent(const Event& e)
 
 [[nodiscard]] sf::base::Optional<HexagonClient::Event> HexagonClient::pollEvent()
 {
-    if (_events.empty())
+    Event e;
+    if (!_events.try_dequeue(e))
     {
         return sf::base::nullOpt;
     }
 
-    HG_SCOPE_GUARD({ _events.pop_front(); });
-    return  sf::base::makeOptional(_events.front());
+    return sf::base::makeOptional(SSVOH_MOVE(e));
 }
 
 [[nodiscard]] bool HexagonClient::isLevelSupportedByServer(
-    const std::string& levelValidator) const noexcept
+    const std::string& levelValidator) const
 {
+    std::lock_guard lock{_sharedDataMutex};
     return _levelValidatorsSupportedByServer.contains(levelValidator);
 }
 
+[[nodiscard]] sf::base::Optional<LevelValidatorId>
+HexagonClient::getLevelValidatorId(const std::string& levelValidator) const
+{
+    std::lock_guard lock{_sharedDataMutex};
+    return _levelValidatorsSupportedByServer.getId(levelValidator);
+}
+
 } // namespace hg
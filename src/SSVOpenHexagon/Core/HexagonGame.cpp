@@ -20,12 +20,15 @@
 #include "SSVOpenHexagon/Core/HexagonClient.hpp"
 #include "SSVOpenHexagon/Core/Joystick.hpp"
 #include "SSVOpenHexagon/Core/Steam.hpp"
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
 #include "SSVOpenHexagon/Core/Discord.hpp"
 #include "SSVOpenHexagon/Core/Discord.hpp"
 
 #include "SSVOpenHexagon/Utils/Concat.hpp"
 #include "SSVOpenHexagon/Utils/LevelValidator.hpp"
+#include "SSVOpenHexagon/Utils/LuaBindingProfiler.hpp"
 #include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
 #include "SSVOpenHexagon/Utils/String.hpp"
 #include "SSVOpenHexagon/Utils/Utils.hpp"
 
@@ -42,7 +45,19 @@
 #include <SFML/System/Angle.hpp>
 #include <SFML/System/Vector2.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
 
 namespace hg {
 
@@ -66,6 +81,63 @@ namespace {
     return random_number_generator{seed_rng()};
 }
 
+// Initial capacities of the containers filled during gameplay, chosen to
+// avoid reallocations in the middle of a game for typical levels.
+constexpr std::size_t initialWallCapacity = 512;
+constexpr std::size_t initialTimelineCapacity = 256;
+constexpr std::size_t initialReplayDataCapacity =
+    static_cast<std::size_t>(Config::TICKS_PER_SECOND) * 60 * 5;
+
+// Interned Lua code is discarded once this many strings have been collected,
+// to bound the memory used by scripts generating code on the fly.
+constexpr std::size_t maxLuaCodePoolSize = 1024;
+
+// Number of simulated ticks between two state hashes stored in replays.
+constexpr std::uint32_t stateHashInterval =
+    static_cast<std::uint32_t>(Config::TICKS_PER_SECOND);
+
+// Sizes of the incremental Lua garbage collection steps, in kilobytes of
+// allocation debt. Steps taken between headless ticks are larger, as there is
+// no frame rate to preserve.
+constexpr int luaGCFrameStepSizeKB = 8;
+constexpr int luaGCHeadlessStepSizeKB = 64;
+
+// Frame time reserved for presenting the frame, never used for collection.
+constexpr std::chrono::microseconds luaGCFrameMargin{1500};
+
+// Frame rate assumed to compute the collection budget when it is unlimited.
+constexpr unsigned int luaGCUnlimitedFPS = 60;
+
+// Duration of a simulation tick, in milliseconds.
+constexpr float tickDurationMs = Config::TIME_STEP / 60.f * 1000.f;
+
+// If the simulation thread falls behind by more than this, the missed ticks
+// are skipped instead of being run back to back.
+constexpr std::chrono::milliseconds maxSimulationLag{100};
+
+// A full collection is forced if the memory in use exceeds twice the memory
+// in use after the last completed cycle, as the stepping is not keeping up.
+constexpr int luaGCMinMemoryLimitKB = 4096;
+
+[[nodiscard]] int getLuaGCMemoryLimitKB(const int memoryUsageKB) noexcept
+{
+    return memoryUsageKB + std::max(memoryUsageKB, luaGCMinMemoryLimitKB);
+}
+
+// FNV-1a, applied to the object representation of `x`.
+template <typename T>
+void hashCombine(std::uint64_t& hash, const T& x) noexcept
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &x, sizeof(T));
+
+    for (const unsigned char b : bytes)
+    {
+        hash ^= b;
+        hash *= 0x100000001b3ull;
+    }
+}
+
 } // namespace
 
 HexagonGame::ActiveReplay::ActiveReplay(const replay_file& mReplayFile)
@@ -80,11 +152,37 @@ void HexagonGame::createWall(int mSide, float mThickness,
         levelStatus.wallSpawnDistance, mSpeed, mCurve, mHueMod);
 }
 
+[[nodiscard]] std::shared_ptr<const std::string> HexagonGame::internLuaCode(
+    const std::string_view mCode)
+{
+    if (const auto it = luaCodePool.find(mCode); it != luaCodePool.end())
+    {
+        return it->second;
+    }
+
+    if (luaCodePool.size() >= maxLuaCodePoolSize)
+    {
+        // Code still referred to by timeline actions stays alive until they
+        // are cleared, only the pool's references are dropped.
+        luaCodePool.clear();
+    }
+
+    auto code = std::make_shared<const std::string>(mCode);
+    luaCodePool.emplace(*code, code);
+
+    return code;
+}
+
 void HexagonGame::setMustStart(const bool x)
 {
     mustStart = x;
 }
 
+void HexagonGame::setDumpProfilesOnDeath(const bool x)
+{
+    dumpProfilesOnDeath = x;
+}
+
 static sf::Texture& getTextureOrNullTexture(HGAssets& assets,
     sf::base::Optional<sf::Texture>& nullTexture, const std::string& mId)
 {
@@ -97,6 +195,19 @@ static sf::Texture& getTextureOrNullTexture(HGAssets& assets,
     return assets.getTexture(mId);
 }
 
+void HexagonGame::initCameras()
+{
+    const float width = Config::getWidth();
+    const float height = Config::getHeight();
+    const float zoomFactor = Config::getZoomFactor();
+
+    backgroundCamera.emplace(sf::View{sf::Vector2f::Zero,
+        sf::Vector2f{width * zoomFactor, height * zoomFactor}});
+
+    overlayCamera.emplace(sf::View{
+        sf::Vector2f{width / 2.f, height / 2.f}, sf::Vector2f{width, height}});
+}
+
 void HexagonGame::initKeyIcons()
 {
     if (window == nullptr)
@@ -351,6 +462,14 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
       replayIcon{sf::IntRect{}},
       rng{initializeRng()}
 {
+    walls.reserve(initialWallCapacity);
+    timeline.reserve(initialTimelineCapacity);
+    eventTimeline.reserve(initialTimelineCapacity);
+    messageTimeline.reserve(initialTimelineCapacity);
+    timelineArena.reserve(initialTimelineCapacity);
+    lastReplayData.reserve(initialReplayDataCapacity);
+    lastStateHashes.reserve(initialReplayDataCapacity / stateHashInterval);
+
     if (!assets.isHeadless())
     {
         textUI.emplace(assets);
@@ -358,18 +477,12 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
 
     if (window != nullptr)
     {
-        const float width = Config::getWidth();
-        const float height = Config::getHeight();
-        const float zoomFactor = Config::getZoomFactor();
-
-        backgroundCamera.emplace(sf::View{sf::Vector2f::Zero,
-            sf::Vector2f{width * zoomFactor, height * zoomFactor}});
-
-        overlayCamera.emplace(sf::View{sf::Vector2f{width / 2.f, height / 2.f},
-            sf::Vector2f{width, height}});
+        initCameras();
 
         SSVOH_ASSERT(graphicsContext != nullptr);
 
+        loadLayer3DShader();
+
         txStarParticle =
             &getTextureOrNullTexture(assets, nullTexture, "starParticle.png");
         txSmallCircle =
@@ -393,18 +506,53 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
         replayIcon.setTextureRect(txReplayIcon->getRect());
     }
 
-    game.onUpdate += [this](float mFT) { update(mFT, Config::getTimescale()); };
+    game.onUpdate += [this](float mFT)
+    {
+        if (isSimulationThreaded())
+        {
+            updateSimulationThread(mFT);
+            return;
+        }
 
-    game.onPostUpdate += [this] { postUpdate(); };
+        const std::unique_lock<std::mutex> lock = lockSimulation();
 
-    game.onDraw += [this] { draw(); };
+        SSVOH_PROFILE_TICK_START(tickProfiler, tickDurationMs);
+
+        markLuaGCFrameStart();
+        update(mFT, Config::getTimescale());
+    };
+
+    game.onPostUpdate += [this]
+    {
+        const std::unique_lock<std::mutex> lock = lockSimulation();
+        postUpdate();
+    };
+
+    game.onDraw += [this]
+    {
+        // With a threaded simulation, the Lua garbage is collected between
+        // ticks by the simulation thread.
+        if (isSimulationThreaded())
+        {
+            draw();
+            return;
+        }
+
+        markLuaGCFrameStart();
+        draw();
+        stepLuaGCInFrameBudget();
+    };
 
     game.onAnyEvent += [this](const sf::Event& e)
     { Imgui::processEvent(window->getRenderWindow(), e); };
 
     if (window != nullptr)
     {
-        window->onRecreation += [this] { initKeyIcons(); };
+        window->onRecreation += [this]
+        {
+            const std::unique_lock<std::mutex> lock = lockSimulation();
+            initKeyIcons();
+        };
     }
 
     // ------------------------------------------------------------------------
@@ -414,17 +562,30 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
 
     using Tid = Config::Tid;
 
+    // Input actions modify the game state, they are serialized with the
+    // ticks of the simulation thread, if any.
+    const auto locked = [this](auto action)
+    {
+        return [this, action](float mFT)
+        {
+            const std::unique_lock<std::mutex> lock = lockSimulation();
+            action(mFT);
+        };
+    };
+
     const auto addTidInput =
         [&](const Tid tid, const ssvs::Input::Type type, auto action)
     {
-        game.addInput(
-            Config::getTrigger(tid), action, type, static_cast<int>(tid));
+        game.addInput(Config::getTrigger(tid), locked(action), type,
+            static_cast<int>(tid));
     };
 
     const auto addTid2StateInput = [&](const Tid tid, bool& value)
     {
-        add2StateInput(
-            game, Config::getTrigger(tid), value, static_cast<int>(tid));
+        game.addInput(Config::getTrigger(tid),
+            locked([&value](float /*unused*/) { value = true; }),
+            locked([&value](float /*unused*/) { value = false; }),
+            ssvs::Input::Type::Always, static_cast<int>(tid));
     };
 
     addTid2StateInput(Tid::RotateCCW, inputImplCCW);
@@ -444,7 +605,7 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
     };
 
     game.addInput({{sf::Keyboard::Key::Escape}},
-        notInConsole([this] { goToMenu(); }), // hardcoded
+        locked(notInConsole([this] { goToMenu(); })), // hardcoded
         ssvs::Input::Type::Always);
 
     addTidInput(Tid::Exit, ssvs::Input::Type::Always,
@@ -524,6 +685,17 @@ HexagonGame::HexagonGame(sf::GraphicsContext* mGraphicsContext,
 HexagonGame::~HexagonGame()
 {
     ssvu::lo("HexagonGame::~HexagonGame") << "Cleaning up game resources...\n";
+
+    if (simulationThread.joinable())
+    {
+        {
+            const std::lock_guard<std::mutex> lock{simulationMutex};
+            simulationThreadStop = true;
+        }
+
+        simulationCV.notify_one();
+        simulationThread.join();
+    }
 }
 
 void HexagonGame::refreshTrigger(
@@ -626,6 +798,10 @@ void HexagonGame::saveReplay()
 void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
     bool mFirstPlay, float mDifficultyMult, bool executeLastReplay)
 {
+    const std::unique_lock<std::recursive_mutex> luaLock = lockLua();
+
+    leftGame = false;
+
     // Save replay when restarting without having died
     if (!mFirstPlay)
     {
@@ -654,6 +830,16 @@ void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
 
     const double tempReplayScore = getReplayScore(status);
     status = HexagonGameStatus{};
+    stateHashTicks = 0;
+    replayDiverged = false;
+
+#ifdef SSVOH_ENABLE_TICK_PROFILER
+    tickProfiler.clear();
+#endif
+
+#ifdef SSVOH_ENABLE_LUA_BINDING_PROFILER
+    Utils::getLuaBindingProfiler().clear();
+#endif
 
     if (!executeLastReplay)
     {
@@ -664,7 +850,9 @@ void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
 
         // Save data for immediate replay.
         lastSeed = rng.seed();
-        lastReplayData = replay_data{};
+        lastReplayData.clear();
+        lastStateHashes.clear();
+        lastStateHashes.set_interval(stateHashInterval);
         lastFirstPlay = mFirstPlay;
 
         // Clear any existing active replay.
@@ -677,7 +865,7 @@ void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
             lastPlayedScore = tempReplayScore;
 
             activeReplay.emplace(replay_file{
-                ._version{0},
+                ._version{replay_format_version},
 
                 // TODO (P1): should this stay local?
                 ._player_name{assets.getCurrentLocalProfile().getName()},
@@ -689,6 +877,7 @@ void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
                 ._first_play{lastFirstPlay},
                 ._difficulty_mult{mDifficultyMult},
                 ._played_score{lastPlayedScore},
+                ._state_hashes{lastStateHashes},
             });
         }
 
@@ -814,6 +1003,7 @@ void HexagonGame::newGame(const std::string& mPackId, const std::string& mId,
     }
 
     runVoidLuaFunctionIfExists("onInit");
+    startManualLuaGC();
 
     restartId = mId;
     restartFirstTime = false;
@@ -1041,6 +1231,22 @@ void HexagonGame::death(bool mForce)
 
     status.hasDied = true;
 
+#ifdef SSVOH_ENABLE_TICK_PROFILER
+    if (dumpProfilesOnDeath)
+    {
+        std::cout << "Tick profile for level '" << levelId << "':\n";
+        tickProfiler.dump(std::cout);
+    }
+#endif
+
+#ifdef SSVOH_ENABLE_LUA_BINDING_PROFILER
+    if (dumpProfilesOnDeath)
+    {
+        std::cout << "Lua binding profile for level '" << levelId << "':\n";
+        Utils::getLuaBindingProfiler().dump(std::cout);
+    }
+#endif
+
     if (!inReplay())
     {
         const replay_file rf = death_createReplayFile();
@@ -1071,7 +1277,7 @@ void HexagonGame::death(bool mForce)
                                    : "no_profile";
 
     return replay_file{
-        ._version{0},
+        ._version{replay_format_version},
         ._player_name{rfName},
         ._seed{lastSeed},
         ._data{lastReplayData},
@@ -1080,6 +1286,7 @@ void HexagonGame::death(bool mForce)
         ._first_play{firstPlay},
         ._difficulty_mult{difficultyMult},
         ._played_score{getReplayScore(status)},
+        ._state_hashes{lastStateHashes},
     };
 }
 
@@ -1134,7 +1341,6 @@ void HexagonGame::death_sendAndSaveReplay(const replay_file& rf)
         return false;
     }
 
-    steamManager->unlock_achievement("a24_onlinescore");
     return true;
 }
 
@@ -1170,37 +1376,316 @@ void HexagonGame::death_sendAndSaveReplay(const replay_file& rf)
     return true;
 }
 
-[[nodiscard]] sf::base::Optional<HexagonGame::GameExecutionResult>
-HexagonGame::executeGameUntilDeath(
-    const int maxProcessingSeconds, const float timescale)
+void HexagonGame::executeTick(const float timescale)
+{
+    update(Config::TIME_STEP, timescale);
+    postUpdate();
+
+    SSVOH_PROFILE_SCOPE(tickProfiler, LuaGC);
+    stepLuaGC(luaGCHeadlessStepSizeKB, std::chrono::microseconds::zero());
+}
+
+void HexagonGame::setDrawTrace(Utils::DrawTrace* mDrawTrace)
+{
+    drawTrace = mDrawTrace;
+
+    if (drawTrace != nullptr && !backgroundCamera.hasValue())
+    {
+        initCameras();
+    }
+}
+
+void HexagonGame::executeDraw()
+{
+    draw();
+}
+
+[[nodiscard]] bool HexagonGame::isSimulationThreaded() const
+{
+    return window != nullptr && Config::getThreadedSimulation();
+}
+
+[[nodiscard]] bool HexagonGame::onSimulationThread() const
+{
+    return std::this_thread::get_id() == simulationThreadId;
+}
+
+[[nodiscard]] std::unique_lock<std::mutex> HexagonGame::lockSimulation()
+{
+    // Nothing to serialize with until the simulation thread is started.
+    if (!simulationThread.joinable())
+    {
+        return std::unique_lock<std::mutex>{simulationMutex, std::defer_lock};
+    }
+
+    return std::unique_lock<std::mutex>{simulationMutex};
+}
+
+[[nodiscard]] std::unique_lock<std::recursive_mutex> HexagonGame::lockLua()
+{
+    if (!simulationThread.joinable())
+    {
+        return std::unique_lock<std::recursive_mutex>{
+            luaMutex, std::defer_lock};
+    }
+
+    return std::unique_lock<std::recursive_mutex>{luaMutex};
+}
+
+void HexagonGame::runSimulationThread()
+{
+    const auto tickDuration = std::chrono::duration_cast<HRClock::duration>(
+        std::chrono::duration<float, std::milli>{tickDurationMs});
+
+    std::unique_lock<std::mutex> lock{simulationMutex};
+
+    HRTimePoint nextTick = HRClock::now();
+
+    while (true)
+    {
+        if (!simulationThreadActive)
+        {
+            simulationCV.wait(lock, [this]
+                { return simulationThreadActive || simulationThreadStop; });
+
+            nextTick = HRClock::now();
+        }
+
+        if (simulationThreadStop)
+        {
+            return;
+        }
+
+        // The window thread is free to use the game state until the next
+        // tick.
+        lock.unlock();
+        std::this_thread::sleep_until(nextTick);
+        lock.lock();
+
+        if (!simulationThreadActive || simulationThreadStop)
+        {
+            continue;
+        }
+
+        SSVOH_PROFILE_TICK_START(tickProfiler, tickDurationMs);
+
+        update(Config::TIME_STEP, Config::getTimescale());
+        buildRenderSnapshot(renderSnapshots.getWriteBuffer());
+        renderSnapshots.publish();
+
+        if (status.started && status.mustStateChange != StateChange::None)
+        {
+            // Carried out by `updateSimulationThread`.
+            simulationThreadActive = false;
+        }
+
+        nextTick += tickDuration;
+        const HRTimePoint now = HRClock::now();
+
+        if (now - nextTick > maxSimulationLag)
+        {
+            nextTick = now;
+        }
+
+        // Garbage is collected in the time left until the next tick. Only
+        // the Lua state is needed, the window thread can use the rest of the
+        // game state in the meantime.
+        const std::chrono::microseconds gcBudget =
+            std::max(std::chrono::duration_cast<std::chrono::microseconds>(
+                         nextTick - now),
+                std::chrono::microseconds::zero());
+
+        lock.unlock();
+
+        const HRTimePoint tpGCBegin = HRClock::now();
+
+        {
+            const std::lock_guard<std::recursive_mutex> luaLock{luaMutex};
+            stepLuaGC(luaGCFrameStepSizeKB, gcBudget);
+        }
+
+        const std::chrono::duration<float, std::milli> gcDuration =
+            HRClock::now() - tpGCBegin;
+
+        lock.lock();
+
+        // The profiler is read by the window thread under `simulationMutex`.
+        SSVOH_PROFILE_RECORD(tickProfiler, LuaGC, gcDuration.count());
+    }
+}
+
+void HexagonGame::updateSimulationThread(const float mFT)
+{
+    if (!simulationThread.joinable())
+    {
+        // The thread waits for the lock, so it sees its own id.
+        const std::lock_guard<std::mutex> lock{simulationMutex};
+
+        simulationThread = std::thread{[this] { runSimulationThread(); }};
+        simulationThreadId = simulationThread.get_id();
+    }
+
+    const std::unique_lock<std::mutex> lock = lockSimulation();
+
+    if (pendingGoToMenu.hasValue())
+    {
+        const GoToMenuRequest request = *pendingGoToMenu;
+        pendingGoToMenu.reset();
+
+        goToMenu(request.sendScores, request.error);
+        return;
+    }
+
+    updateRichPresence(mFT);
+
+    if (!mustReplayInput() && !imguiLuaConsoleHasInput())
+    {
+        updateInput_UpdateJoystickControls();
+        updateInput_UpdateTouchControls();
+    }
+
+    if (!leftGame && status.started)
+    {
+        (void)updateStateChange();
+    }
+
+    // Restarting the level may also fail and go back to the menu.
+    if (!simulationThreadActive && !leftGame)
+    {
+        simulationThreadActive = true;
+        simulationCV.notify_one();
+    }
+}
+
+void HexagonGame::startManualLuaGC()
+{
+    // Level initialization leaves plenty of garbage behind, collect all of it
+    // before the game starts.
+    lua.collectGarbage();
+    lua.setAutomaticGarbageCollection(false);
+
+    luaGCFrameStart.reset();
+    luaGCMemoryLimitKB = getLuaGCMemoryLimitKB(lua.getMemoryUsageKB());
+}
+
+void HexagonGame::markLuaGCFrameStart()
+{
+    if (!luaGCFrameStart.hasValue())
+    {
+        luaGCFrameStart.emplace(HRClock::now());
+    }
+}
+
+void HexagonGame::stepLuaGC(
+    const int stepSizeKB, const std::chrono::microseconds budget)
 {
     const HRTimePoint tpBegin = HRClock::now();
 
-    const auto exceededProcessingTime = [&]
-    { return hrSecondsSince(tpBegin) > maxProcessingSeconds; };
+    // At least one step is always taken, so that collection progresses even
+    // on frames with no time left.
+    bool finishedCycle = false;
 
-    while (!status.hasDied)
+    do
     {
-        update(Config::TIME_STEP, timescale);
-        postUpdate();
+        finishedCycle = lua.stepGarbageCollector(stepSizeKB);
+    }
+    while (!finishedCycle && HRClock::now() - tpBegin < budget);
+
+    if (finishedCycle)
+    {
+        luaGCMemoryLimitKB = getLuaGCMemoryLimitKB(lua.getMemoryUsageKB());
+    }
+    else if (lua.getMemoryUsageKB() > luaGCMemoryLimitKB)
+    {
+        lua.collectGarbage();
+        luaGCMemoryLimitKB = getLuaGCMemoryLimitKB(lua.getMemoryUsageKB());
+    }
+
+    // Stepping the collector manually rearms the automatic one.
+    lua.setAutomaticGarbageCollection(false);
+}
+
+void HexagonGame::stepLuaGCInFrameBudget()
+{
+    SSVOH_PROFILE_SCOPE(tickProfiler, LuaGC);
+
+    const unsigned int fps =
+        Config::getLimitFPS() ? Config::getMaxFPS() : luaGCUnlimitedFPS;
+
+    const std::chrono::microseconds frameDuration{
+        1'000'000 / std::max(fps, 1u)};
+
+    const std::chrono::microseconds elapsed =
+        luaGCFrameStart.hasValue()
+            ? std::chrono::duration_cast<std::chrono::microseconds>(
+                  HRClock::now() - luaGCFrameStart.value())
+            : std::chrono::microseconds::zero();
+
+    luaGCFrameStart.reset();
+
+    stepLuaGC(luaGCFrameStepSizeKB,
+        std::max(frameDuration - luaGCFrameMargin - elapsed,
+            std::chrono::microseconds::zero()));
+}
 
-        if (exceededProcessingTime())
+[[nodiscard]] HexagonGame::GameExecutionStatus HexagonGame::executeGameSlice(
+    const int maxTicks, const std::chrono::microseconds maxDuration,
+    const float timescale)
+{
+    const HRTimePoint tpBegin = HRClock::now();
+
+    for (int i = 0; i < maxTicks && !status.hasDied && !replayDiverged; ++i)
+    {
+        executeTick(timescale);
+
+        if (HRClock::now() - tpBegin > maxDuration)
         {
-            return sf::base::nullOpt;
+            break;
         }
     }
 
-    return sf::base::makeOptional(GameExecutionResult{
+    if (replayDiverged)
+    {
+        return GameExecutionStatus::Diverged;
+    }
+
+    return status.hasDied ? GameExecutionStatus::Finished
+                          : GameExecutionStatus::Paused;
+}
+
+[[nodiscard]] HexagonGame::GameExecutionResult
+HexagonGame::getGameExecutionResult() const
+{
+    return GameExecutionResult{
         .playedTimeSeconds = status.getPlayedAccumulatedFrametimeInSeconds(), //
         .pausedTimeSeconds = status.getPausedAccumulatedFrametimeInSeconds(), //
         .totalTimeSeconds = status.getTotalAccumulatedFrametimeInSeconds(),   //
         .customScore = status.getCustomScore()                                //
-    });
+    };
 }
 
 [[nodiscard]] sf::base::Optional<HexagonGame::GameExecutionResult>
-HexagonGame::runReplayUntilDeathAndGetScore(const replay_file& mReplayFile,
+HexagonGame::executeGameUntilDeath(
     const int maxProcessingSeconds, const float timescale)
+{
+    const GameExecutionStatus executionStatus =
+        executeGameSlice(std::numeric_limits<int>::max(),
+            std::chrono::seconds{maxProcessingSeconds}, timescale);
+
+    if (executionStatus != GameExecutionStatus::Finished)
+    {
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(getGameExecutionResult());
+}
+
+[[nodiscard]] bool HexagonGame::hasReplayDiverged() const noexcept
+{
+    return replayDiverged;
+}
+
+void HexagonGame::startReplayExecution(const replay_file& mReplayFile)
 {
     SSVOH_ASSERT(assets.isValidPackId(mReplayFile._pack_id));
     SSVOH_ASSERT(assets.isValidLevelId(mReplayFile._level_id));
@@ -1210,7 +1695,13 @@ HexagonGame::runReplayUntilDeathAndGetScore(const replay_file& mReplayFile,
     newGame(mReplayFile._pack_id, mReplayFile._level_id,
         mReplayFile._first_play, mReplayFile._difficulty_mult,
         /* mExecuteLastReplay */ true);
+}
 
+[[nodiscard]] sf::base::Optional<HexagonGame::GameExecutionResult>
+HexagonGame::runReplayUntilDeathAndGetScore(const replay_file& mReplayFile,
+    const int maxProcessingSeconds, const float timescale)
+{
+    startReplayExecution(mReplayFile);
     return executeGameUntilDeath(maxProcessingSeconds, timescale);
 }
 
@@ -1220,7 +1711,8 @@ void HexagonGame::incrementDifficulty()
 
     const float signMult = (levelStatus.rotationSpeed > 0.f) ? 1.f : -1.f;
 
-    levelStatus.rotationSpeed += levelStatus.rotationSpeedInc * signMult;
+    levelStatus.rotationSpeed = Utils::Strict::mulAdd(
+        levelStatus.rotationSpeedInc, signMult, levelStatus.rotationSpeed);
 
     const auto& rotationSpeedMax(levelStatus.rotationSpeedMax);
     if (std::abs(levelStatus.rotationSpeed) > rotationSpeedMax)
@@ -1320,6 +1812,21 @@ void HexagonGame::goToMenu(bool mSendScores, bool mError)
         return;
     }
 
+    // No more ticks are simulated once the game is left. The menu can only be
+    // entered from the window thread, which picks up the request.
+    simulationThreadActive = false;
+    leftGame = true;
+
+    if (onSimulationThread())
+    {
+        pendingGoToMenu.emplace(
+            GoToMenuRequest{.sendScores = mSendScores, .error = mError});
+
+        return;
+    }
+
+    const std::unique_lock<std::recursive_mutex> luaLock = lockLua();
+
     if (audio != nullptr)
     {
         audio->stopSounds();
@@ -1687,6 +2194,11 @@ void HexagonGame::setSides(unsigned int mSides)
     return status;
 }
 
+[[nodiscard]] std::uint32_t HexagonGame::getLastFrameDrawCalls() const noexcept
+{
+    return lastFrameDrawCalls;
+}
+
 [[nodiscard]] LevelStatus& HexagonGame::getLevelStatus()
 {
     return levelStatus;
@@ -1717,6 +2229,51 @@ void HexagonGame::setSides(unsigned int mSides)
     return inputMovement;
 }
 
+[[nodiscard]] std::uint64_t HexagonGame::computeStateHash() const noexcept
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+
+    hashCombine(hash, player.getPlayerAngle());
+    hashCombine(hash, static_cast<std::uint64_t>(walls.size()));
+    hashCombine(hash, rng.state_fingerprint());
+    hashCombine(hash, status.getPlayedAccumulatedFrametime());
+
+    return hash;
+}
+
+void HexagonGame::updateStateHashes()
+{
+    ++stateHashTicks;
+
+    if (!inReplay())
+    {
+        SSVOH_ASSERT(lastStateHashes.interval() > 0);
+
+        if (stateHashTicks % lastStateHashes.interval() == 0)
+        {
+            lastStateHashes.record_hash(computeStateHash());
+        }
+
+        return;
+    }
+
+    const replay_state_hashes& expected =
+        activeReplay->replayFile._state_hashes;
+
+    // Replays recorded without state hashes are only checked at the end.
+    if (expected.empty() || stateHashTicks % expected.interval() != 0)
+    {
+        return;
+    }
+
+    const std::uint64_t index = stateHashTicks / expected.interval() - 1;
+
+    if (index < expected.size() && expected.at(index) != computeStateHash())
+    {
+        replayDiverged = true;
+    }
+}
+
 [[nodiscard]] bool HexagonGame::inReplay() const noexcept
 {
     return activeReplay.hasValue();
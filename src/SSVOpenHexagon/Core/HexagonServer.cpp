@@ -9,6 +9,7 @@
 #include "SSVOpenHexagon/Global/Assert.hpp"
 #include "SSVOpenHexagon/Global/Assets.hpp"
 #include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
 #include "SSVOpenHexagon/Global/Version.hpp"
 
 #include "SSVOpenHexagon/Core/HexagonGame.hpp"
@@ -20,11 +21,13 @@
 #include "SSVOpenHexagon/Utils/Split.hpp"
 #include "SSVOpenHexagon/Utils/StringToCharVec.hpp"
 #include "SSVOpenHexagon/Utils/Timestamp.hpp"
-#include "SSVOpenHexagon/Utils/VectorToSet.hpp"
 
 #include "SSVOpenHexagon/Online/Shared.hpp"
 #include "SSVOpenHexagon/Online/Database.hpp"
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
 #include "SSVOpenHexagon/Online/Sodium.hpp"
+#include "SSVOpenHexagon/Online/ReplayArchive.hpp"
 
 #include <SSVUtils/Core/Log/Log.hpp>
 
@@ -38,6 +41,7 @@
 
 #include <boost/pfr.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <SFML/Base/Optional.hpp>
 #include <sstream>
@@ -66,6 +70,11 @@ static auto& slog(const char* funcName)
 
 namespace hg {
 
+static constexpr int topScoresLimit = 6;
+
+// Number of past versions of each leaderboard kept around to compute deltas.
+static constexpr std::size_t leaderboardHistorySnapshots = 4;
+
 HexagonServer::ConnectedClient::ConnectedClient(
     const Utils::SCTimePoint lastActivity)
     : _socket{true /* isBlocking */}, // TODO (P0): should this be blocking????
@@ -99,9 +108,72 @@ template <typename... Ts>
 }
 
 [[nodiscard]] bool HexagonServer::isLevelSupported(
-    const std::string& levelValidator) const
+    const LevelValidatorId levelValidatorId) const
+{
+    return _supportedLevelValidators.contains(levelValidatorId);
+}
+
+[[nodiscard]] const std::vector<Database::ProcessedScore>&
+HexagonServer::getTopScores(const LevelValidatorId levelValidatorId)
+{
+    if (!_leaderboardHistory.isUpToDate(levelValidatorId))
+    {
+        return _leaderboardHistory
+            .update(levelValidatorId,
+                Database::getTopScores(topScoresLimit, levelValidatorId))
+            .scores;
+    }
+
+    return _leaderboardHistory.getLatest(levelValidatorId).scores;
+}
+
+[[nodiscard]] const sf::base::Optional<double>&
+HexagonServer::getCachedUserScore(
+    const LevelValidatorId levelValidatorId, const std::uint64_t steamId)
+{
+    if (const sf::base::Optional<double>* cached =
+            _userScoreCache.find(levelValidatorId, steamId);
+        cached != nullptr)
+    {
+        return *cached;
+    }
+
+    return _userScoreCache.store(levelValidatorId, steamId,
+        Database::getUserScoreValue(levelValidatorId, steamId));
+}
+
+[[nodiscard]] bool HexagonServer::sendVersionedTopScoresAndOwnScore(
+    ConnectedClient& c, const LevelValidatorId levelValidatorId,
+    const LeaderboardVersion cachedVersion)
 {
-    return _supportedLevelValidators.contains(levelValidator);
+    (void)getTopScores(levelValidatorId);
+
+    const LeaderboardHistory::Snapshot& latest =
+        _leaderboardHistory.getLatest(levelValidatorId);
+
+    // Every score change bumps the version, including changes that only
+    // affect the client's own score, so nothing has to be sent here.
+    if (cachedVersion == latest.version)
+    {
+        return sendTopScoresUnchanged(c, levelValidatorId, latest.version);
+    }
+
+    const LeaderboardHistory::Snapshot* cached =
+        cachedVersion == noLeaderboardVersion
+            ? nullptr
+            : _leaderboardHistory.find(levelValidatorId, cachedVersion);
+
+    // Unknown versions are answered with a delta against an empty list, which
+    // contains the whole leaderboard.
+    const LeaderboardVersion baseVersion =
+        cached != nullptr ? cachedVersion : noLeaderboardVersion;
+
+    static const std::vector<Database::ProcessedScore> emptyScores;
+
+    return sendTopScoresDelta(c, levelValidatorId, baseVersion, latest.version,
+        makeLeaderboardDelta(
+            cached != nullptr ? cached->scores : emptyScores, latest.scores),
+        Database::getScore(levelValidatorId, c._loginData->_steamId));
 }
 
 [[nodiscard]] bool HexagonServer::initializeControlSocket()
@@ -247,45 +319,97 @@ template <typename T>
 }
 
 [[nodiscard]] bool HexagonServer::sendTopScores(ConnectedClient& c,
-    const std::string& levelValidator,
+    const LevelValidatorId levelValidatorId,
     const std::vector<Database::ProcessedScore>& scores)
 {
     return sendEncrypted(c, //
         STCPTopScores{
-            .levelValidator = levelValidator, //
-            .scores = scores                  //
+            .levelValidatorId = levelValidatorId, //
+            .scores = scores                      //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonServer::sendOwnScore(ConnectedClient& c,
-    const std::string& levelValidator, const Database::ProcessedScore& score)
+    const LevelValidatorId levelValidatorId,
+    const Database::ProcessedScore& score)
 {
     return sendEncrypted(c, //
         STCPOwnScore{
-            .levelValidator = levelValidator, //
-            .score = score                    //
+            .levelValidatorId = levelValidatorId, //
+            .score = score                        //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonServer::sendTopScoresAndOwnScore(ConnectedClient& c,
-    const std::string& levelValidator,
+    const LevelValidatorId levelValidatorId,
     const std::vector<Database::ProcessedScore>& scores,
     const sf::base::Optional<Database::ProcessedScore>& ownScore)
 {
     return sendEncrypted(c, //
         STCPTopScoresAndOwnScore{
-            .levelValidator = levelValidator, //
-            .scores = scores,                 //
-            .ownScore = ownScore              //
+            .levelValidatorId = levelValidatorId, //
+            .scores = scores,                     //
+            .ownScore = ownScore                  //
+        } //
+    );
+}
+
+[[nodiscard]] bool HexagonServer::sendTopScoresUnchanged(ConnectedClient& c,
+    const LevelValidatorId levelValidatorId, const LeaderboardVersion version)
+{
+    return sendEncrypted(c, //
+        STCPTopScoresUnchanged{
+            .levelValidatorId = levelValidatorId, //
+            .version = version                    //
+        } //
+    );
+}
+
+[[nodiscard]] bool HexagonServer::sendTopScoresDelta(ConnectedClient& c,
+    const LevelValidatorId levelValidatorId,
+    const LeaderboardVersion baseVersion, const LeaderboardVersion version,
+    const LeaderboardDelta& delta,
+    const sf::base::Optional<Database::ProcessedScore>& ownScore)
+{
+    return sendEncrypted(c, //
+        STCPTopScoresDelta{
+            .levelValidatorId = levelValidatorId, //
+            .baseVersion = baseVersion,           //
+            .version = version,                   //
+            .delta = delta,                       //
+            .ownScore = ownScore                  //
+        } //
+    );
+}
+
+[[nodiscard]] bool HexagonServer::sendTopScoresBatchRejected(
+    ConnectedClient& c, const std::vector<LevelValidatorId>& levelValidatorIds,
+    const std::string& error)
+{
+    return sendEncrypted(c, //
+        STCPTopScoresBatchRejected{
+            .levelValidatorIds = levelValidatorIds, //
+            .error = error                          //
+        } //
+    );
+}
+
+[[nodiscard]] bool HexagonServer::sendReplayAccepted(ConnectedClient& c,
+    const LevelValidatorId levelValidatorId, const double score)
+{
+    return sendEncrypted(c, //
+        STCPReplayAccepted{
+            .levelValidatorId = levelValidatorId, //
+            .score = score                        //
         } //
     );
 }
 
 [[nodiscard]] bool HexagonServer::sendServerStatus(ConnectedClient& c,
     const ProtocolVersion& protocolVersion, const GameVersion& gameVersion,
-    const std::vector<std::string>& supportedLevelValidators)
+    const std::vector<LevelValidatorMapping>& supportedLevelValidators)
 {
     return sendEncrypted(c, //
         STCPServerStatus{
@@ -448,6 +572,10 @@ bool HexagonServer::runIteration_Control()
             const sf::base::Optional<std::string> executeOutcome =
                 Database::execute(query);
 
+            // The query might have touched any score.
+            _leaderboardHistory.invalidateAll();
+            _userScoreCache.clear();
+
             if(executeOutcome.hasValue())
             {
                 SSVOH_SLOG_ERROR << "'db exec' error:\n"
@@ -699,8 +827,9 @@ void HexagonServer::runIteration_FlushLogs()
     return true;
 }
 
-[[nodiscard]] bool HexagonServer::processReplay(
-    ConnectedClient& c, const std::uint64_t loginToken, const replay_file& rf)
+[[nodiscard]] bool HexagonServer::processReplay(ConnectedClient& c,
+    const std::uint64_t loginToken, const replay_file& rf,
+    const compressed_replay_file* crf)
 {
     const void* clientAddr = static_cast<void*>(&c);
 
@@ -725,6 +854,12 @@ void HexagonServer::runIteration_FlushLogs()
         return discard("no game started");
     }
 
+    if (rf._version != replay_format_version)
+    {
+        return discard("replay format version ", rf._version,
+            " does not match ", replay_format_version);
+    }
+
     if (!_assets.isValidPackId(rf._pack_id))
     {
         return discard("invalid pack id '", rf._pack_id, '\'');
@@ -745,6 +880,29 @@ void HexagonServer::runIteration_FlushLogs()
     const std::string levelValidator =
         Utils::getLevelValidator(rf._level_id, rf._difficulty_mult);
 
+    const sf::base::Optional<LevelValidatorId> levelValidatorId =
+        _supportedLevelValidators.getId(levelValidator);
+
+    if (!levelValidatorId.hasValue())
+    {
+        return discard("unsupported level '", levelValidator, '\'');
+    }
+
+    SSVOH_ASSERT(c._loginData.hasValue());
+
+    // The bound comes from the number of recorded inputs, as the claimed
+    // score could be a custom score and is not trusted anyway.
+    const double maxPlayedSeconds = getMaxReplayPlayedSeconds(rf._data.size());
+
+    const sf::base::Optional<double>& storedScore =
+        getCachedUserScore(*levelValidatorId, c._loginData->_steamId);
+
+    if (!canImproveOnStoredScore(storedScore, maxPlayedSeconds))
+    {
+        return discard("cannot improve on stored score of ", *storedScore,
+            "s (at most ", maxPlayedSeconds, "s)");
+    }
+
     SSVOH_SLOG << "Processing replay from client '" << clientAddr
                << "' for level '" << levelValidator << "'\n";
 
@@ -754,6 +912,11 @@ void HexagonServer::runIteration_FlushLogs()
         _hexagonGame.runReplayUntilDeathAndGetScore(
             rf, maxProcessingSeconds, 1.f /* timescale */);
 
+    if (_hexagonGame.hasReplayDiverged())
+    {
+        return discard("replay diverged from its recorded state hashes");
+    }
+
     if (!ger.hasValue())
     {
         return discard(
@@ -797,12 +960,31 @@ void HexagonServer::runIteration_FlushLogs()
 
     SSVOH_SLOG << "Replay valid, adding to database\n";
 
-    SSVOH_ASSERT(c._loginData.hasValue());
+    const std::uint64_t timestamp = Utils::nowTimestamp();
 
-    Database::addScore(levelValidator, Utils::nowTimestamp(),
-        c._loginData->_steamId, replayPlayedTime);
+    Database::addScore(*levelValidatorId, timestamp, c._loginData->_steamId,
+        replayPlayedTime);
 
-    return true;
+    _userScoreCache.addScore(
+        *levelValidatorId, c._loginData->_steamId, replayPlayedTime);
+
+    _leaderboardHistory.invalidate(*levelValidatorId);
+
+    // Archive the replay for later re-validation and downloads. Uncompressed
+    // replays are compressed by the archive thread, so that the archive is
+    // homogeneous without blocking the server loop.
+    if (crf != nullptr)
+    {
+        _replayArchive.append(levelValidator, c._loginData->_steamId,
+            replayPlayedTime, timestamp, compressed_replay_file{*crf});
+    }
+    else
+    {
+        _replayArchive.append(levelValidator, c._loginData->_steamId,
+            replayPlayedTime, timestamp, replay_file{rf});
+    }
+
+    return sendReplayAccepted(c, *levelValidatorId, replayPlayedTime);
 }
 
 template <typename T>
@@ -832,6 +1014,11 @@ void HexagonServer::printCTSPDataVerbose(
         {
             return field;
         }
+        else if constexpr (std::is_same_v<U,
+                               std::vector<CachedLeaderboardVersion>>)
+        {
+            return Utils::concat('<', field.size(), " CACHED_VERSIONS>");
+        }
         else
         {
             return std::to_string(field);
@@ -871,8 +1058,6 @@ void HexagonServer::printCTSPDataVerbose(
 {
     const void* clientAddr = static_cast<void*>(&c);
 
-    constexpr int topScoresLimit = 6;
-
     _errorOss.str("");
     const PVClientToServer pv = decodeClientToServerPacket(
         c._rtKeys.hasValue() ? &c._rtKeys->keyReceive : nullptr, _errorOss, p);
@@ -1179,6 +1364,10 @@ void HexagonServer::printCTSPDataVerbose(
             Database::removeAllLoginTokensForUser(user->id);
             Database::removeUser(user->id);
 
+            // Scores of the deleted user might appear in any leaderboard.
+            _leaderboardHistory.invalidateAll();
+            _userScoreCache.clear();
+
             SSVOH_SLOG << "Successfully deleted account\n";
             return sendDeleteAccountSuccess(c);
         },
@@ -1193,18 +1382,17 @@ void HexagonServer::printCTSPDataVerbose(
                 return true;
             }
 
-            if (!isLevelSupported(ctsp.levelValidator))
+            if (!isLevelSupported(ctsp.levelValidatorId))
             {
                 return true;
             }
 
-            const std::string& lv = ctsp.levelValidator;
+            const LevelValidatorId lv = ctsp.levelValidatorId;
 
             SSVOH_SLOG_VERBOSE << "Sending top " << topScoresLimit
                                << " scores to client '" << clientAddr << "'\n";
 
-            return sendTopScores(
-                c, lv, Database::getTopScores(topScoresLimit, lv));
+            return sendTopScores(c, lv, getTopScores(lv));
         },
 
         [&](const CTSPReplay& ctsp)
@@ -1217,7 +1405,7 @@ void HexagonServer::printCTSPDataVerbose(
             }
 
             const auto& [loginToken, rf] = ctsp;
-            return processReplay(c, loginToken, rf);
+            return processReplay(c, loginToken, rf, nullptr /* crf */);
         },
 
         [&](const CTSPRequestOwnScore& ctsp)
@@ -1230,13 +1418,14 @@ void HexagonServer::printCTSPDataVerbose(
                 return true;
             }
 
-            if (!isLevelSupported(ctsp.levelValidator))
+            if (!isLevelSupported(ctsp.levelValidatorId))
             {
                 return true;
             }
 
             const sf::base::Optional<Database::ProcessedScore> ps =
-                Database::getScore(ctsp.levelValidator, c._loginData->_steamId);
+                Database::getScore(
+                    ctsp.levelValidatorId, c._loginData->_steamId);
 
             if (!ps.hasValue())
             {
@@ -1246,7 +1435,7 @@ void HexagonServer::printCTSPDataVerbose(
             SSVOH_SLOG_VERBOSE << "Sending own score to client '" << clientAddr
                                << "'\n";
 
-            return sendOwnScore(c, ctsp.levelValidator, *ps);
+            return sendOwnScore(c, ctsp.levelValidatorId, *ps);
         },
 
         [&](const CTSPRequestTopScoresAndOwnScore& ctsp)
@@ -1259,22 +1448,84 @@ void HexagonServer::printCTSPDataVerbose(
                 return true;
             }
 
-            if (!isLevelSupported(ctsp.levelValidator))
+            if (!isLevelSupported(ctsp.levelValidatorId))
             {
                 return true;
             }
 
-            const std::string& lv = ctsp.levelValidator;
+            const LevelValidatorId lv = ctsp.levelValidatorId;
 
             SSVOH_SLOG_VERBOSE << "Sending top " << topScoresLimit
                                << " scores and own score to client '"
                                << clientAddr << "'\n";
 
-            return sendTopScoresAndOwnScore(c, lv,
-                Database::getTopScores(topScoresLimit, lv),
+            return sendTopScoresAndOwnScore(c, lv, getTopScores(lv),
                 Database::getScore(lv, c._loginData->_steamId));
         },
 
+        [&](const CTSPRequestTopScoresAndOwnScoreBatch& ctsp)
+        {
+            printCTSPDataVerbose(
+                c, "request top scores and own score batch", ctsp);
+
+            if (!checkState(ConnectedClient::State::LoggedIn_Ready) ||
+                !validateLogin(
+                    c, "top scores and own scores batch", ctsp.loginToken))
+            {
+                return true;
+            }
+
+            const std::vector<CachedLeaderboardVersion>& cvs =
+                ctsp.cachedVersions;
+
+            const std::size_t n = std::min(cvs.size(), maxLeaderboardBatchSize);
+
+            if (cvs.size() > maxLeaderboardBatchSize)
+            {
+                SSVOH_SLOG << "Client '" << clientAddr << "' requested '"
+                           << cvs.size()
+                           << "' leaderboards, rejecting all but '"
+                           << maxLeaderboardBatchSize << "'\n";
+
+                std::vector<LevelValidatorId> rejected;
+                rejected.reserve(cvs.size() - n);
+
+                for (std::size_t i = n; i < cvs.size(); ++i)
+                {
+                    rejected.push_back(cvs[i].levelValidatorId);
+                }
+
+                if (!sendTopScoresBatchRejected(c, rejected,
+                        Utils::concat("Batch exceeds the limit of ",
+                            maxLeaderboardBatchSize, " leaderboards")))
+                {
+                    return false;
+                }
+            }
+
+            SSVOH_SLOG_VERBOSE << "Sending top " << topScoresLimit
+                               << " scores and own score for '" << n
+                               << "' levels to client '" << clientAddr
+                               << "'\n";
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const auto& [lv, version] = cvs[i];
+
+                if (!isLevelSupported(lv))
+                {
+                    continue;
+                }
+
+                if (!sendVersionedTopScoresAndOwnScore(c, lv, version))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        },
+
         [&](const CTSPStartedGame& ctsp)
         {
             printCTSPDataVerbose(c, "started game", ctsp);
@@ -1285,14 +1536,14 @@ void HexagonServer::printCTSPDataVerbose(
                 return true;
             }
 
-            const std::string& lv = ctsp.levelValidator;
+            const LevelValidatorId lv = ctsp.levelValidatorId;
 
             SSVOH_SLOG << "Client '" << clientAddr
-                       << "' started game for level '" << lv << "'\n";
+                       << "' started game for level id '" << lv << "'\n";
 
             c._gameStatus.emplace(ConnectedClient::GameStatus{
                 ._startTP = Utils::SCClock::now(), //
-                ._levelValidator = lv              //
+                ._levelValidatorId = lv            //
             });
 
             return true;
@@ -1321,7 +1572,7 @@ void HexagonServer::printCTSPDataVerbose(
                 return false;
             }
 
-            return processReplay(c, loginToken, rfOpt.value());
+            return processReplay(c, loginToken, rfOpt.value(), &crf);
         },
 
         [&](const CTSPRequestServerStatus& ctsp)
@@ -1356,11 +1607,11 @@ void HexagonServer::printCTSPDataVerbose(
     );
 }
 
-[[nodiscard]] static std::unordered_set<std::string>
-makeSupportedLevelValidators(HGAssets& assets,
+[[nodiscard]] static LevelValidatorTable makeSupportedLevelValidators(
+    HGAssets& assets,
     const std::unordered_set<std::string>& levelValidatorWhitelist)
 {
-    std::unordered_set<std::string> result;
+    LevelValidatorTable result;
 
     for (const auto& [assetId, ld] : assets.getLevelDatas())
     {
@@ -1374,7 +1625,8 @@ makeSupportedLevelValidators(HGAssets& assets,
             if (const std::string& validator = ld.getValidator(dm);
                 levelValidatorWhitelist.contains(validator))
             {
-                result.emplace(validator);
+                result.add(
+                    Database::getOrAddLevelValidatorId(validator), validator);
             }
         }
     }
@@ -1382,6 +1634,13 @@ makeSupportedLevelValidators(HGAssets& assets,
     return result;
 }
 
+[[nodiscard]] static LeaderboardVersion makeFirstLeaderboardVersion()
+{
+    // Leave room for a million versions per second of uptime, so that versions
+    // handed out before a restart are always lower than the new ones.
+    return Utils::nowTimestamp() << 20;
+}
+
 HexagonServer::HexagonServer(HGAssets& assets, HexagonGame& hexagonGame,
     const sf::IpAddress& serverIp, const unsigned short serverPort,
     const unsigned short serverControlPort,
@@ -1390,8 +1649,7 @@ HexagonServer::HexagonServer(HGAssets& assets, HexagonGame& hexagonGame,
       _hexagonGame{hexagonGame},
       _supportedLevelValidators{
           makeSupportedLevelValidators(assets, serverLevelWhitelist)},
-      _supportedLevelValidatorsVector{
-          Utils::toVector(_supportedLevelValidators)},
+      _supportedLevelValidatorsVector{_supportedLevelValidators.toMappings()},
       _serverIp{serverIp},
       _serverPort{serverPort},
       _serverControlPort{serverControlPort},
@@ -1401,7 +1659,10 @@ HexagonServer::HexagonServer(HGAssets& assets, HexagonGame& hexagonGame,
       _running{true},
       _verbose{false},
       _serverPSKeys{generateSodiumPSKeys()},
-      _lastTokenPurge{Utils::SCClock::now()}
+      _lastTokenPurge{Utils::SCClock::now()},
+      _replayArchive{"ReplayArchive/"},
+      _leaderboardHistory{makeFirstLeaderboardVersion(),
+          leaderboardHistorySnapshots}
 {
     const auto sKeyPublic = sodiumKeyToString(_serverPSKeys.keyPublic);
     const auto sKeySecret = sodiumKeyToString(_serverPSKeys.keySecret);
@@ -1465,9 +1726,9 @@ HexagonServer::HexagonServer(HGAssets& assets, HexagonGame& hexagonGame,
         std::ostringstream oss;
         oss << "Server initialized!\nSupported levels:\n";
 
-        for (const std::string& levelValidator : _supportedLevelValidators)
+        for (const auto& [id, validator] : _supportedLevelValidatorsVector)
         {
-            oss << " - " << levelValidator << '\n';
+            oss << " - " << validator << " (" << id << ")\n";
         }
 
         SSVOH_SLOG << oss.str() << '\n';
@@ -4,7 +4,10 @@
 
 #include "SSVOpenHexagon/Core/LeaderboardCache.hpp"
 
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+
 #include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
 
 #include <chrono>
 #include <SFML/Base/Optional.hpp>
@@ -14,62 +17,215 @@
 
 namespace hg {
 
-void LeaderboardCache::receivedScores(const std::string& levelValidator,
+namespace {
+
+// Cached scores older than this are requested again.
+constexpr std::chrono::duration scoresTTL = std::chrono::seconds(6);
+
+// A request without reply for this long is considered lost.
+constexpr std::chrono::duration requestTimeout = std::chrono::seconds(5);
+
+// Only leaderboards viewed within this window are refreshed in background.
+constexpr std::chrono::duration refreshWindow = std::chrono::seconds(30);
+
+} // namespace
+
+void LeaderboardCache::enqueueRequest(const LevelValidatorId levelValidatorId)
+{
+    _pendingRequests.push_back(levelValidatorId);
+    requestedScores(levelValidatorId);
+}
+
+void LeaderboardCache::discardVersion(const LevelValidatorId levelValidatorId)
+{
+    // Forgetting the version and the receive time makes the next request ask
+    // for the whole leaderboard, while the stale scores stay visible.
+    CachedScores& cs = _levelValidatorIdToScores[levelValidatorId];
+    cs._version = noLeaderboardVersion;
+    cs._receiveTime = HRTimePoint{};
+    cs._requestTime.reset();
+}
+
+void LeaderboardCache::receivedScores(const LevelValidatorId levelValidatorId,
     const std::vector<Database::ProcessedScore>& scores)
 {
-    CachedScores& cs = _levelValidatorToScores[levelValidator];
+    CachedScores& cs = _levelValidatorIdToScores[levelValidatorId];
     cs._scores = scores;
-    cs._cacheTime = HRClock::now();
+    cs._version = noLeaderboardVersion;
+    cs._received = true;
+    cs._receiveTime = HRClock::now();
+    cs._requestTime.reset();
 }
 
-void LeaderboardCache::receivedOwnScore(
-    const std::string& levelValidator, const Database::ProcessedScore& score)
+void LeaderboardCache::receivedOwnScore(const LevelValidatorId levelValidatorId,
+    const Database::ProcessedScore& score)
 {
-    CachedScores& cs = _levelValidatorToScores[levelValidator];
+    CachedScores& cs = _levelValidatorIdToScores[levelValidatorId];
     cs._ownScore.emplace(score);
-    cs._cacheTime = HRClock::now();
+    cs._received = true;
+    cs._receiveTime = HRClock::now();
+    cs._requestTime.reset();
+}
+
+[[nodiscard]] bool LeaderboardCache::receivedScoresUnchanged(
+    const LevelValidatorId levelValidatorId, const LeaderboardVersion version)
+{
+    CachedScores& cs = _levelValidatorIdToScores[levelValidatorId];
+
+    if (!cs._received || cs._version != version)
+    {
+        discardVersion(levelValidatorId);
+        return false;
+    }
+
+    cs._receiveTime = HRClock::now();
+    cs._requestTime.reset();
+    return true;
+}
+
+[[nodiscard]] bool LeaderboardCache::receivedScoresDelta(
+    const LevelValidatorId levelValidatorId,
+    const LeaderboardVersion baseVersion, const LeaderboardVersion version,
+    const LeaderboardDelta& delta,
+    const sf::base::Optional<Database::ProcessedScore>& ownScore)
+{
+    CachedScores& cs = _levelValidatorIdToScores[levelValidatorId];
+
+    static const std::vector<Database::ProcessedScore> emptyScores;
+
+    if (baseVersion != noLeaderboardVersion &&
+        (!cs._received || cs._version != baseVersion))
+    {
+        discardVersion(levelValidatorId);
+        return false;
+    }
+
+    sf::base::Optional<std::vector<Database::ProcessedScore>> scores =
+        applyLeaderboardDelta(
+            baseVersion == noLeaderboardVersion ? emptyScores : cs._scores,
+            delta);
+
+    if (!scores.hasValue())
+    {
+        discardVersion(levelValidatorId);
+        return false;
+    }
+
+    cs._scores = SSVOH_MOVE(*scores);
+    cs._ownScore = ownScore;
+    cs._version = version;
+    cs._received = true;
+    cs._receiveTime = HRClock::now();
+    cs._requestTime.reset();
+    return true;
 }
 
-void LeaderboardCache::requestedScores(const std::string& levelValidator)
+void LeaderboardCache::requestedScores(const LevelValidatorId levelValidatorId)
 {
-    _levelValidatorToScores[levelValidator]._cacheTime = HRClock::now();
+    _levelValidatorIdToScores[levelValidatorId]._requestTime.emplace(
+        HRClock::now());
+}
+
+void LeaderboardCache::requestRejected(const LevelValidatorId levelValidatorId)
+{
+    _levelValidatorIdToScores[levelValidatorId]._requestTime.reset();
 }
 
 [[nodiscard]] bool LeaderboardCache::shouldRequestScores(
-    const std::string& levelValidator) const
+    const LevelValidatorId levelValidatorId) const
 {
-    const auto it = _levelValidatorToScores.find(levelValidator);
-    if (it == _levelValidatorToScores.end())
+    const auto it = _levelValidatorIdToScores.find(levelValidatorId);
+    if (it == _levelValidatorIdToScores.end())
     {
         return true;
     }
 
     const CachedScores& cs = it->second;
+    const HRTimePoint now = HRClock::now();
+
+    if (cs._requestTime.hasValue() &&
+        (now - *cs._requestTime) < requestTimeout)
+    {
+        return false;
+    }
+
+    return !cs._received || (now - cs._receiveTime) > scoresTTL;
+}
+
+void LeaderboardCache::prefetch(const LevelValidatorId levelValidatorId)
+{
+    _levelValidatorIdToScores[levelValidatorId]._accessTime = HRClock::now();
+
+    if (shouldRequestScores(levelValidatorId))
+    {
+        enqueueRequest(levelValidatorId);
+    }
+}
+
+void LeaderboardCache::collectScoresToRefresh()
+{
+    const HRTimePoint now = HRClock::now();
+
+    for (const auto& [levelValidatorId, cs] : _levelValidatorIdToScores)
+    {
+        if ((now - cs._accessTime) < refreshWindow &&
+            shouldRequestScores(levelValidatorId))
+        {
+            _pendingRequests.push_back(levelValidatorId);
+        }
+    }
+
+    // Not done in the loop above, as it would modify the map while iterating.
+    for (const LevelValidatorId levelValidatorId : _pendingRequests)
+    {
+        requestedScores(levelValidatorId);
+    }
+}
+
+[[nodiscard]] bool LeaderboardCache::hasPendingRequests() const noexcept
+{
+    return !_pendingRequests.empty();
+}
+
+[[nodiscard]] std::vector<CachedLeaderboardVersion>
+LeaderboardCache::takePendingRequests()
+{
+    std::vector<CachedLeaderboardVersion> result;
+    result.reserve(_pendingRequests.size());
+
+    for (const LevelValidatorId levelValidatorId : _pendingRequests)
+    {
+        result.push_back(CachedLeaderboardVersion{
+            .levelValidatorId = levelValidatorId,                           //
+            .version = _levelValidatorIdToScores[levelValidatorId]._version //
+        });
+    }
 
-    return (HRClock::now() - cs._cacheTime) > std::chrono::seconds(6);
+    _pendingRequests.clear();
+    return result;
 }
 
 [[nodiscard]] const std::vector<Database::ProcessedScore>&
-LeaderboardCache::getScores(const std::string& levelValidator) const
+LeaderboardCache::getScores(const LevelValidatorId levelValidatorId) const
 {
-    SSVOH_ASSERT(hasInformation(levelValidator));
-    return _levelValidatorToScores.at(levelValidator)._scores;
+    SSVOH_ASSERT(hasInformation(levelValidatorId));
+    return _levelValidatorIdToScores.at(levelValidatorId)._scores;
 }
 
 [[nodiscard]] const Database::ProcessedScore* LeaderboardCache::getOwnScore(
-    const std::string& levelValidator) const
+    const LevelValidatorId levelValidatorId) const
 {
-    SSVOH_ASSERT(hasInformation(levelValidator));
+    SSVOH_ASSERT(hasInformation(levelValidatorId));
 
-    const auto& os = _levelValidatorToScores.at(levelValidator)._ownScore;
+    const auto& os = _levelValidatorIdToScores.at(levelValidatorId)._ownScore;
     return os.hasValue() ? &*os : nullptr;
 }
 
 [[nodiscard]] bool LeaderboardCache::hasInformation(
-    const std::string& levelValidator) const
+    const LevelValidatorId levelValidatorId) const
 {
-    return _levelValidatorToScores.find(levelValidator) !=
-           _levelValidatorToScores.end();
+    const auto it = _levelValidatorIdToScores.find(levelValidatorId);
+    return it != _levelValidatorIdToScores.end() && it->second._received;
 }
 
 } // namespace hg
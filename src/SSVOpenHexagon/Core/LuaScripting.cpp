@@ -10,6 +10,7 @@
 #include "SSVOpenHexagon/Global/Macros.hpp"
 #include "SSVOpenHexagon/Global/Version.hpp"
 
+#include "SSVOpenHexagon/Utils/LuaBindingProfiler.hpp"
 #include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
 #include "SSVOpenHexagon/Utils/LuaMetadata.hpp"
 #include "SSVOpenHexagon/Utils/LuaMetadataProxy.hpp"
@@ -23,6 +24,7 @@
 
 #include "SSVOpenHexagon/Components/CCustomWallHandle.hpp"
 #include "SSVOpenHexagon/Components/CCustomWallManager.hpp"
+#include "SSVOpenHexagon/Components/CustomWallBatchReader.hpp"
 
 #include "SSVOpenHexagon/Utils/Concat.hpp"
 #include "SSVOpenHexagon/Utils/TypeWrapper.hpp"
@@ -30,10 +32,18 @@
 
 #include <SSVUtils/Core/Log/Log.hpp>
 
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Glsl.hpp>
 #include <SFML/Graphics/Shader.hpp>
 
+#include <SFML/System/Vector2.hpp>
+
+#include <SFML/Base/Optional.hpp>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <span>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -48,7 +58,12 @@ Utils::LuaMetadataProxy addLuaFn(
     // TODO (P2): does this handle duplicates properly? Both menu and game call
     // the same thing.
 
+#ifdef SSVOH_ENABLE_LUA_BINDING_PROFILER
+    lua.writeVariable(name, Utils::makeProfiledLuaBinding(name, SSVOH_FWD(f)));
+#else
     lua.writeVariable(name, SSVOH_FWD(f));
+#endif
+
     return Utils::LuaMetadataProxy{
         Utils::TypeWrapper<F>{}, getMetadata(), name};
 }
@@ -251,8 +266,16 @@ static void initUtils(
         .doc("Returns the string representing the current version of the game");
 }
 
+[[nodiscard]] static CustomWallBatchReader& getCustomWallBatchReader()
+{
+    thread_local CustomWallBatchReader reader;
+    return reader;
+}
+
 static void initCustomWalls(Lua::LuaContext& lua, CCustomWallManager& cwManager)
 {
+    using HandleArray = Lua::LuaContext::ArrayView<CCustomWallHandle>;
+
     addLuaFn(lua, "cw_create", //
         [&cwManager]() -> CCustomWallHandle
         { return cwManager.create([](CCustomWall&) {}); })
@@ -411,6 +434,76 @@ static void initCustomWalls(Lua::LuaContext& lua, CCustomWallManager& cwManager)
             "$4}`. More efficient than invoking `cw_setVertexColor` four times "
             "in a row.");
 
+    addLuaFn(lua, "cw_setVertexPos4Many", //
+        [&cwManager](HandleArray cwHandles,
+            Lua::LuaContext::ArrayView<float> positions)
+        {
+            CustomWallBatchReader& reader = getCustomWallBatchReader();
+
+            if (const auto p =
+                    reader.readVectors(positions, "cw_setVertexPos4Many");
+                p.hasValue())
+            {
+                cwManager.setVertexPos4Many(
+                    reader.readHandles(cwHandles), p.value());
+            }
+        })
+        .arg("cwHandles")
+        .arg("positions")
+        .doc(
+            "Given the array of custom wall handles `$0`, set the positions "
+            "of the vertices of each wall, as `cw_setVertexPos4` would. `$1` "
+            "is a flat array of eight coordinates per wall, `{x0, y0, x1, y1, "
+            "x2, y2, x3, y3}`, in the same order as `$0`. More efficient than "
+            "invoking `cw_setVertexPos4` for each wall.");
+
+    addLuaFn(lua, "cw_moveVertexPos4SameMany", //
+        [&cwManager](
+            HandleArray cwHandles, Lua::LuaContext::ArrayView<float> offsets)
+        {
+            CustomWallBatchReader& reader = getCustomWallBatchReader();
+
+            if (const auto o =
+                    reader.readVectors(offsets, "cw_moveVertexPos4SameMany");
+                o.hasValue())
+            {
+                cwManager.moveVertexPos4SameMany(
+                    reader.readHandles(cwHandles), o.value());
+            }
+        })
+        .arg("cwHandles")
+        .arg("offsets")
+        .doc(
+            "Given the array of custom wall handles `$0`, move the vertices "
+            "of each wall, as `cw_moveVertexPos4Same` would. `$1` is a flat "
+            "array of two coordinates per wall, `{offsetX, offsetY}`, in the "
+            "same order as `$0`. More efficient than invoking "
+            "`cw_moveVertexPos4Same` for each wall.");
+
+    addLuaFn(lua, "cw_setVertexColor4SameMany", //
+        [&cwManager](
+            HandleArray cwHandles, Lua::LuaContext::ArrayView<int> colors)
+        {
+            CustomWallBatchReader& reader = getCustomWallBatchReader();
+
+            if (const auto c =
+                    reader.readColors(colors, "cw_setVertexColor4SameMany");
+                c.hasValue())
+            {
+                cwManager.setVertexColor4SameMany(
+                    reader.readHandles(cwHandles), c.value());
+            }
+        })
+        .arg("cwHandles")
+        .arg("colors")
+        .doc(
+            "Given the array of custom wall handles `$0`, set the color of "
+            "the vertices of each wall, as `cw_setVertexColor4Same` would. "
+            "`$1` is a flat array of four components per wall, `{r, g, b, "
+            "a}`, in the same order as `$0`. Components are clamped to `[0, "
+            "255]`. More efficient than invoking `cw_setVertexColor4Same` for "
+            "each wall.");
+
     addLuaFn(lua, "cw_setCollision", //
         [&cwManager](CCustomWallHandle cwHandle, bool collision)
         { cwManager.setCanCollide(cwHandle, collision); })
@@ -1593,7 +1686,10 @@ static void initShaders(Lua::LuaContext& lua, HGAssets& assets,
         .arg("shaderId")
         .doc(
             "Set the currently active fragment shader for the render stage "
-            "`$0` to the shader with id `$1`.");
+            "`$0` to the shader with id `$1`. Before drawing the stage, "
+            "`onRenderStage(renderStage, fpsFactor)` is called to set up the "
+            "uniforms of the shader. If `onRenderStages(fpsFactor)` is "
+            "defined, it is called instead, once per frame for all stages.");
 }
 
 static void initConfig(Lua::LuaContext& lua)
@@ -1620,7 +1716,8 @@ void init(Lua::LuaContext& lua, random_number_generator& rng, const bool inMenu,
     const std::function<void(const std::string&)>& fRunLuaFile,
     std::vector<std::string>& execScriptPackPathContext,
     const std::function<const std::string&()>& fPackPathGetter,
-    const std::function<const PackData&()>& fGetPackData, const bool headless)
+    const std::function<const PackData&()>& fGetPackData, const bool headless,
+    const bool shadersDisabled)
 {
     initRandom(lua, rng);
     redefineIoOpen(lua);
@@ -1636,8 +1733,9 @@ void init(Lua::LuaContext& lua, random_number_generator& rng, const bool inMenu,
     initStyleControl(lua, styleData);
     initExecScript(lua, assets, fRunLuaFile, execScriptPackPathContext,
         fPackPathGetter, fGetPackData);
+    // Shader functions behave as in headless mode when shaders are disabled.
     initShaders(lua, assets, execScriptPackPathContext, fPackPathGetter,
-        fGetPackData, hexagonGameStatus, headless);
+        fGetPackData, hexagonGameStatus, headless || shadersDisabled);
     initConfig(lua);
 }
 
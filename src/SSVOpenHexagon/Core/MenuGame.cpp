@@ -37,11 +37,13 @@
 #include "SSVOpenHexagon/Utils/Concat.hpp"
 #include "SSVOpenHexagon/Utils/FontHeight.hpp"
 #include "SSVOpenHexagon/Utils/Geometry.hpp"
+#include "SSVOpenHexagon/Utils/ListView.hpp"
 #include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
 #include "SSVOpenHexagon/Utils/Match.hpp"
 #include "SSVOpenHexagon/Utils/Math.hpp"
 #include "SSVOpenHexagon/Utils/ScopeGuard.hpp"
 #include "SSVOpenHexagon/Utils/String.hpp"
+#include "SSVOpenHexagon/Utils/TextLayoutCache.hpp"
 #include "SSVOpenHexagon/Utils/Timestamp.hpp"
 #include "SSVOpenHexagon/Utils/UniquePtr.hpp"
 #include "SSVOpenHexagon/Utils/Utils.hpp"
@@ -1067,7 +1069,7 @@ void MenuGame::initLua()
         { runLuaFile(filename); }, execScriptPackPathContext,
         [this]() -> const std::string& { return levelData->packPath; },
         [this]() -> const PackData& { return *currentPack; },
-        false /* headless */);
+        false /* headless */, false /* shadersDisabled */);
 
     lua.writeVariable("u_log",
         [](const std::string& mLog) { ssvu::lo("lua-menu") << mLog << '\n'; });
@@ -1519,6 +1521,9 @@ void MenuGame::initMenus()
     advanced.create<i::Toggle>("disable game rendering",
         &Config::getDisableGameRendering, &Config::setDisableGameRendering);
 
+    advanced.create<i::Toggle>("threaded simulation",
+        &Config::getThreadedSimulation, &Config::setThreadedSimulation);
+
     //--------------------------------
     // MAIN MENU
     //--------------------------------
@@ -2503,8 +2508,6 @@ void MenuGame::exitAction()
 
 void MenuGame::update(float mFT)
 {
-    hexagonClient.update();
-
     const auto showHCEventDialogBox = [this](const bool error,
                                           const std::string& msg,
                                           const std::string& err = "")
@@ -2607,10 +2610,54 @@ void MenuGame::update(float mFT)
             },
 
             [&](const HexagonClient::EReceivedTopScores& e)
-            { leaderboardCache->receivedScores(e.levelValidator, e.scores); },
+            {
+                leaderboardCache->receivedScores(e.levelValidatorId, e.scores);
+            },
 
             [&](const HexagonClient::EReceivedOwnScore& e)
-            { leaderboardCache->receivedOwnScore(e.levelValidator, e.score); },
+            {
+                leaderboardCache->receivedOwnScore(e.levelValidatorId, e.score);
+            },
+
+            [&](const HexagonClient::EReceivedScoresUnchanged& e)
+            {
+                (void)leaderboardCache->receivedScoresUnchanged(
+                    e.levelValidatorId, e.version);
+            },
+
+            [&](const HexagonClient::EReceivedScoresDelta& e)
+            {
+                if (!leaderboardCache->receivedScoresDelta(e.levelValidatorId,
+                        e.baseVersion, e.version, e.delta, e.ownScore))
+                {
+                    ssvu::lo("hg::MenuGame::update")
+                        << "Leaderboard delta for levelValidatorId '"
+                        << e.levelValidatorId
+                        << "' does not match cached scores, discarding\n";
+                }
+            },
+
+            [&](const HexagonClient::EScoresBatchRejected& e)
+            {
+                ssvu::lo("hg::MenuGame::update")
+                    << "Server rejected '" << e.levelValidatorIds.size()
+                    << "' leaderboard requests: " << e.error << '\n';
+
+                for (const LevelValidatorId lvid : e.levelValidatorIds)
+                {
+                    leaderboardCache->requestRejected(lvid);
+                }
+            },
+
+            [&](const HexagonClient::EReplayAccepted& e)
+            {
+                ssvu::lo("hg::MenuGame::update")
+                    << "Replay accepted by server for level validator id '"
+                    << e.levelValidatorId << "', score: " << e.score << '\n';
+
+                // Only scores validated by the server count as online scores.
+                steamManager.unlock_achievement("a24_onlinescore");
+            },
 
             [&](const HexagonClient::EGameVersionMismatch&)
             {
@@ -2629,6 +2676,17 @@ void MenuGame::update(float mFT)
         );
     }
 
+    if (hexagonClient.getState() == HexagonClient::State::LoggedIn_Ready)
+    {
+        leaderboardCache->collectScoresToRefresh();
+
+        if (leaderboardCache->hasPendingRequests())
+        {
+            hexagonClient.tryRequestTopScoresAndOwnScoreBatch(
+                leaderboardCache->takePendingRequests());
+        }
+    }
+
     if (fnHGUpdateRichPresenceCallbacks)
     {
         fnHGUpdateRichPresenceCallbacks();
@@ -2932,6 +2990,48 @@ void MenuGame::update(float mFT)
     }
 }
 
+void MenuGame::prefetchLeaderboards()
+{
+    if (hexagonClient.getState() != HexagonClient::State::LoggedIn_Ready)
+    {
+        return;
+    }
+
+    // Request the leaderboards of the neighbouring levels (for all difficulty
+    // multipliers) in advance, so that they are ready when scrolling.
+    constexpr int prefetchRadius = 2;
+
+    const std::vector<std::string>& levelDataIds = *lvlDrawer->levelDataIds;
+    const int nLevels = static_cast<int>(levelDataIds.size());
+
+    for (int offset = -prefetchRadius; offset <= prefetchRadius; ++offset)
+    {
+        const int idx = lvlDrawer->currentIndex + offset;
+
+        if (idx < 0 || idx >= nLevels)
+        {
+            continue;
+        }
+
+        const LevelData& ld = assets.getLevelData(levelDataIds[idx]);
+
+        if (ld.unscored)
+        {
+            continue;
+        }
+
+        for (const float dm : ld.difficultyMults)
+        {
+            if (const sf::base::Optional<LevelValidatorId> levelValidatorId =
+                    hexagonClient.getLevelValidatorId(ld.getValidator(dm));
+                levelValidatorId.hasValue())
+            {
+                leaderboardCache->prefetch(*levelValidatorId);
+            }
+        }
+    }
+}
+
 void MenuGame::setIndex(const int mIdx)
 {
     lvlDrawer->currentIndex = mIdx;
@@ -2943,6 +3043,7 @@ void MenuGame::setIndex(const int mIdx)
     currentPack = &assets.getPackData(levelData->packId);
 
     formatLevelDescription();
+    prefetchLeaderboards();
 
     styleData = assets.getStyleData(levelData->packId, levelData->styleId);
     styleData.computeColors();
@@ -3254,9 +3355,9 @@ void MenuGame::refreshCamera()
 void MenuGame::renderText(
     const std::string& mStr, sf::Text& mText, const sf::Vector2f& mPos)
 {
-    mText.setString(mStr);
-    mText.setPosition(mPos);
-    window.draw(mText);
+    sf::Text& text = textLayoutCache.get(mText, mStr);
+    text.setPosition(mPos);
+    window.draw(text);
 }
 
 void MenuGame::renderText(const std::string& mStr, sf::Text& mText,
@@ -3291,9 +3392,9 @@ void MenuGame::renderText(const std::string& mStr, sf::Text& mText,
 void MenuGame::renderTextCentered(
     const std::string& mStr, sf::Text& mText, const sf::Vector2f& mPos)
 {
-    mText.setString(mStr);
-    mText.setPosition({mPos.x - ssvs::getGlobalHalfWidth(mText), mPos.y});
-    window.draw(mText);
+    sf::Text& text = textLayoutCache.get(mText, mStr);
+    text.setPosition({mPos.x - ssvs::getGlobalHalfWidth(text), mPos.y});
+    window.draw(text);
 }
 
 void MenuGame::renderTextCentered(const std::string& mStr, sf::Text& mText,
@@ -3326,10 +3427,10 @@ void MenuGame::renderTextCentered(const std::string& mStr, sf::Text& mText,
 void MenuGame::renderTextCenteredOffset(const std::string& mStr,
     sf::Text& mText, const sf::Vector2f& mPos, const float xOffset)
 {
-    mText.setString(mStr);
-    mText.setPosition(
-        {xOffset + mPos.x - ssvs::getGlobalHalfWidth(mText), mPos.y});
-    window.draw(mText);
+    sf::Text& text = textLayoutCache.get(mText, mStr);
+    text.setPosition(
+        {xOffset + mPos.x - ssvs::getGlobalHalfWidth(text), mPos.y});
+    window.draw(text);
 }
 
 void MenuGame::renderTextCenteredOffset(const std::string& mStr,
@@ -3828,9 +3929,12 @@ void MenuGame::drawOptionsSubmenus(
 
         if (!items[i]->isEnabled())
         {
+            const sf::Text& itemText =
+                textLayoutCache.get(txtMenuSmall.font, itemName);
+
             renderText("[OFFICIAL MODE ENABLED]", txtMenuTiny.font,
-                {ssvs::getGlobalRight(txtMenuSmall.font) + 6.f,
-                    ssvs::getGlobalTop(txtMenuSmall.font) - 2.f},
+                {ssvs::getGlobalRight(itemText) + 6.f,
+                    ssvs::getGlobalTop(itemText) - 2.f},
                 sf::Color{150, 150, 150, 255});
         }
 
@@ -4336,28 +4440,10 @@ void MenuGame::scrollNameRightBorder(std::string& text, const std::string key,
     sf::Text& font, float& scroller, float border)
 {
     // Store length of the key
-    font.setString(key);
-    const float keyWidth = ssvs::getGlobalWidth(font);
+    const float keyWidth =
+        ssvs::getGlobalWidth(textLayoutCache.get(font, key));
 
-    Utils::uppercasify(text);
-    font.setString(text);
-
-    // If the text is already within border format and return
-    border -= keyWidth;
-    if (ssvs::getGlobalWidth(font) <= border)
-    {
-        text = key + text;
-        return;
-    }
-
-    // Scroll the name and shrink it to the required length
-    scrollName(text, scroller);
-    font.setString(text);
-    while (ssvs::getGlobalWidth(font) > border && text.length() > 1)
-    {
-        text.pop_back();
-        font.setString(text);
-    }
+    scrollNameRightBorder(text, font, scroller, border - keyWidth);
     text = key + text;
 }
 
@@ -4365,19 +4451,27 @@ void MenuGame::scrollNameRightBorder(
     std::string& text, sf::Text& font, float& scroller, const float border)
 {
     Utils::uppercasify(text);
-    font.setString(text);
 
-    if (ssvs::getGlobalWidth(font) <= border)
+    // The full name does not change between frames, so its layout is cached.
+    if (ssvs::getGlobalWidth(textLayoutCache.get(font, text)) <= border)
     {
         return;
     }
 
+    // The scrolled prefixes change every frame, so they are measured on the
+    // prototype itself instead of filling the cache. Only the final string is
+    // cached, when it is rendered.
+    const auto getWidth = [&font](const std::string& str)
+    {
+        font.setString(str);
+        return ssvs::getGlobalWidth(font);
+    };
+
+    // Scroll the name and shrink it to the required length
     scrollName(text, scroller);
-    font.setString(text);
-    while (ssvs::getGlobalWidth(font) > border && text.length() > 1)
+    while (getWidth(text) > border && text.length() > 1)
     {
         text.pop_back();
-        font.setString(text);
     }
 }
 
@@ -4811,6 +4905,29 @@ void MenuGame::changeFavoriteLevelsToProfile()
 }
 
 
+[[nodiscard]] const MenuGame::LevelRowLabels& MenuGame::getLevelRowLabels(
+    const std::string& levelId, const LevelData& levelData)
+{
+    LevelRowLabels& labels = levelRowLabels[levelId];
+
+    // Level data can change when assets are reloaded.
+    if (labels.sourceName != levelData.name)
+    {
+        labels.sourceName = levelData.name;
+        labels.name = levelData.name;
+        Utils::uppercasify(labels.name);
+    }
+
+    if (labels.sourceAuthor != levelData.author)
+    {
+        labels.sourceAuthor = levelData.author;
+        labels.author = levelData.author;
+        Utils::uppercasify(labels.author);
+    }
+
+    return labels;
+}
+
 [[nodiscard]] bool MenuGame::isFavoriteLevels() const
 {
     return lvlDrawer->isFavorites;
@@ -4958,7 +5075,6 @@ void MenuGame::drawLevelSelectionRightSide(
     const float packLabelOffset{w * 0.33f - outerFrame};
     const float quadsIndent{w - packLabelOffset};
     const float txtIndent{w - packLabelOffset / 2.f};
-    const float levelIndent{quadsIndent + outerFrame};
     const float panelOffset{
         calcMenuOffset(drawer.XOffset, w - quadsIndent, revertOffset)};
 
@@ -4976,7 +5092,7 @@ void MenuGame::drawLevelSelectionRightSide(
     }
 
     static std::string tempString;
-    float prevLevelIndent{0.f}, height{0.f};
+    float height{0.f};
     sf::Vector2f topLeft, topRight, bottomRight, bottomLeft;
 
     // The drawing order is: levels list then pack labels.
@@ -4999,16 +5115,21 @@ void MenuGame::drawLevelSelectionRightSide(
     sf::Color alphaTextColor{
         menuTextColor.r, menuTextColor.g, menuTextColor.b, 150};
     txtSelectionMedium.font.setFillColor(menuTextColor);
-    height = packLabelHeight * (isFavoriteLevels() ? 1 : drawer.packIdx + 1) +
-             slctFrameSize - packChangeOffset + drawer.YOffset;
+    const float listTop =
+        packLabelHeight * (isFavoriteLevels() ? 1 : drawer.packIdx + 1) +
+        slctFrameSize - packChangeOffset + drawer.YOffset;
 
-    for (i = 0; i < levelsSize; ++i)
+    const auto getLevelIndent = [&](const int idx)
     {
-        //-------------------------------------
-        // Quads
-        menuQuads.clear();
-        menuQuads.reserve_quad(3);
+        return quadsIndent + panelOffset -
+               (focusHeld ? 0.f : drawer.lvlOffsets[idx]);
+    };
 
+    // The selection animation runs for all the levels, but only the rows
+    // that intersect the window are laid out and drawn. Large packs cost
+    // the same as small ones.
+    for (i = 0; i < levelsSize; ++i)
+    {
         // If the list is folding give all level labels the same alignment
         if (packChangeState != PackChange::Rest)
         {
@@ -5018,17 +5139,28 @@ void MenuGame::drawLevelSelectionRightSide(
         {
             calcMenuItemOffset(drawer.lvlOffsets[i], i == drawer.currentIndex);
         }
+    }
 
-        float indent = quadsIndent + panelOffset;
-        if (!focusHeld)
-        {
-            indent -= drawer.lvlOffsets[i];
-        }
+    const Utils::RowRange visibleRows = Utils::getVisibleRows(listTop,
+        levelLabelHeight, static_cast<std::size_t>(levelsSize), 0.f, h);
+
+    //-------------------------------------
+    // Quads, all the visible rows in a single batch
+
+    visibleLevelRows.clear();
+    menuQuads.clear();
+    menuQuads.reserve_quad(3 * visibleRows.size() + 1);
+
+    for (i = static_cast<int>(visibleRows.begin);
+         i < static_cast<int>(visibleRows.end); ++i)
+    {
+        height = listTop + levelLabelHeight * i;
+        const float indent = getLevelIndent(i);
 
         // Top frame
         if (i > 0 && drawer.lvlOffsets[i - 1] > drawer.lvlOffsets[i])
         {
-            createQuad(menuQuadColor, prevLevelIndent, w, height,
+            createQuad(menuQuadColor, getLevelIndent(i - 1), w, height,
                 height + slctFrameSize);
         }
         else
@@ -5069,85 +5201,90 @@ void MenuGame::drawLevelSelectionRightSide(
             }
         }
 
-        window.draw(menuQuads);
-        prevLevelIndent = indent;
+        const std::string& levelId = drawer.levelDataIds->at(i);
+        const LevelData& levelData = assets.getLevelData(levelId);
 
-        //-------------------------------------
-        // Level data
-        const LevelData* const levelData{
-            &assets.getLevelData(drawer.levelDataIds->at(i))};
-        if (levelData == nullptr)
-        {
-            continue;
-        }
-
-        //-------------------------------------
-        // Level name
-
-        indent = levelIndent + panelOffset;
-        if (!focusHeld)
-        {
-            indent -= drawer.lvlOffsets[i];
-        }
-        height += textToQuadBorder;
-
-        tempString = focusHeld ? "..." : levelData->name;
-        Utils::uppercasify(tempString);
-
-        const sf::Color c0 = mouseOverlapColor(mouseOverlap, menuQuadColor);
-
-        const auto currentDiffMult = levelData->getNthDiffMult(diffMultIdx);
         const std::string& levelValidator =
-            levelData->getValidator(currentDiffMult);
+            levelData.getValidator(levelData.getNthDiffMult(diffMultIdx));
+
+        const bool ranked =
+            !levelData.unscored &&
+            hexagonClient.isLevelSupportedByServer(levelValidator);
+
+        visibleLevelRows.push_back(VisibleLevelRow{
+            .labels = &getLevelRowLabels(levelId, levelData), //
+            .top = height,                                    //
+            .textIndent = indent + outerFrame,                //
+            .bodyColor = c,                                   //
+            .mouseOverlap = mouseOverlap,                     //
+            .ranked = ranked                                  //
+        });
+    }
 
-        renderText(tempString, txtSelectionBig.font,
-            {indent, height - txtSelectionBig.height * fontHeightOffset}, c0);
+    // Bottom frame for the last element
+    height = listTop + levelLabelHeight * levelsSize;
+    createQuad(menuQuadColor,
+        levelsSize > 0 ? getLevelIndent(levelsSize - 1) : 0.f, w, height,
+        height + slctFrameSize);
 
-        if (!levelData->unscored &&
-            hexagonClient.isLevelSupportedByServer(levelValidator))
-        {
-            const float padding = 5.f;
-            const float width = 50.f;
+    window.draw(menuQuads);
 
-            menuQuads.clear();
-            menuQuads.reserve_quad(1);
+    //-------------------------------------
+    // Level names and authors
 
-            createQuad(menuQuadColor, w - width - padding, w,
-                height - textToQuadBorder,
-                height - textToQuadBorder + txtSelectionRanked.height +
-                    padding + 1.f);
+    for (const VisibleLevelRow& row : visibleLevelRows)
+    {
+        const sf::Color c = mouseOverlapColor(row.mouseOverlap, menuQuadColor);
+        const float nameTop = row.top + textToQuadBorder;
 
-            window.draw(menuQuads);
+        renderText(focusHeld ? "..." : row.labels->name, txtSelectionBig.font,
+            {row.textIndent,
+                nameTop - txtSelectionBig.height * fontHeightOffset},
+            c);
 
-            renderText("RANKED", txtSelectionRanked.font,
-                {w - width, height -
-                                txtSelectionRanked.height * fontHeightOffset -
-                                3.f},
-                mouseOverlapColor(mouseOverlap, c));
-        }
+        const float authorTop =
+            nameTop + txtSelectionBig.height + textToQuadBorder;
 
-        //-------------------------------------
-        // Author
-        height += txtSelectionBig.height + textToQuadBorder;
+        renderText(focusHeld ? "..." : row.labels->author,
+            txtSelectionSmall.font,
+            {row.textIndent,
+                authorTop - txtSelectionSmall.height * fontHeightOffset},
+            c);
+    }
 
-        tempString = focusHeld ? "..." : levelData->author;
-        Utils::uppercasify(tempString);
+    //-------------------------------------
+    // Ranked badges, drawn above the names
 
-        const sf::Color c1 = mouseOverlapColor(mouseOverlap, menuQuadColor);
+    constexpr float rankedPadding = 5.f;
+    constexpr float rankedWidth = 50.f;
 
-        renderText(tempString, txtSelectionSmall.font,
-            {indent, height - txtSelectionSmall.height * fontHeightOffset}, c1);
+    menuQuads.clear();
+    menuQuads.reserve_quad(visibleLevelRows.size());
 
-        height += txtSelectionSmall.height + textToQuadBorder - slctFrameSize;
+    for (const VisibleLevelRow& row : visibleLevelRows)
+    {
+        if (row.ranked)
+        {
+            createQuad(menuQuadColor, w - rankedWidth - rankedPadding, w,
+                row.top,
+                row.top + txtSelectionRanked.height + rankedPadding + 1.f);
+        }
     }
 
-    // Bottom frame for the last element
-    menuQuads.clear();
-    menuQuads.reserve_quad(1);
-    createQuad(
-        menuQuadColor, prevLevelIndent, w, height, height + slctFrameSize);
     window.draw(menuQuads);
 
+    for (const VisibleLevelRow& row : visibleLevelRows)
+    {
+        if (row.ranked)
+        {
+            renderText("RANKED", txtSelectionRanked.font,
+                {w - rankedWidth,
+                    row.top + textToQuadBorder -
+                        txtSelectionRanked.height * fontHeightOffset - 3.f},
+                mouseOverlapColor(row.mouseOverlap, row.bodyColor));
+        }
+    }
+
     height += slctFrameSize;
     i = ssvu::getMod(drawer.packIdx + 1, packsSize);
     if (i == 0)
@@ -5395,9 +5532,13 @@ void MenuGame::drawLevelSelectionLeftSide(
     txtSelectionMedium.font.setScale(
         {difficultyBumpFactor, difficultyBumpFactor});
 
+    const float difficultyLabelHeight =
+        textLayoutCache.get(txtSelectionMedium.font, "DIFFICULTY: ")
+            .getGlobalBounds()
+            .size.y;
+
     renderText(tempString, txtSelectionMedium.font,
-        {textXPos + txtSelectionMedium.font.getGlobalBounds().size.y,
-            difficultyHeight});
+        {textXPos + difficultyLabelHeight, difficultyHeight});
 
     txtSelectionMedium.font.setScale({1.f, 1.f});
 
@@ -5589,18 +5730,20 @@ void MenuGame::drawLevelSelectionLeftSide(
 
     height += txtSelectionSmall.height;
 
-    const std::string& levelValidator = levelData.getValidator(currentDiffMult);
+    const sf::base::Optional<LevelValidatorId> levelValidatorId =
+        hexagonClient.getLevelValidatorId(
+            levelData.getValidator(currentDiffMult));
 
     if (!levelData.unscored &&
         hexagonClient.getState() == HexagonClient::State::LoggedIn_Ready &&
-        hexagonClient.isLevelSupportedByServer(levelValidator) &&
-        leaderboardCache->shouldRequestScores(levelValidator))
+        levelValidatorId.hasValue())
     {
-        hexagonClient.tryRequestTopScoresAndOwnScore(levelValidator);
-        leaderboardCache->requestedScores(levelValidator);
+        leaderboardCache->prefetch(*levelValidatorId);
     }
 
-    const bool gotScoreInfo = leaderboardCache->hasInformation(levelValidator);
+    const bool gotScoreInfo =
+        levelValidatorId.hasValue() &&
+        leaderboardCache->hasInformation(*levelValidatorId);
 
     if (levelData.unscored)
     {
@@ -5615,7 +5758,7 @@ void MenuGame::drawLevelSelectionLeftSide(
             {textToQuadBorder - panelOffset,
                 height - txtSelectionSmall.height * fontHeightOffset});
     }
-    else if (!hexagonClient.isLevelSupportedByServer(levelValidator))
+    else if (!levelValidatorId.hasValue())
     {
         renderText("THIS LEVEL IS NOT SUPPORTED BY THE SERVER",
             txtSelectionSmall.font,
@@ -5632,7 +5775,7 @@ void MenuGame::drawLevelSelectionLeftSide(
     {
         SSVOH_ASSERT(!levelData.unscored);
         SSVOH_ASSERT(gotScoreInfo);
-        SSVOH_ASSERT(hexagonClient.isLevelSupportedByServer(levelValidator));
+        SSVOH_ASSERT(levelValidatorId.hasValue());
         SSVOH_ASSERT(
             hexagonClient.getState() == HexagonClient::State::LoggedIn_Ready);
 
@@ -5679,7 +5822,7 @@ void MenuGame::drawLevelSelectionLeftSide(
 
         if (gotScoreInfo)
         {
-            const auto scores = leaderboardCache->getScores(levelValidator);
+            const auto scores = leaderboardCache->getScores(*levelValidatorId);
 
             if (!scores.empty())
             {
@@ -5721,7 +5864,7 @@ void MenuGame::drawLevelSelectionLeftSide(
         if (gotScoreInfo)
         {
             const auto* ownScore =
-                leaderboardCache->getOwnScore(levelValidator);
+                leaderboardCache->getOwnScore(*levelValidatorId);
 
             if (ownScore == nullptr)
             {
@@ -5760,6 +5903,8 @@ void MenuGame::draw()
         resetNamesScrolls();
     }
 
+    textLayoutCache.nextFrame();
+
     styleData.computeColors();
     window.clear(sf::Color{0, 0, 0, 255});
 
@@ -6039,18 +6184,17 @@ void MenuGame::drawOnlineStatus()
             case HexagonClient::State::LoggedIn: [[fallthrough]];
             case HexagonClient::State::LoggedIn_Ready:
             {
-                if (Config::getSaveLastLoginUsername() &&
-                    hexagonClient.getLoginName().hasValue())
+                // The login name is shared with the client's I/O thread, take
+                // a single copy so that the checks below are consistent.
+                const auto name = hexagonClient.getLoginName();
+
+                if (Config::getSaveLastLoginUsername() && name.hasValue())
                 {
                     // Save last login username for quicker login next time.
-
-                    Config::setLastLoginUsername(
-                        hexagonClient.getLoginName().value());
+                    Config::setLastLoginUsername(*name);
                 }
 
-                return {
-                    true, "LOGGED IN AS " +
-                              hexagonClient.getLoginName().valueOr("UNKNOWN")};
+                return {true, "LOGGED IN AS " + name.valueOr("UNKNOWN")};
             }
         }
 
@@ -9,6 +9,8 @@
 
 #include <random>
 
+#include <cstdint>
+
 namespace hg {
 
 random_number_generator::random_number_generator(const seed_type seed) noexcept
@@ -23,4 +25,11 @@ random_number_generator::seed() const noexcept
     return _seed;
 }
 
+[[nodiscard]] std::uint32_t
+random_number_generator::state_fingerprint() const noexcept
+{
+    engine_type copy = _rng;
+    return static_cast<std::uint32_t>(copy());
+}
+
 } // namespace hg
@@ -74,6 +74,16 @@ static auto make_read(deserialization_result& result, const std::byte*& buffer,
     };
 }
 
+void replay_data::clear() noexcept
+{
+    _inputs.clear();
+}
+
+void replay_data::reserve(const std::size_t n)
+{
+    _inputs.reserve(n);
+}
+
 void replay_data::record_input(const bool left, const bool right,
     const bool swap, const bool focus) noexcept
 {
@@ -167,6 +177,125 @@ void replay_data::record_input(const bool left, const bool right,
     return result;
 }
 
+// Marks the beginning of the optional state hash section of a replay file.
+static constexpr std::uint32_t state_hashes_tag{0x48534853}; // "SHSH"
+
+void replay_state_hashes::clear() noexcept
+{
+    _interval = 0;
+    _hashes.clear();
+}
+
+void replay_state_hashes::reserve(const std::size_t n)
+{
+    _hashes.reserve(n);
+}
+
+void replay_state_hashes::set_interval(const std::uint32_t interval) noexcept
+{
+    _interval = interval;
+}
+
+void replay_state_hashes::record_hash(const std::uint64_t hash)
+{
+    SSVOH_ASSERT(_interval > 0);
+    _hashes.emplace_back(hash);
+}
+
+[[nodiscard]] std::uint32_t replay_state_hashes::interval() const noexcept
+{
+    return _interval;
+}
+
+[[nodiscard]] std::uint64_t replay_state_hashes::at(
+    const std::size_t index) const noexcept
+{
+    SSVOH_ASSERT(index < size());
+    return _hashes[index];
+}
+
+[[nodiscard]] std::size_t replay_state_hashes::size() const noexcept
+{
+    return _hashes.size();
+}
+
+[[nodiscard]] bool replay_state_hashes::empty() const noexcept
+{
+    return _hashes.empty();
+}
+
+[[nodiscard]] bool replay_state_hashes::operator==(
+    const replay_state_hashes& rhs) const noexcept
+{
+    return _interval == rhs._interval && _hashes == rhs._hashes;
+}
+
+[[nodiscard]] bool replay_state_hashes::operator!=(
+    const replay_state_hashes& rhs) const noexcept
+{
+    return !(*this == rhs);
+}
+
+[[nodiscard]] serialization_result replay_state_hashes::serialize(
+    std::byte* buffer, const std::byte* const buffer_end) const
+{
+    serialization_result result;
+    const auto write = make_write(result, buffer, buffer_end);
+
+    const std::uint64_t n_hashes = _hashes.size();
+
+    SSVOH_TRY(write(_interval));
+    SSVOH_TRY(write(n_hashes));
+
+    for (const std::uint64_t hash : _hashes)
+    {
+        SSVOH_TRY(write(hash));
+    }
+
+    return result;
+}
+
+[[nodiscard]] deserialization_result replay_state_hashes::deserialize(
+    const std::byte* buffer, const std::byte* const buffer_end)
+{
+    deserialization_result result;
+    const auto read = make_read(result, buffer, buffer_end);
+
+    std::uint64_t n_hashes;
+
+    SSVOH_TRY(read(_interval));
+    SSVOH_TRY(read(n_hashes));
+
+    // Reject sizes that cannot possibly fit in the remaining buffer before
+    // allocating anything.
+    if ((_interval == 0 && n_hashes > 0) ||
+        n_hashes > static_cast<std::uint64_t>(buffer_end - buffer) /
+                       sizeof(std::uint64_t))
+    {
+        result._success = false;
+        return result;
+    }
+
+    _hashes.resize(n_hashes);
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    for (std::uint64_t i = 0; i < n_hashes; ++i)
+    {
+        std::uint64_t hash;
+        SSVOH_TRY(read(hash));
+
+        _hashes[i] = hash;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    return result;
+}
+
 replay_player::replay_player(const replay_data& rd) noexcept
     : _replay_data{rd}, _current_index{0}
 {}
@@ -204,7 +333,8 @@ void replay_player::reset() noexcept
            _level_id == rhs._level_id &&               //
            _first_play == rhs._first_play &&           //
            _difficulty_mult == rhs._difficulty_mult && //
-           _played_score == rhs._played_score;
+           _played_score == rhs._played_score &&       //
+           _state_hashes == rhs._state_hashes;
 }
 
 [[nodiscard]] bool replay_file::operator!=(
@@ -265,6 +395,25 @@ void replay_player::reset() noexcept
     SSVOH_TRY(write(_difficulty_mult));
     SSVOH_TRY(write(_played_score));
 
+    // Optional trailing section, omitted when empty so that replays without
+    // state hashes keep the original format.
+    if (_state_hashes.empty())
+    {
+        return result;
+    }
+
+    SSVOH_TRY(write(state_hashes_tag));
+
+    const serialization_result hashes_result =
+        _state_hashes.serialize(buffer, buffer_end);
+
+    if (!hashes_result._success)
+    {
+        result._success = false;
+        return result;
+    }
+
+    result._written_bytes += hashes_result._written_bytes;
     return result;
 }
 
@@ -321,6 +470,32 @@ void replay_player::reset() noexcept
     SSVOH_TRY(read(_difficulty_mult));
     SSVOH_TRY(read(_played_score));
 
+    // Replays recorded before the state hash section existed end here.
+    _state_hashes.clear();
+
+    std::uint32_t tag{0};
+    if (buffer + sizeof(tag) <= buffer_end)
+    {
+        std::memcpy(&tag, buffer, sizeof(tag));
+    }
+
+    if (tag != state_hashes_tag)
+    {
+        return result;
+    }
+
+    SSVOH_TRY(read(tag));
+
+    const deserialization_result hashes_result =
+        _state_hashes.deserialize(buffer, buffer_end);
+
+    if (!hashes_result._success)
+    {
+        result._success = false;
+        return result;
+    }
+
+    result._read_bytes += hashes_result._read_bytes;
     return result;
 }
 
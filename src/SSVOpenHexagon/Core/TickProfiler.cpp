@@ -0,0 +1,131 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
+
+#include "SSVOpenHexagon/Global/Assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+#include <cstddef>
+
+namespace hg {
+
+[[nodiscard]] const char* getTickStageName(const TickStage stage) noexcept
+{
+    constexpr std::array<const char*, tickStageCount> names{
+        "update",              //
+        "  onUpdate (Lua)",    //
+        "  timelineRunner",    //
+        "  customTimelines",   //
+        "  updateWalls",       //
+        "  updateCustomWalls", //
+        "  updatePulse3D",     //
+        "postUpdate",          //
+        "draw",                //
+        "  background",        //
+        "  walls/player",      //
+        "  3D layers",         //
+        "  render",            //
+        "  text",              //
+        "luaGC",               //
+        "tick interval",       //
+        "tick jitter"          //
+    };
+
+    SSVOH_ASSERT(stage < TickStage::Count);
+    return names[static_cast<std::size_t>(stage)];
+}
+
+void TickProfiler::recordTickStart(
+    const HRTimePoint now, const float expectedMs) noexcept
+{
+    if (_hasLastTickStart)
+    {
+        const float intervalMs =
+            std::chrono::duration<float, std::milli>(now - _lastTickStart)
+                .count();
+
+        record(TickStage::TickInterval, intervalMs);
+        record(TickStage::TickJitter, std::abs(intervalMs - expectedMs));
+    }
+
+    _lastTickStart = now;
+    _hasLastTickStart = true;
+}
+
+void TickProfiler::clear() noexcept
+{
+    for (StageSamples& s : _stages)
+    {
+        s._next = 0;
+        s._size = 0;
+    }
+
+    _hasLastTickStart = false;
+}
+
+[[nodiscard]] TickProfiler::Stats TickProfiler::getStats(
+    const TickStage stage) const
+{
+    const StageSamples& s = _stages[static_cast<std::size_t>(stage)];
+
+    if (s._size == 0)
+    {
+        return Stats{.samples = 0, .minMs = 0.f, .avgMs = 0.f, .p99Ms = 0.f};
+    }
+
+    std::array<float, sampleCount> sorted;
+    std::copy_n(s._samplesMs.begin(), s._size, sorted.begin());
+
+    float minMs = sorted[0];
+    float sumMs = 0.f;
+
+    for (std::size_t i = 0; i < s._size; ++i)
+    {
+        minMs = std::min(minMs, sorted[i]);
+        sumMs += sorted[i];
+    }
+
+    // Nearest-rank percentile.
+    const std::size_t p99Index = (s._size * 99 + 99) / 100 - 1;
+    std::nth_element(
+        sorted.begin(), sorted.begin() + p99Index, sorted.begin() + s._size);
+
+    return Stats{
+        .samples = s._size,                           //
+        .minMs = minMs,                               //
+        .avgMs = sumMs / static_cast<float>(s._size), //
+        .p99Ms = sorted[p99Index]                     //
+    };
+}
+
+void TickProfiler::dump(std::ostream& os) const
+{
+    char buf[128];
+
+    std::snprintf(buf, sizeof(buf), "%-22s %8s %10s %10s %10s\n", "stage",
+        "samples", "min ms", "avg ms", "p99 ms");
+
+    os << buf;
+
+    for (std::size_t i = 0; i < tickStageCount; ++i)
+    {
+        const TickStage stage = static_cast<TickStage>(i);
+        const Stats stats = getStats(stage);
+
+        std::snprintf(buf, sizeof(buf), "%-22s %8zu %10.4f %10.4f %10.4f\n",
+            getTickStageName(stage), stats.samples, stats.minMs, stats.avgMs,
+            stats.p99Ms);
+
+        os << buf;
+    }
+}
+
+} // namespace hg
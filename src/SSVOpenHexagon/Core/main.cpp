@@ -92,6 +92,7 @@ struct ParsedArgs
     bool printLuaDocs{false};
     bool headless{false};
     bool server{false};
+    bool profile{false};
 };
 
 [[nodiscard]] ParsedArgs parseArgs(const int argc, char* argv[])
@@ -137,6 +138,13 @@ struct ParsedArgs
             continue;
         }
 
+        // Find command-line argument to dump tick timings on death
+        if (!std::strcmp(argv[i], "-profile"))
+        {
+            result.profile = true;
+            continue;
+        }
+
         result.args.emplace_back(argv[i]);
     }
 
@@ -252,7 +260,7 @@ getFirstCompressedReplayFilenameFromArgs(const std::vector<std::string>& args)
 // Client main entrypoint
 // ----------------------------------------------------------------------------
 
-[[nodiscard]] int mainClient(const bool headless,
+[[nodiscard]] int mainClient(const bool headless, const bool profile,
     const std::vector<std::string>& args,
     const sf::base::Optional<std::string>& cliLevelName,
     const sf::base::Optional<std::string>& cliLevelPack)
@@ -441,6 +449,18 @@ getFirstCompressedReplayFilenameFromArgs(const std::vector<std::string>& args)
         &hc                                                        //
     };
 
+    if (profile)
+    {
+#if defined(SSVOH_ENABLE_TICK_PROFILER) || \
+    defined(SSVOH_ENABLE_LUA_BINDING_PROFILER)
+        hg.setDumpProfilesOnDeath(true);
+#else
+        ssvu::lo("::mainClient")
+            << "'-profile' ignored, built without SSVOH_ENABLE_TICK_PROFILER "
+               "or SSVOH_ENABLE_LUA_BINDING_PROFILER\n";
+#endif
+    }
+
     //
     //
     // ------------------------------------------------------------------------
@@ -679,7 +699,7 @@ int main(int argc, char* argv[])
     // ------------------------------------------------------------------------
     // Parse command line arguments
     const auto [args, cliLevelName, cliLevelPack, printLuaDocs, headlessB,
-        server] = parseArgs(argc, argv);
+        server, profile] = parseArgs(argc, argv);
     const auto headless = headlessB; // Workaround binding capture
 
     //
@@ -706,5 +726,5 @@ int main(int argc, char* argv[])
     // Client mode
     SSVOH_ASSERT(!printLuaDocs);
     SSVOH_ASSERT(!server);
-    return mainClient(headless, args, cliLevelName, cliLevelPack);
+    return mainClient(headless, profile, args, cliLevelName, cliLevelPack);
 }
@@ -195,12 +195,38 @@ void StyleData::computeColors()
     }
 }
 
+const std::vector<sf::Vector2f>& StyleData::getSectorEdges(
+    const unsigned int sides) const
+{
+    if (sectorEdges.size() == sides * 2 && sectorEdgesRotOff == BGRotOff)
+    {
+        return sectorEdges;
+    }
+
+    const float div{Utils::tau / sides * 1.0001f};
+    const float halfDiv{div / 2.f};
+
+    sectorEdges.clear();
+    sectorEdges.reserve(sides * 2);
+    sectorEdgesRotOff = BGRotOff;
+
+    for (auto i(0u); i < sides; ++i)
+    {
+        const float angle{Utils::toRad(BGRotOff) + div * i};
+
+        sectorEdges.emplace_back(
+            sf::Vector2f::Zero.movedTowards(1.f, sf::radians(angle + halfDiv)));
+        sectorEdges.emplace_back(
+            sf::Vector2f::Zero.movedTowards(1.f, sf::radians(angle - halfDiv)));
+    }
+
+    return sectorEdges;
+}
+
 void StyleData::drawBackgroundImpl(Utils::FastVertexVectorTris& vertices,
     const sf::Vector2f& mCenterPos, const unsigned int sides,
     const bool darkenUnevenBackgroundChunk, const bool blackAndWhite) const
 {
-    const float div{Utils::tau / sides * 1.0001f};
-    const float halfDiv{div / 2.f};
     const float distance{bgTileRadius};
 
     const std::vector<sf::Color>& colors(getColors());
@@ -209,9 +235,10 @@ void StyleData::drawBackgroundImpl(Utils::FastVertexVectorTris& vertices,
         return;
     }
 
+    const std::vector<sf::Vector2f>& edges(getSectorEdges(sides));
+
     for (auto i(0u); i < sides; ++i)
     {
-        const float angle{Utils::toRad(BGRotOff) + div * i};
         sf::Color currentColor{ssvu::getByModIdx(colors, i)};
 
         const bool mustDarkenUnevenBackgroundChunk =
@@ -227,8 +254,8 @@ void StyleData::drawBackgroundImpl(Utils::FastVertexVectorTris& vertices,
         }
 
         vertices.batch_unsafe_emplace_back(currentColor, mCenterPos,
-            mCenterPos.movedTowards(distance, sf::radians(angle + halfDiv)),
-            mCenterPos.movedTowards(distance, sf::radians(angle - halfDiv)));
+            mCenterPos + edges[i * 2] * distance,
+            mCenterPos + edges[i * 2 + 1] * distance);
     }
 }
 
@@ -237,8 +264,6 @@ void StyleData::drawBackgroundMenuHexagonImpl(
     const unsigned int sides, const bool fourByThree,
     const bool blackAndWhite) const
 {
-    const float div{Utils::tau / sides * 1.0001f};
-    const float halfDiv{div / 2.f};
     const float hexagonRadius{fourByThree ? 75.f : 100.f};
 
     const sf::Color& colorMain{
@@ -246,21 +271,20 @@ void StyleData::drawBackgroundMenuHexagonImpl(
     const sf::Color colorCap{
         blackAndWhite ? sf::Color::Black : getCapColorResult()};
 
+    const std::vector<sf::Vector2f>& edges(getSectorEdges(sides));
+
     for (auto i(0u); i < sides; ++i)
     {
-        const float angle{Utils::toRad(BGRotOff) + div * i};
+        const sf::Vector2f& edgeA = edges[i * 2];
+        const sf::Vector2f& edgeB = edges[i * 2 + 1];
 
         vertices.batch_unsafe_emplace_back(colorMain, mCenterPos,
-            mCenterPos.movedTowards(
-                hexagonRadius + 10.f, sf::radians(angle + halfDiv)),
-            mCenterPos.movedTowards(
-                hexagonRadius + 10.f, sf::radians(angle - halfDiv)));
+            mCenterPos + edgeA * (hexagonRadius + 10.f),
+            mCenterPos + edgeB * (hexagonRadius + 10.f));
 
         vertices.batch_unsafe_emplace_back(colorCap, mCenterPos,
-            mCenterPos.movedTowards(
-                hexagonRadius, sf::radians(angle + halfDiv)),
-            mCenterPos.movedTowards(
-                hexagonRadius, sf::radians(angle - halfDiv)));
+            mCenterPos + edgeA * hexagonRadius,
+            mCenterPos + edgeB * hexagonRadius);
     }
 }
 
@@ -369,6 +369,7 @@ using cil = std::initializer_list<cmb>;
     X(showSwapBlinkingEffect, bool, "show_swap_blinking_effect", true)     \
     X(useLuaFileCache, bool, "use_lua_file_cache", false)                  \
     X(disableGameRendering, bool, "disable_game_rendering", false)         \
+    X(threadedSimulation, bool, "threaded_simulation", false)              \
     X_LINKEDVALUES_BINDS
 
 // TODO: enable cache on server
@@ -961,6 +962,11 @@ void setDisableGameRendering(bool x)
     disableGameRendering() = x;
 }
 
+void setThreadedSimulation(bool x)
+{
+    threadedSimulation() = x;
+}
+
 [[nodiscard]] bool getOfficial()
 {
     return official();
@@ -1351,6 +1357,11 @@ void setDisableGameRendering(bool x)
     return disableGameRendering();
 }
 
+[[nodiscard]] bool getThreadedSimulation()
+{
+    return threadedSimulation();
+}
+
 //***********************************************************
 //
 // KEYBOARD/MOUSE BINDS
@@ -37,12 +37,73 @@ namespace hg::Database {
 
 namespace Impl {
 
+// Schema version 1: level validators are interned into the `levelValidators`
+// table and scores reference them by id (`scoresV2`). The legacy `scores` table
+// is only kept around to migrate old databases.
+constexpr int schemaVersion = 1;
+
+template <typename Storage>
+[[nodiscard]] std::uint32_t getOrAddLevelValidatorIdImpl(
+    Storage& storage, const std::string& validator)
+{
+    using namespace sqlite_orm;
+
+    const auto query = storage.template get_all<LevelValidator>(
+        where(validator == c(&LevelValidator::validator)));
+
+    if (!query.empty())
+    {
+        return query.at(0).id;
+    }
+
+    return static_cast<std::uint32_t>(
+        storage.insert(LevelValidator{.validator = validator}));
+}
+
+template <typename Storage>
+void migrateLegacyScores(Storage& storage)
+{
+    if (storage.pragma.user_version() >= schemaVersion)
+    {
+        return;
+    }
+
+    const auto legacyScores = storage.template get_all<LegacyScore>();
+
+    SSVOH_DLOG << "Migrating '" << legacyScores.size()
+               << "' legacy scores to schema version '" << schemaVersion
+               << "'\n";
+
+    storage.transaction(
+        [&]
+        {
+            for (const LegacyScore& ls : legacyScores)
+            {
+                storage.insert(Score{
+                    .levelValidatorId = getOrAddLevelValidatorIdImpl( //
+                        storage, ls.levelValidator),                  //
+                    .timestamp = ls.timestamp,                        //
+                    .userSteamId = ls.userSteamId,                    //
+                    .value = ls.value                                 //
+                });
+            }
+
+            storage.template remove_all<LegacyScore>();
+            return true;
+        });
+
+    storage.pragma.user_version(schemaVersion);
+}
+
 inline auto makeStorage()
 {
     using namespace sqlite_orm;
 
     auto storage = make_storage("ohdb.sqlite",                           //
                                                                          //
+        make_index("idx_scoresV2_levelValidatorId",                      //
+            &Score::levelValidatorId),                                   //
+                                                                         //
         make_table("users",                                              //
             make_column("id", &User::id, primary_key().autoincrement()), //
             make_column("steamId", &User::steamId, unique()),            //
@@ -58,10 +119,26 @@ inline auto makeStorage()
             make_column("token", &LoginToken::token)                     //
             ),                                                           //
                                                                          //
+        make_table("levelValidators",                                    //
+            make_column("id", &LevelValidator::id,                       //
+                primary_key().autoincrement()),                          //
+            make_column(                                                 //
+                "validator", &LevelValidator::validator, unique())       //
+            ),                                                           //
+                                                                         //
         make_table("scores",                                             //
+            make_column(                                                 //
+                "id", &LegacyScore::id, primary_key().autoincrement()),  //
+            make_column("levelValidator", &LegacyScore::levelValidator), //
+            make_column("timestamp", &LegacyScore::timestamp),           //
+            make_column("userSteamId", &LegacyScore::userSteamId),       //
+            make_column("value", &LegacyScore::value)                    //
+            ),                                                           //
+                                                                         //
+        make_table("scoresV2",                                           //
             make_column(                                                 //
                 "id", &Score::id, primary_key().autoincrement()),        //
-            make_column("levelValidator", &Score::levelValidator),       //
+            make_column("levelValidatorId", &Score::levelValidatorId),   //
             make_column("timestamp", &Score::timestamp),                 //
             make_column("userSteamId", &Score::userSteamId),             //
             make_column("value", &Score::value)                          //
@@ -70,6 +147,8 @@ inline auto makeStorage()
     );
 
     storage.sync_schema(true /* preserve */);
+    migrateLegacyScores(storage);
+
     return storage;
 }
 
@@ -236,15 +315,21 @@ void removeAllStaleLoginTokens()
     }
 }
 
+[[nodiscard]] std::uint32_t getOrAddLevelValidatorId(
+    const std::string& validator)
+{
+    return Impl::getOrAddLevelValidatorIdImpl(Impl::getStorage(), validator);
+}
+
 [[nodiscard]] std::vector<ProcessedScore> getTopScores(
-    const int topLimit, const std::string& levelValidator)
+    const int topLimit, const std::uint32_t levelValidatorId)
 {
     using namespace sqlite_orm;
 
     auto query = Impl::getStorage().select(
         columns(&User::name, &Score::timestamp, &Score::value),
         join<Score>(on(c(&User::steamId) == &Score::userSteamId)),
-        where(levelValidator == c(&Score::levelValidator)),
+        where(levelValidatorId == c(&Score::levelValidatorId)),
         order_by(&Score::value).desc(), limit(topLimit));
 
     std::vector<ProcessedScore> result;
@@ -281,21 +366,22 @@ void removeAllStaleLoginTokens()
     return isLoginTokenTimestampValid(query.at(0));
 }
 
-void addScore(const std::string& levelValidator, const std::uint64_t timestamp,
-    const std::uint64_t userSteamId, const double value)
+void addScore(const std::uint32_t levelValidatorId,
+    const std::uint64_t timestamp, const std::uint64_t userSteamId,
+    const double value)
 {
     using namespace sqlite_orm;
 
     Score score{
-        .levelValidator = levelValidator, //
-        .timestamp = timestamp,           //
-        .userSteamId = userSteamId,       //
-        .value = value                    //
+        .levelValidatorId = levelValidatorId, //
+        .timestamp = timestamp,               //
+        .userSteamId = userSteamId,           //
+        .value = value                        //
     };
 
     const auto query = Impl::getStorage().get_all<Score>(
         where(userSteamId == c(&Score::userSteamId) &&
-              levelValidator == c(&Score::levelValidator)));
+              levelValidatorId == c(&Score::levelValidatorId)));
 
     if (query.empty())
     {
@@ -321,8 +407,25 @@ void addScore(const std::string& levelValidator, const std::uint64_t timestamp,
                << Impl::getStorage().dump(score) << '\n';
 }
 
+[[nodiscard]] sf::base::Optional<double> getUserScoreValue(
+    const std::uint32_t levelValidatorId, const std::uint64_t userSteamId)
+{
+    using namespace sqlite_orm;
+
+    const auto query = Impl::getStorage().select(&Score::value,
+        where(userSteamId == c(&Score::userSteamId) &&
+              levelValidatorId == c(&Score::levelValidatorId)));
+
+    if (query.empty())
+    {
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(query.at(0));
+}
+
 [[nodiscard]] sf::base::Optional<ProcessedScore> getScore(
-    const std::string& levelValidator, const std::uint64_t userSteamId)
+    const std::uint32_t levelValidatorId, const std::uint64_t userSteamId)
 {
     using namespace sqlite_orm;
 
@@ -330,7 +433,7 @@ void addScore(const std::string& levelValidator, const std::uint64_t timestamp,
         Impl::getStorage().select(columns(&User::name, &Score::timestamp,
                                       &Score::value, &Score::userSteamId),
             join<Score>(on(c(&User::steamId) == &Score::userSteamId)),
-            where(levelValidator == c(&Score::levelValidator)),
+            where(levelValidatorId == c(&Score::levelValidatorId)),
             order_by(&Score::value).desc());
 
     if (query.empty())
@@ -0,0 +1,223 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+
+#include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+[[nodiscard]] static bool sameScore(
+    const Database::ProcessedScore& a, const Database::ProcessedScore& b)
+{
+    return a.userName == b.userName && a.scoreTimestamp == b.scoreTimestamp &&
+           a.scoreValue == b.scoreValue;
+}
+
+[[nodiscard]] static bool sameScoreAndPosition(
+    const Database::ProcessedScore& a, const Database::ProcessedScore& b)
+{
+    return a.position == b.position && sameScore(a, b);
+}
+
+[[nodiscard]] LeaderboardDelta makeLeaderboardDelta(
+    const std::vector<Database::ProcessedScore>& oldScores,
+    const std::vector<Database::ProcessedScore>& newScores)
+{
+    LeaderboardDelta result{
+        .size = static_cast<std::uint32_t>(newScores.size()), //
+        .moved = {},                                          //
+        .inserted = {}                                        //
+    };
+
+    const auto unchangedAt = [&](const std::size_t i)
+    {
+        return i < oldScores.size() &&
+               sameScoreAndPosition(oldScores[i], newScores[i]);
+    };
+
+    // Old scores that are either unchanged or already used as a move source.
+    std::vector<bool> used(oldScores.size(), false);
+
+    for (std::size_t i = 0; i < newScores.size(); ++i)
+    {
+        if (unchangedAt(i))
+        {
+            used[i] = true;
+        }
+    }
+
+    for (std::size_t i = 0; i < newScores.size(); ++i)
+    {
+        if (unchangedAt(i))
+        {
+            continue;
+        }
+
+        bool found = false;
+
+        for (std::size_t j = 0; j < oldScores.size(); ++j)
+        {
+            if (!used[j] && sameScore(oldScores[j], newScores[i]))
+            {
+                used[j] = true;
+                found = true;
+
+                result.moved.push_back(LeaderboardMovedScore{
+                    .index = static_cast<std::uint32_t>(i),   //
+                    .oldIndex = static_cast<std::uint32_t>(j) //
+                });
+
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            result.inserted.push_back(LeaderboardInsertedScore{
+                .index = static_cast<std::uint32_t>(i), //
+                .score = newScores[i]                   //
+            });
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] sf::base::Optional<std::vector<Database::ProcessedScore>>
+applyLeaderboardDelta(const std::vector<Database::ProcessedScore>& oldScores,
+    const LeaderboardDelta& delta)
+{
+    std::vector<Database::ProcessedScore> result(delta.size);
+    std::vector<bool> filled(delta.size, false);
+
+    for (const auto& [index, oldIndex] : delta.moved)
+    {
+        if (index >= delta.size || oldIndex >= oldScores.size())
+        {
+            return sf::base::nullOpt;
+        }
+
+        // Positions of top scores are their indices in the list.
+        result[index] = oldScores[oldIndex];
+        result[index].position = index;
+        filled[index] = true;
+    }
+
+    for (const auto& [index, score] : delta.inserted)
+    {
+        if (index >= delta.size)
+        {
+            return sf::base::nullOpt;
+        }
+
+        result[index] = score;
+        filled[index] = true;
+    }
+
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        if (filled[i])
+        {
+            continue;
+        }
+
+        if (i >= oldScores.size())
+        {
+            return sf::base::nullOpt;
+        }
+
+        result[i] = oldScores[i];
+    }
+
+    return sf::base::makeOptional(SSVOH_MOVE(result));
+}
+
+// ----------------------------------------------------------------------------
+
+LeaderboardHistory::LeaderboardHistory(
+    const LeaderboardVersion firstVersion, const std::size_t maxSnapshots)
+    : _nextVersion{firstVersion}, _maxSnapshots{maxSnapshots}
+{
+    SSVOH_ASSERT(_nextVersion != noLeaderboardVersion);
+    SSVOH_ASSERT(_maxSnapshots > 0);
+}
+
+void LeaderboardHistory::invalidate(const LevelValidatorId levelValidatorId)
+{
+    _entries[levelValidatorId]._dirty = true;
+}
+
+void LeaderboardHistory::invalidateAll()
+{
+    for (auto& [levelValidatorId, entry] : _entries)
+    {
+        entry._dirty = true;
+    }
+}
+
+[[nodiscard]] bool LeaderboardHistory::isUpToDate(
+    const LevelValidatorId levelValidatorId) const
+{
+    const auto it = _entries.find(levelValidatorId);
+    return it != _entries.end() && !it->second._dirty;
+}
+
+const LeaderboardHistory::Snapshot& LeaderboardHistory::update(
+    const LevelValidatorId levelValidatorId,
+    std::vector<Database::ProcessedScore>&& scores)
+{
+    Entry& entry = _entries[levelValidatorId];
+
+    entry._snapshots.push_back(Snapshot{
+        .version = _nextVersion++,   //
+        .scores = SSVOH_MOVE(scores) //
+    });
+
+    if (entry._snapshots.size() > _maxSnapshots)
+    {
+        entry._snapshots.pop_front();
+    }
+
+    entry._dirty = false;
+    return entry._snapshots.back();
+}
+
+[[nodiscard]] const LeaderboardHistory::Snapshot&
+LeaderboardHistory::getLatest(const LevelValidatorId levelValidatorId) const
+{
+    SSVOH_ASSERT(isUpToDate(levelValidatorId));
+    return _entries.at(levelValidatorId)._snapshots.back();
+}
+
+[[nodiscard]] const LeaderboardHistory::Snapshot* LeaderboardHistory::find(
+    const LevelValidatorId levelValidatorId,
+    const LeaderboardVersion version) const
+{
+    const auto it = _entries.find(levelValidatorId);
+    if (it == _entries.end())
+    {
+        return nullptr;
+    }
+
+    for (const Snapshot& s : it->second._snapshots)
+    {
+        if (s.version == version)
+        {
+            return &s;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace hg
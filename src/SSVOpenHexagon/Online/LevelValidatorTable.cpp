@@ -0,0 +1,100 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
+
+#include "SSVOpenHexagon/Global/Assert.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace hg {
+
+void LevelValidatorTable::add(
+    const LevelValidatorId id, const std::string& validator)
+{
+    SSVOH_ASSERT(!contains(id) || *getValidator(id) == validator);
+
+    _validatorToId[validator] = id;
+    _idToValidator[id] = validator;
+}
+
+void LevelValidatorTable::add(
+    const std::vector<LevelValidatorMapping>& mappings)
+{
+    for (const auto& [id, validator] : mappings)
+    {
+        add(id, validator);
+    }
+}
+
+void LevelValidatorTable::clear()
+{
+    _validatorToId.clear();
+    _idToValidator.clear();
+}
+
+[[nodiscard]] bool LevelValidatorTable::contains(
+    const std::string& validator) const
+{
+    return _validatorToId.contains(validator);
+}
+
+[[nodiscard]] bool LevelValidatorTable::contains(
+    const LevelValidatorId id) const
+{
+    return _idToValidator.contains(id);
+}
+
+[[nodiscard]] sf::base::Optional<LevelValidatorId> LevelValidatorTable::getId(
+    const std::string& validator) const
+{
+    const auto it = _validatorToId.find(validator);
+    if (it == _validatorToId.end())
+    {
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(it->second);
+}
+
+[[nodiscard]] const std::string* LevelValidatorTable::getValidator(
+    const LevelValidatorId id) const
+{
+    const auto it = _idToValidator.find(id);
+    return it == _idToValidator.end() ? nullptr : &it->second;
+}
+
+[[nodiscard]] std::vector<LevelValidatorMapping>
+LevelValidatorTable::toMappings() const
+{
+    std::vector<LevelValidatorMapping> result;
+    result.reserve(_idToValidator.size());
+
+    for (const auto& [id, validator] : _idToValidator)
+    {
+        result.push_back(LevelValidatorMapping{
+            .id = id,              //
+            .validator = validator //
+        });
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::size_t LevelValidatorTable::size() const noexcept
+{
+    return _idToValidator.size();
+}
+
+[[nodiscard]] bool LevelValidatorTable::empty() const noexcept
+{
+    return _idToValidator.empty();
+}
+
+} // namespace hg
@@ -0,0 +1,562 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/ReplayArchive.hpp"
+
+#include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "SSVOpenHexagon/Utils/Concat.hpp"
+
+#include <SSVUtils/Core/Log/Log.hpp>
+
+#include <SFML/Base/Optional.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+static auto& alog(const char* funcName)
+{
+    return ::ssvu::lo(::hg::Utils::concat("hg::ReplayArchive::", funcName));
+}
+
+#define SSVOH_ALOG ::alog(__func__)
+
+#define SSVOH_ALOG_ERROR ::alog(__func__) << "[ERROR] "
+
+namespace hg {
+
+[[nodiscard]] static std::filesystem::path getIndexPath(
+    const std::filesystem::path& directory)
+{
+    return directory / "index.ohri";
+}
+
+[[nodiscard]] static std::filesystem::path getSegmentPath(
+    const std::filesystem::path& directory, const std::uint32_t segment)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "segment_%06u.ohrs", segment);
+
+    return directory / buf;
+}
+
+template <typename T>
+static void writeRaw(std::ofstream& os, const T& datum)
+{
+    os.write(reinterpret_cast<const char*>(&datum), sizeof(datum));
+}
+
+template <typename T>
+[[nodiscard]] static bool readRaw(std::ifstream& is, T& target)
+{
+    is.read(reinterpret_cast<char*>(&target), sizeof(target));
+    return static_cast<bool>(is);
+}
+
+static void writeIndexRecord(std::ofstream& os, const ReplayArchiveEntry& e)
+{
+    writeRaw(os, static_cast<std::uint32_t>(e.levelValidator.size()));
+    os.write(e.levelValidator.data(), e.levelValidator.size());
+    writeRaw(os, e.steamId);
+    writeRaw(os, e.score);
+    writeRaw(os, e.timestamp);
+    writeRaw(os, e.segment);
+    writeRaw(os, e.offset);
+    writeRaw(os, e.size);
+}
+
+[[nodiscard]] static bool readIndexRecord(
+    std::ifstream& is, ReplayArchiveEntry& e)
+{
+    std::uint32_t levelValidatorSize;
+    if (!readRaw(is, levelValidatorSize) ||
+        levelValidatorSize > maxArchivedLevelValidatorSize)
+    {
+        return false;
+    }
+
+    e.levelValidator.resize(levelValidatorSize);
+    if (!is.read(e.levelValidator.data(), levelValidatorSize))
+    {
+        return false;
+    }
+
+    return readRaw(is, e.steamId) && readRaw(is, e.score) &&
+           readRaw(is, e.timestamp) && readRaw(is, e.segment) &&
+           readRaw(is, e.offset) && readRaw(is, e.size) &&
+           e.size <= maxArchivedReplaySize;
+}
+
+// Index records are written after their replay data, so a record pointing
+// past the end of its segment is corrupt. Segment sizes are cached in
+// `segmentBytes`, as most records share a few segments.
+[[nodiscard]] static bool isWithinSegment(
+    const std::filesystem::path& directory, const ReplayArchiveEntry& e,
+    std::unordered_map<std::uint32_t, std::uint64_t>& segmentBytes)
+{
+    auto it = segmentBytes.find(e.segment);
+
+    if (it == segmentBytes.end())
+    {
+        const std::filesystem::path path = getSegmentPath(directory, e.segment);
+
+        std::error_code ec;
+        const std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+
+        it = segmentBytes.emplace(e.segment, ec ? 0 : bytes).first;
+    }
+
+    return e.offset <= it->second && e.size <= it->second - e.offset;
+}
+
+// ----------------------------------------------------------------------------
+
+ReplayArchiveWriter::ReplayArchiveWriter(
+    const std::filesystem::path& directory, const std::uint64_t maxSegmentBytes)
+    : _directory{directory},
+      _maxSegmentBytes{maxSegmentBytes},
+      _currentSegment{0},
+      _currentSegmentBytes{0},
+      _stopping{false}
+{
+    std::error_code ec;
+    std::filesystem::create_directories(_directory, ec);
+
+    if (ec)
+    {
+        SSVOH_ALOG_ERROR << "Failed to create archive directory '"
+                         << _directory << "': " << ec.message() << '\n';
+    }
+
+    // Resume appending to the last existing segment, if any.
+    while (std::filesystem::exists(
+        getSegmentPath(_directory, _currentSegment + 1)))
+    {
+        ++_currentSegment;
+    }
+
+    recover();
+
+    if (!openSegment(_currentSegment))
+    {
+        SSVOH_ALOG_ERROR << "Failed to open segment '" << _currentSegment
+                         << "'\n";
+    }
+
+    _indexStream.open(getIndexPath(_directory),
+        std::ios::binary | std::ios::out | std::ios::app);
+
+    if (!_indexStream)
+    {
+        SSVOH_ALOG_ERROR << "Failed to open index file\n";
+    }
+
+    SSVOH_ALOG << "Replay archive initialized at '" << _directory
+               << "', current segment: '" << _currentSegment << "' ("
+               << _currentSegmentBytes << " bytes)\n";
+
+    _thread = std::thread{[this] { run(); }};
+}
+
+ReplayArchiveWriter::~ReplayArchiveWriter()
+{
+    {
+        std::lock_guard lock{_mutex};
+        _stopping = true;
+    }
+
+    _cv.notify_one();
+    _thread.join();
+}
+
+void ReplayArchiveWriter::recover()
+{
+    // A crash can leave a partial record at the end of the index, or replay
+    // data without an index record at the end of the current segment. Both
+    // are cut off, otherwise new records would be appended after garbage.
+    const std::filesystem::path indexPath = getIndexPath(_directory);
+    const std::filesystem::path segmentPath =
+        getSegmentPath(_directory, _currentSegment);
+
+    std::uint64_t validIndexBytes = 0;
+    std::uint64_t validSegmentBytes = 0;
+
+    {
+        std::ifstream is(indexPath, std::ios::binary | std::ios::in);
+        std::unordered_map<std::uint32_t, std::uint64_t> segmentBytes;
+
+        ReplayArchiveEntry entry;
+        while (is && readIndexRecord(is, entry))
+        {
+            validIndexBytes = static_cast<std::uint64_t>(is.tellg());
+
+            // A corrupt record must not prevent the unindexed data at the end
+            // of the segment from being cut off.
+            if (!isWithinSegment(_directory, entry, segmentBytes))
+            {
+                continue;
+            }
+
+            if (entry.segment == _currentSegment &&
+                entry.offset + entry.size > validSegmentBytes)
+            {
+                validSegmentBytes = entry.offset + entry.size;
+            }
+        }
+    }
+
+    const auto truncate = [](const std::filesystem::path& path,
+                              const std::uint64_t validBytes)
+    {
+        std::error_code ec;
+        const std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+
+        if (ec || bytes <= validBytes)
+        {
+            return;
+        }
+
+        SSVOH_ALOG << "Truncating '" << path << "' from " << bytes << " to "
+                   << validBytes << " bytes\n";
+
+        std::filesystem::resize_file(path, validBytes, ec);
+
+        if (ec)
+        {
+            SSVOH_ALOG_ERROR << "Failed to truncate '" << path
+                             << "': " << ec.message() << '\n';
+        }
+    };
+
+    truncate(indexPath, validIndexBytes);
+    truncate(segmentPath, validSegmentBytes);
+}
+
+[[nodiscard]] bool ReplayArchiveWriter::openSegment(const std::uint32_t segment)
+{
+    const std::filesystem::path path = getSegmentPath(_directory, segment);
+
+    std::error_code ec;
+    const std::uintmax_t existingBytes = std::filesystem::file_size(path, ec);
+
+    _segmentStream.close();
+    _segmentStream.open(
+        path, std::ios::binary | std::ios::out | std::ios::app);
+
+    _currentSegment = segment;
+    _currentSegmentBytes = ec ? 0 : existingBytes;
+
+    return static_cast<bool>(_segmentStream);
+}
+
+[[nodiscard]] bool ReplayArchiveWriter::write(PendingReplay& pr)
+{
+    if (pr._levelValidator.size() > maxArchivedLevelValidatorSize)
+    {
+        return false;
+    }
+
+    if (pr._compressedReplayFile._data.size() > maxArchivedReplaySize)
+    {
+        return false;
+    }
+
+    if (pr._replayFile.hasValue())
+    {
+        sf::base::Optional<compressed_replay_file> crf =
+            compress_replay_file(*pr._replayFile);
+
+        if (!crf.hasValue())
+        {
+            return false;
+        }
+
+        pr._compressedReplayFile = SSVOH_MOVE(*crf);
+    }
+
+    const std::vector<char>& data = pr._compressedReplayFile._data;
+
+    if (_currentSegmentBytes > 0 &&
+        _currentSegmentBytes + data.size() > _maxSegmentBytes)
+    {
+        if (!openSegment(_currentSegment + 1))
+        {
+            return false;
+        }
+    }
+
+    const ReplayArchiveEntry entry{
+        .levelValidator = pr._levelValidator, //
+        .steamId = pr._steamId,               //
+        .score = pr._score,                   //
+        .timestamp = pr._timestamp,           //
+        .segment = _currentSegment,           //
+        .offset = _currentSegmentBytes,       //
+        .size = data.size()                   //
+    };
+
+    _segmentStream.write(data.data(), data.size());
+    _segmentStream.flush();
+
+    if (!_segmentStream)
+    {
+        return false;
+    }
+
+    _currentSegmentBytes += data.size();
+
+    // The index record is written only after the replay data hit the segment,
+    // so the index never refers to incomplete data.
+    writeIndexRecord(_indexStream, entry);
+    _indexStream.flush();
+
+    return static_cast<bool>(_indexStream);
+}
+
+void ReplayArchiveWriter::run()
+{
+    std::vector<PendingReplay> batch;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock{_mutex};
+            _cv.wait(lock, [&] { return _stopping || !_queue.empty(); });
+
+            if (_queue.empty())
+            {
+                SSVOH_ASSERT(_stopping);
+                return;
+            }
+
+            batch.swap(_queue);
+        }
+
+        for (PendingReplay& pr : batch)
+        {
+            if (!write(pr))
+            {
+                SSVOH_ALOG_ERROR << "Failed to archive replay for level '"
+                                 << pr._levelValidator << "' from user '"
+                                 << pr._steamId << "'\n";
+            }
+        }
+
+        batch.clear();
+    }
+}
+
+void ReplayArchiveWriter::append(const std::string& levelValidator,
+    const std::uint64_t steamId, const double score,
+    const std::uint64_t timestamp, compressed_replay_file&& crf)
+{
+    {
+        std::lock_guard lock{_mutex};
+
+        _queue.push_back(PendingReplay{
+            ._levelValidator = levelValidator,        //
+            ._steamId = steamId,                      //
+            ._score = score,                          //
+            ._timestamp = timestamp,                  //
+            ._compressedReplayFile = SSVOH_MOVE(crf), //
+            ._replayFile = sf::base::nullOpt          //
+        });
+    }
+
+    _cv.notify_one();
+}
+
+void ReplayArchiveWriter::append(const std::string& levelValidator,
+    const std::uint64_t steamId, const double score,
+    const std::uint64_t timestamp, replay_file&& rf)
+{
+    {
+        std::lock_guard lock{_mutex};
+
+        _queue.push_back(PendingReplay{
+            ._levelValidator = levelValidator,                     //
+            ._steamId = steamId,                                   //
+            ._score = score,                                       //
+            ._timestamp = timestamp,                               //
+            ._compressedReplayFile = {},                           //
+            ._replayFile = sf::base::makeOptional(SSVOH_MOVE(rf)) //
+        });
+    }
+
+    _cv.notify_one();
+}
+
+[[nodiscard]] std::size_t ReplayArchiveWriter::getPendingCount()
+{
+    std::lock_guard lock{_mutex};
+    return _queue.size();
+}
+
+// ----------------------------------------------------------------------------
+
+ReplayArchiveReader::ReplayArchiveReader(
+    const std::filesystem::path& directory)
+    : _directory{directory}
+{}
+
+[[nodiscard]] bool ReplayArchiveReader::loadIndex()
+{
+    _entries.clear();
+
+    std::ifstream is(getIndexPath(_directory), std::ios::binary | std::ios::in);
+    if (!is)
+    {
+        SSVOH_ALOG_ERROR << "Couldn't open archive index in '" << _directory
+                         << "'\n";
+
+        return false;
+    }
+
+    std::unordered_map<std::uint32_t, std::uint64_t> segmentBytes;
+    std::size_t skippedCount = 0;
+
+    ReplayArchiveEntry entry;
+    while (readIndexRecord(is, entry))
+    {
+        if (!isWithinSegment(_directory, entry, segmentBytes))
+        {
+            ++skippedCount;
+            continue;
+        }
+
+        _entries.push_back(entry);
+    }
+
+    if (skippedCount > 0)
+    {
+        SSVOH_ALOG_ERROR << "Skipped " << skippedCount
+                         << " index records pointing past their segment\n";
+    }
+
+    return true;
+}
+
+[[nodiscard]] const std::vector<ReplayArchiveEntry>&
+ReplayArchiveReader::getEntries() const noexcept
+{
+    return _entries;
+}
+
+[[nodiscard]] std::vector<ReplayArchiveEntry>
+ReplayArchiveReader::getEntriesForLevel(const std::string& levelValidator) const
+{
+    std::vector<ReplayArchiveEntry> result;
+
+    for (const ReplayArchiveEntry& e : _entries)
+    {
+        if (e.levelValidator == levelValidator)
+        {
+            result.push_back(e);
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] sf::base::Optional<ReplayArchiveEntry>
+ReplayArchiveReader::getBestEntry(const std::string& levelValidator) const
+{
+    const ReplayArchiveEntry* best = nullptr;
+
+    for (const ReplayArchiveEntry& e : _entries)
+    {
+        if (e.levelValidator == levelValidator &&
+            (best == nullptr || e.score > best->score))
+        {
+            best = &e;
+        }
+    }
+
+    if (best == nullptr)
+    {
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(*best);
+}
+
+[[nodiscard]] sf::base::Optional<ReplayArchiveEntry>
+ReplayArchiveReader::getBestEntryForUser(
+    const std::string& levelValidator, const std::uint64_t steamId) const
+{
+    const ReplayArchiveEntry* best = nullptr;
+
+    for (const ReplayArchiveEntry& e : _entries)
+    {
+        if (e.levelValidator == levelValidator && e.steamId == steamId &&
+            (best == nullptr || e.score > best->score))
+        {
+            best = &e;
+        }
+    }
+
+    if (best == nullptr)
+    {
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(*best);
+}
+
+[[nodiscard]] sf::base::Optional<compressed_replay_file>
+ReplayArchiveReader::read(const ReplayArchiveEntry& entry) const
+{
+    std::ifstream is(getSegmentPath(_directory, entry.segment),
+        std::ios::binary | std::ios::in);
+
+    if (!is)
+    {
+        SSVOH_ALOG_ERROR << "Couldn't open archive segment '" << entry.segment
+                         << "'\n";
+
+        return sf::base::nullOpt;
+    }
+
+    std::unordered_map<std::uint32_t, std::uint64_t> segmentBytes;
+
+    if (entry.size > maxArchivedReplaySize ||
+        !isWithinSegment(_directory, entry, segmentBytes))
+    {
+        SSVOH_ALOG_ERROR << "Replay at offset '" << entry.offset
+                         << "' with size '" << entry.size
+                         << "' does not fit in archive segment '"
+                         << entry.segment << "'\n";
+
+        return sf::base::nullOpt;
+    }
+
+    compressed_replay_file result;
+    result._data.resize(entry.size);
+
+    is.seekg(entry.offset);
+    if (!is.read(result._data.data(), entry.size))
+    {
+        SSVOH_ALOG_ERROR << "Failed reading replay at offset '" << entry.offset
+                         << "' in archive segment '" << entry.segment << "'\n";
+
+        return sf::base::nullOpt;
+    }
+
+    return sf::base::makeOptional(SSVOH_MOVE(result));
+}
+
+} // namespace hg
@@ -0,0 +1,66 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/UserScoreCache.hpp"
+
+#include "SSVOpenHexagon/Global/Config.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+[[nodiscard]] double getMaxReplayPlayedSeconds(const std::size_t inputCount)
+{
+    return static_cast<double>(inputCount) * Config::TIME_STEP / 60.0;
+}
+
+[[nodiscard]] bool canImproveOnStoredScore(
+    const sf::base::Optional<double>& storedScore,
+    const double maxPlayedSeconds)
+{
+    return !storedScore.hasValue() || maxPlayedSeconds > *storedScore;
+}
+
+[[nodiscard]] const sf::base::Optional<double>* UserScoreCache::find(
+    const LevelValidatorId levelValidatorId, const std::uint64_t steamId) const
+{
+    const auto it = _scores.find(std::make_pair(levelValidatorId, steamId));
+    return it == _scores.end() ? nullptr : &it->second;
+}
+
+const sf::base::Optional<double>& UserScoreCache::store(
+    const LevelValidatorId levelValidatorId, const std::uint64_t steamId,
+    const sf::base::Optional<double>& score)
+{
+    return _scores[std::make_pair(levelValidatorId, steamId)] = score;
+}
+
+void UserScoreCache::addScore(const LevelValidatorId levelValidatorId,
+    const std::uint64_t steamId, const double score)
+{
+    sf::base::Optional<double>& cachedScore =
+        _scores[std::make_pair(levelValidatorId, steamId)];
+
+    if (!cachedScore.hasValue() || *cachedScore < score)
+    {
+        cachedScore.emplace(score);
+    }
+}
+
+void UserScoreCache::clear()
+{
+    _scores.clear();
+}
+
+[[nodiscard]] std::size_t UserScoreCache::size() const
+{
+    return _scores.size();
+}
+
+} // namespace hg
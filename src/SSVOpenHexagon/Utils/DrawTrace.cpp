@@ -0,0 +1,106 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/DrawTrace.hpp"
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+
+#include <cstdio>
+#include <ostream>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg::Utils {
+
+[[nodiscard]] static const char* getPrimitiveTypeName(
+    const sf::PrimitiveType primitiveType) noexcept
+{
+    switch (primitiveType)
+    {
+        case sf::PrimitiveType::Points: return "points";
+        case sf::PrimitiveType::Lines: return "lines";
+        case sf::PrimitiveType::LineStrip: return "lineStrip";
+        case sf::PrimitiveType::Triangles: return "triangles";
+        case sf::PrimitiveType::TriangleStrip: return "triangleStrip";
+        case sf::PrimitiveType::TriangleFan: return "triangleFan";
+    }
+
+    return "unknown";
+}
+
+void DrawTrace::beginFrame() noexcept
+{
+    _calls.clear();
+    ++_frameCount;
+}
+
+void DrawTrace::record(const Call& call)
+{
+    _calls.emplace_back(call);
+
+    ++_totalCallCount;
+    _totalVertexCount += call.vertexCount;
+}
+
+void DrawTrace::clear() noexcept
+{
+    _calls.clear();
+    _frameCount = 0;
+    _totalCallCount = 0;
+    _totalVertexCount = 0;
+}
+
+[[nodiscard]] const std::vector<DrawTrace::Call>&
+DrawTrace::getFrameCalls() const noexcept
+{
+    return _calls;
+}
+
+[[nodiscard]] std::size_t DrawTrace::getFrameVertexCount() const noexcept
+{
+    std::size_t result = 0;
+
+    for (const Call& call : _calls)
+    {
+        result += call.vertexCount;
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::uint64_t DrawTrace::getFrameCount() const noexcept
+{
+    return _frameCount;
+}
+
+[[nodiscard]] std::uint64_t DrawTrace::getTotalCallCount() const noexcept
+{
+    return _totalCallCount;
+}
+
+[[nodiscard]] std::uint64_t DrawTrace::getTotalVertexCount() const noexcept
+{
+    return _totalVertexCount;
+}
+
+void DrawTrace::dumpFrame(std::ostream& os) const
+{
+    char buf[128];
+
+    for (std::size_t i = 0; i < _calls.size(); ++i)
+    {
+        const Call& call = _calls[i];
+
+        std::snprintf(buf, sizeof(buf), "%4zu %-14s %8zu tex=%p shader=%p\n",
+            i, getPrimitiveTypeName(call.primitiveType), call.vertexCount,
+            static_cast<const void*>(call.texture),
+            static_cast<const void*>(call.shader));
+
+        os << buf;
+    }
+}
+
+} // namespace hg::Utils
@@ -4,6 +4,8 @@
 
 #include "SSVOpenHexagon/Utils/Geometry.hpp"
 
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
+
 #include <SFML/System/Vector2.hpp>
 
 #include <cmath>
@@ -14,12 +16,11 @@ namespace hg::Utils {
     sf::Vector2f& i2, const sf::Vector2f& p1, const sf::Vector2f& p2,
     const float mRadiusSquared)
 {
-    const float dx{p2.x - p1.x};
-    const float dy{p2.y - p1.y};
-    const float a{dx * dx + dy * dy};
-    const float b{2.f * (dx * p1.x + dy * p1.y)};
-    const float c{p1.x * p1.x + p1.y * p1.y - mRadiusSquared};
-    const float delta{b * b - 4.f * a * c};
+    const sf::Vector2f d{p2 - p1};
+    const float a{Strict::lengthSq(d)};
+    const float b{2.f * Strict::dot(d, p1)};
+    const float c{Strict::lengthSq(p1) - mRadiusSquared};
+    const float delta{Strict::mul(b, b) - Strict::mul(4.f * a, c)};
 
     // No intersections.
     if (delta < 0.f)
@@ -34,16 +35,16 @@ namespace hg::Utils {
     if (delta < epsilon)
     {
         t = -b / twoA;
-        i1 = {p1.x + t * dx, p1.y + t * dy};
+        i1 = Strict::mulAdd(d, t, p1);
         return 1u;
     }
 
     // Two intersections.
     const float sqrtDelta{std::sqrt(delta)};
     t = (-b + sqrtDelta) / twoA;
-    i1 = {p1.x + t * dx, p1.y + t * dy};
+    i1 = Strict::mulAdd(d, t, p1);
     t = (-b - sqrtDelta) / twoA;
-    i2 = {p1.x + t * dx, p1.y + t * dy};
+    i2 = Strict::mulAdd(d, t, p1);
     return 2u;
 }
 
@@ -58,7 +59,7 @@ namespace hg::Utils {
         case 1u: mIntersection = v1; return true;
 
         case 2u:
-            if ((v1 - mPos).lengthSq() > (v2 - mPos).lengthSq())
+            if (Strict::lengthSq(v1 - mPos) > Strict::lengthSq(v2 - mPos))
             {
                 mIntersection = v2;
             }
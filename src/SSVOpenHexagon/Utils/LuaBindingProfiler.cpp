@@ -0,0 +1,87 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/LuaBindingProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hg::Utils {
+
+[[nodiscard]] LuaBindingProfiler::Entry& LuaBindingProfiler::getEntry(
+    const std::string& name)
+{
+    if (const auto it = _entriesByName.find(name); it != _entriesByName.end())
+    {
+        return *it->second;
+    }
+
+    Entry& entry = _entries.emplace_back(Entry{.name = name});
+    _entriesByName.emplace(entry.name, &entry);
+
+    return entry;
+}
+
+void LuaBindingProfiler::clear() noexcept
+{
+    for (Entry& entry : _entries)
+    {
+        entry.calls = 0;
+        entry.totalTime = std::chrono::nanoseconds::zero();
+    }
+}
+
+[[nodiscard]] std::vector<const LuaBindingProfiler::Entry*>
+LuaBindingProfiler::getSortedEntries() const
+{
+    std::vector<const Entry*> result;
+
+    for (const Entry& entry : _entries)
+    {
+        if (entry.calls > 0)
+        {
+            result.emplace_back(&entry);
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+        [](const Entry* a, const Entry* b)
+        { return a->totalTime > b->totalTime; });
+
+    return result;
+}
+
+void LuaBindingProfiler::dump(std::ostream& os) const
+{
+    char buf[128];
+
+    std::snprintf(buf, sizeof(buf), "%-32s %10s %12s %10s\n", "binding",
+        "calls", "total ms", "avg us");
+
+    os << buf;
+
+    for (const Entry* entry : getSortedEntries())
+    {
+        const double totalMs =
+            std::chrono::duration<double, std::milli>(entry->totalTime).count();
+
+        std::snprintf(buf, sizeof(buf), "%-32s %10llu %12.4f %10.4f\n",
+            entry->name.c_str(), static_cast<unsigned long long>(entry->calls),
+            totalMs, totalMs * 1000.0 / static_cast<double>(entry->calls));
+
+        os << buf;
+    }
+}
+
+[[nodiscard]] LuaBindingProfiler& getLuaBindingProfiler()
+{
+    static LuaBindingProfiler lbp;
+    return lbp;
+}
+
+} // namespace hg::Utils
@@ -5,10 +5,12 @@
 #include "SSVOpenHexagon/Utils/LuaMetadataProxy.hpp"
 
 #include "SSVOpenHexagon/Utils/LuaMetadata.hpp"
+#include "SSVOpenHexagon/Utils/LuaWrapper.hpp"
 
 #include <SSVUtils/Core/Log/Log.hpp>
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 #include <type_traits>
@@ -39,6 +41,18 @@ template <typename T>
     else if constexpr RETURN_T_STR(long long)
     else if constexpr RETURN_T_STR(unsigned long long)
     else if constexpr RETURN_T_STR(std::string)
+    else if constexpr (std::is_same_v<T, std::string_view>)
+    {
+        return "std::string";
+    }
+    else if constexpr (std::is_same_v<T, Lua::LuaContext::ArrayView<int>>)
+    {
+        return "table<int>";
+    }
+    else if constexpr (std::is_same_v<T, Lua::LuaContext::ArrayView<float>>)
+    {
+        return "table<float>";
+    }
     else
     {
         struct fail;
@@ -63,6 +77,12 @@ template const char* LuaMetadataProxy::typeToStr(TypeWrapper<long long>);
 template const char* LuaMetadataProxy::typeToStr(
     TypeWrapper<unsigned long long>);
 template const char* LuaMetadataProxy::typeToStr(TypeWrapper<std::string>);
+template const char* LuaMetadataProxy::typeToStr(
+    TypeWrapper<std::string_view>);
+template const char* LuaMetadataProxy::typeToStr(
+    TypeWrapper<Lua::LuaContext::ArrayView<int>>);
+template const char* LuaMetadataProxy::typeToStr(
+    TypeWrapper<Lua::LuaContext::ArrayView<float>>);
 #endif
 
 // ----------------------------------------------------------------------------
@@ -116,19 +116,26 @@ void LuaContext::_getGlobal(std::string_view mVarName) const
         // first we extract the part between currentVar and the next dot
         // we encounter
         nextVar = std::find(currentVar, mVarName.end(), '.');
-        std::string buffer(currentVar, nextVar);
+
+        // the part is not null-terminated, so it is always pushed along
+        // with its length instead of being copied into a std::string
+        const char* const partData =
+            mVarName.data() + (currentVar - mVarName.begin());
+        const auto partSize = static_cast<std::size_t>(nextVar - currentVar);
+
         // since nextVar is pointing to a dot, we have to increase it
         // first in order to find the next variable
         if (nextVar != mVarName.end()) ++nextVar;
 
-        // ask lua to find the part stored in buffer
+        // ask lua to find the part
         // if currentVar == begin, this is a global variable and push it
         // on the stack
         // otherwise we already have an array pushed on the stack by the
         // previous loop
         if (currentVar == mVarName.begin())
         {
-            lua_getglobal(_state, buffer.c_str());
+            lua_pushlstring(_state, partData, partSize);
+            lua_gettable(_state, LUA_GLOBALSINDEX);
         }
         else
         {
@@ -143,7 +150,7 @@ void LuaContext::_getGlobal(std::string_view mVarName) const
             }
 
             // replacing the current table in the stack by its member
-            lua_pushstring(_state, buffer.c_str());
+            lua_pushlstring(_state, partData, partSize);
             lua_gettable(_state, -2);
             lua_remove(_state, -2);
         }
@@ -0,0 +1,121 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/ParticleSystem.hpp"
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Math.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+namespace hg::Utils {
+
+void ParticleSystem::moveParticle(
+    const std::size_t from, const std::size_t to) noexcept
+{
+    _positions[to] = _positions[from];
+    _velocities[to] = _velocities[from];
+    _rotationsDeg[to] = _rotationsDeg[from];
+    _angularVelocitiesDeg[to] = _angularVelocitiesDeg[from];
+    _scales[to] = _scales[from];
+    _colors[to] = _colors[from];
+}
+
+void ParticleSystem::resize(const std::size_t n)
+{
+    _positions.resize(n);
+    _velocities.resize(n);
+    _rotationsDeg.resize(n);
+    _angularVelocitiesDeg.resize(n);
+    _scales.resize(n);
+    _colors.resize(n);
+}
+
+void ParticleSystem::reserve(const std::size_t n)
+{
+    _positions.reserve(n);
+    _velocities.reserve(n);
+    _rotationsDeg.reserve(n);
+    _angularVelocitiesDeg.reserve(n);
+    _scales.reserve(n);
+    _colors.reserve(n);
+}
+
+void ParticleSystem::clear() noexcept
+{
+    _positions.clear();
+    _velocities.clear();
+    _rotationsDeg.clear();
+    _angularVelocitiesDeg.clear();
+    _scales.clear();
+    _colors.clear();
+}
+
+void ParticleSystem::emplace(const Particle& p)
+{
+    _positions.emplace_back(p.position);
+    _velocities.emplace_back(p.velocity);
+    _rotationsDeg.emplace_back(p.rotationDeg);
+    _angularVelocitiesDeg.emplace_back(p.angularVelocityDeg);
+    _scales.emplace_back(p.scale);
+    _colors.emplace_back(p.color);
+}
+
+void ParticleSystem::integrate(const float mFT) noexcept
+{
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        _positions[i] += _velocities[i] * mFT;
+        _rotationsDeg[i] += _angularVelocitiesDeg[i] * mFT;
+    }
+}
+
+void ParticleSystem::emitQuads(FastVertexVectorTris& out,
+    const sf::FloatRect& textureRect, const sf::Vector2f& origin) const
+{
+    out.reserve_more_quad(size());
+
+    // Corners relative to the origin, before scaling and rotation.
+    const sf::Vector2f nw{-origin.x, -origin.y};
+    const sf::Vector2f sw{-origin.x, textureRect.size.y - origin.y};
+    const sf::Vector2f se{
+        textureRect.size.x - origin.x, textureRect.size.y - origin.y};
+    const sf::Vector2f ne{textureRect.size.x - origin.x, -origin.y};
+
+    const sf::Vector2f& t = textureRect.position;
+    const sf::Vector2f texCoordsNW{t.x, t.y};
+    const sf::Vector2f texCoordsSW{t.x, t.y + textureRect.size.y};
+    const sf::Vector2f texCoordsSE{
+        t.x + textureRect.size.x, t.y + textureRect.size.y};
+    const sf::Vector2f texCoordsNE{t.x + textureRect.size.x, t.y};
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const float rotationRad = toRad(_rotationsDeg[i]);
+        const float cosScaled = std::cos(rotationRad) * _scales[i];
+        const float sinScaled = std::sin(rotationRad) * _scales[i];
+        const sf::Vector2f& pos = _positions[i];
+
+        const auto transform = [&](const sf::Vector2f& corner)
+        {
+            return sf::Vector2f{
+                pos.x + corner.x * cosScaled - corner.y * sinScaled,
+                pos.y + corner.x * sinScaled + corner.y * cosScaled};
+        };
+
+        out.unsafe_emplace_back_textured_quad(_colors[i], //
+            transform(nw), texCoordsNW,                   //
+            transform(sw), texCoordsSW,                   //
+            transform(se), texCoordsSE,                   //
+            transform(ne), texCoordsNE);
+    }
+}
+
+} // namespace hg::Utils
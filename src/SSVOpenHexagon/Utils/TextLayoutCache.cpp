@@ -0,0 +1,98 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/TextLayoutCache.hpp"
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include <SFML/Graphics/Text.hpp>
+
+#include <bit>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg::Utils {
+
+[[nodiscard]] std::size_t TextLayoutCache::KeyHash::operator()(
+    const KeyView& k) const noexcept
+{
+    std::size_t result = std::hash<std::string_view>{}(k.string);
+
+    const auto combine = [&](const std::size_t x)
+    { result ^= x + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2); };
+
+    combine(std::hash<const sf::Font*>{}(k.font));
+    combine(k.characterSize);
+    combine(k.style);
+    combine(std::bit_cast<std::uint32_t>(k.outlineThickness));
+
+    return result;
+}
+
+[[nodiscard]] sf::Text& TextLayoutCache::get(
+    const sf::Text& prototype, const std::string_view string)
+{
+    const KeyView key{
+        .string = string,                                          //
+        .font = &prototype.getFont(),                              //
+        .characterSize = prototype.getCharacterSize(),             //
+        .style = static_cast<std::uint32_t>(prototype.getStyle()), //
+        .outlineThickness = prototype.getOutlineThickness()        //
+    };
+
+    auto it = _entries.find(key);
+
+    if (it == _entries.end())
+    {
+        Entry entry{.text = prototype, .lastUsedFrame = _frame};
+        entry.text.setString(std::string{string});
+
+        it = _entries
+                 .emplace(Key{.string = std::string{string},
+                              .font = key.font,
+                              .characterSize = key.characterSize,
+                              .style = key.style,
+                              .outlineThickness = key.outlineThickness},
+                     SSVOH_MOVE(entry))
+                 .first;
+    }
+
+    Entry& entry = it->second;
+    entry.lastUsedFrame = _frame;
+
+    // Changing any of these does not re-shape the glyphs.
+    sf::Text& text = entry.text;
+    text.setFillColor(prototype.getFillColor());
+    text.setOutlineColor(prototype.getOutlineColor());
+    text.setOrigin(prototype.getOrigin());
+    text.setRotation(prototype.getRotation());
+    text.setScale(prototype.getScale());
+
+    return text;
+}
+
+void TextLayoutCache::nextFrame()
+{
+    std::erase_if(_entries,
+        [this](const auto& kv)
+        { return _frame - kv.second.lastUsedFrame > maxIdleFrames; });
+
+    ++_frame;
+}
+
+void TextLayoutCache::clear() noexcept
+{
+    _entries.clear();
+}
+
+[[nodiscard]] std::size_t TextLayoutCache::size() const noexcept
+{
+    return _entries.size();
+}
+
+} // namespace hg::Utils
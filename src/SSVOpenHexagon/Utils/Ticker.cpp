@@ -4,6 +4,8 @@
 
 #include "SSVOpenHexagon/Utils/Ticker.hpp"
 
+#include "SSVOpenHexagon/Utils/StrictMath.hpp"
+
 namespace hg {
 
 Ticker::Ticker(float mTarget, bool mRunning) noexcept
@@ -12,7 +14,8 @@ Ticker::Ticker(float mTarget, bool mRunning) noexcept
 
 bool Ticker::update(float mFT) noexcept
 {
-    const float increment = mFT * static_cast<float>(running);
+    const float increment =
+        Utils::Strict::mul(mFT, static_cast<float>(running));
 
     current += increment;
     total += increment;
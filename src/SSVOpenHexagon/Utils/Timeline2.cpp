@@ -5,18 +5,143 @@
 #include "SSVOpenHexagon/Utils/Timeline2.hpp"
 
 #include "SSVOpenHexagon/Global/Assert.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
 #include "SSVOpenHexagon/Utils/TinyVariant.hpp"
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <SFML/Base/Optional.hpp>
 
 namespace hg::Utils {
 
+void timeline2_arena::release_deferred_fns()
+{
+    for (const std::uint32_t index : _deferred_do_fns)
+    {
+        _do_fns.release(index);
+    }
+
+    for (const std::uint32_t index : _deferred_time_point_fns)
+    {
+        _time_point_fns.release(index);
+    }
+
+    _deferred_do_fns.clear();
+    _deferred_time_point_fns.clear();
+}
+
+void timeline2_arena::release_do_fn(const std::uint32_t index)
+{
+    if (_running_fns > 0)
+    {
+        _deferred_do_fns.emplace_back(index);
+        return;
+    }
+
+    _do_fns.release(index);
+}
+
+void timeline2_arena::release_time_point_fn(const std::uint32_t index)
+{
+    if (_running_fns > 0)
+    {
+        _deferred_time_point_fns.emplace_back(index);
+        return;
+    }
+
+    _time_point_fns.release(index);
+}
+
+void timeline2_arena::reserve(const std::size_t n)
+{
+    _do_fns.reserve(n);
+    _time_point_fns.reserve(n);
+    _deferred_do_fns.reserve(n);
+    _deferred_time_point_fns.reserve(n);
+}
+
+void timeline2_arena::run_do_fn(const std::uint32_t index)
+{
+    // Also restores the state if the function throws (e.g. on a Lua error).
+    struct running_guard
+    {
+        timeline2_arena& _arena;
+
+        ~running_guard()
+        {
+            if (--_arena._running_fns == 0)
+            {
+                _arena.release_deferred_fns();
+            }
+        }
+    };
+
+    ++_running_fns;
+    const running_guard guard{*this};
+
+    _do_fns[index]();
+}
+
+[[nodiscard]] std::size_t timeline2_arena::size() const noexcept
+{
+    return _do_fns.size() + _time_point_fns.size();
+}
+
+timeline2::timeline2(timeline2_arena& arena) noexcept : _arena{&arena}
+{}
+
+timeline2::~timeline2()
+{
+    release_all_fns();
+}
+
+timeline2::timeline2(timeline2&& rhs) noexcept
+    : _arena{rhs._arena}, _actions{SSVOH_MOVE(rhs._actions)}
+{
+    rhs._actions.clear();
+}
+
+timeline2& timeline2::operator=(timeline2&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        release_all_fns();
+
+        _arena = rhs._arena;
+        _actions = SSVOH_MOVE(rhs._actions);
+        rhs._actions.clear();
+    }
+
+    return *this;
+}
+
+void timeline2::release_all_fns()
+{
+    for (const action& a : _actions)
+    {
+        if (a.is<action_do>())
+        {
+            _arena->release_do_fn(a.as<action_do>()._fn_index);
+        }
+        else if (a.is<action_wait_until_fn>())
+        {
+            _arena->release_time_point_fn(
+                a.as<action_wait_until_fn>()._fn_index);
+        }
+    }
+}
+
 void timeline2::clear()
 {
+    release_all_fns();
     _actions.clear();
 }
 
+void timeline2::reserve(const std::size_t n)
+{
+    _actions.reserve(n);
+}
 
 void timeline2::append_wait_for(const duration d)
 {
@@ -46,13 +171,18 @@ void timeline2::append_wait_until(const time_point tp)
     return _actions.size();
 }
 
-[[nodiscard]] timeline2::action& timeline2::action_at(
-    const std::size_t i) noexcept
+[[nodiscard]] const timeline2::action& timeline2::action_at(
+    const std::size_t i) const noexcept
 {
     SSVOH_ASSERT(i < size());
     return _actions[i];
 }
 
+[[nodiscard]] timeline2_arena& timeline2::arena() noexcept
+{
+    return *_arena;
+}
+
 timeline2_runner::outcome timeline2_runner::update(
     timeline2& timeline, const time_point tp)
 {
@@ -64,15 +194,16 @@ timeline2_runner::outcome timeline2_runner::update(
 
     while (_current_idx < timeline.size())
     {
-        timeline2::action& a = timeline.action_at(_current_idx);
+        // Copied, as running a function can append to the timeline.
+        const timeline2::action a = timeline.action_at(_current_idx);
 
         const outcome o = a.linear_match(
-            [&](timeline2::action_do& x)
+            [&](const timeline2::action_do& x)
             {
-                x._func();
+                timeline.arena().run_do_fn(x._fn_index);
                 return outcome::proceed;
             },
-            [&](timeline2::action_wait_for& x)
+            [&](const timeline2::action_wait_for& x)
             {
                 if (!_wait_start_tp.hasValue())
                 {
@@ -91,7 +222,7 @@ timeline2_runner::outcome timeline2_runner::update(
                 _wait_start_tp.reset();
                 return outcome::proceed;
             },
-            [&](timeline2::action_wait_until& x)
+            [&](const timeline2::action_wait_until& x)
             {
                 if (tp < x._time_point)
                 {
@@ -102,9 +233,9 @@ timeline2_runner::outcome timeline2_runner::update(
                 // Finished waiting.
                 return outcome::proceed;
             }, //
-            [&](timeline2::action_wait_until_fn& x)
+            [&](const timeline2::action_wait_until_fn& x)
             {
-                if (tp < x._time_point_fn())
+                if (tp < timeline.arena().get_time_point_fn(x._fn_index)())
                 {
                     // Still waiting.
                     return outcome::waiting;
@@ -279,6 +279,10 @@ template void runLuaFunction<void>(Lua::LuaContext&, std::string_view)
 template sf::base::Optional<VoidToNothing<void>> runLuaFunctionIfExists<void>(
     Lua::LuaContext&, std::string_view);
 
+template sf::base::Optional<VoidToNothing<void>>
+runLuaFunctionIfExists<void, float>(
+    Lua::LuaContext&, std::string_view, const float&);
+
 template sf::base::Optional<VoidToNothing<float>>
 runLuaFunctionIfExists<float, float>(
     Lua::LuaContext&, std::string_view, const float&);
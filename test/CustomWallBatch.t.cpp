@@ -0,0 +1,236 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Components/CCustomWall.hpp"
+#include "SSVOpenHexagon/Components/CCustomWallHandle.hpp"
+#include "SSVOpenHexagon/Components/CCustomWallManager.hpp"
+#include "SSVOpenHexagon/Components/CustomWallBatchReader.hpp"
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Stands in for `Lua::LuaContext::ArrayView`: `nonNumbers` marks the elements
+// that would not be numbers in the Lua table, e.g. strings or `nil`.
+struct FakeArray
+{
+    std::vector<double> values;
+    std::vector<bool> nonNumbers = std::vector<bool>(values.size(), false);
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return values.size();
+    }
+
+    template <typename T>
+    [[nodiscard]] bool tryGet(const std::size_t i, T& out) const
+    {
+        if (nonNumbers[i])
+        {
+            return false;
+        }
+
+        out = static_cast<T>(values[i]);
+        return true;
+    }
+};
+
+[[nodiscard]] FakeArray withNonNumber(FakeArray array, const std::size_t i)
+{
+    array.nonNumbers[i] = true;
+    return array;
+}
+
+void test_read_handles()
+{
+    hg::CustomWallBatchReader reader;
+
+    const auto handles = reader.readHandles(FakeArray{{3, 0, 7}});
+
+    TEST_ASSERT_EQ(handles.size(), 3u);
+    TEST_ASSERT_EQ(handles[0], 3);
+    TEST_ASSERT_EQ(handles[1], 0);
+    TEST_ASSERT_EQ(handles[2], 7);
+
+    // Non-numbers become invalid handles, not `0`.
+    const auto withInvalid =
+        reader.readHandles(withNonNumber(FakeArray{{3, 0, 7}}, 1));
+
+    TEST_ASSERT_EQ(withInvalid.size(), 3u);
+    TEST_ASSERT_EQ(withInvalid[0], 3);
+    TEST_ASSERT_EQ(withInvalid[1], -1);
+    TEST_ASSERT_EQ(withInvalid[2], 7);
+
+    TEST_ASSERT(reader.readHandles(FakeArray{}).empty());
+}
+
+void test_read_vectors()
+{
+    hg::CustomWallBatchReader reader;
+
+    const auto vectors =
+        reader.readVectors(FakeArray{{0.5, -1.25, 2, 3}}, "test");
+
+    TEST_ASSERT(vectors.hasValue());
+    TEST_ASSERT_EQ(vectors->size(), 2u);
+    TEST_ASSERT_EQ((*vectors)[0].x, 0.5f);
+    TEST_ASSERT_EQ((*vectors)[0].y, -1.25f);
+    TEST_ASSERT_EQ((*vectors)[1].x, 2.f);
+    TEST_ASSERT_EQ((*vectors)[1].y, 3.f);
+
+    // Odd lengths and non-numbers are rejected.
+    TEST_ASSERT(!reader.readVectors(FakeArray{{1, 2, 3}}, "test").hasValue());
+
+    TEST_ASSERT(
+        !reader.readVectors(withNonNumber(FakeArray{{1, 2, 3, 4}}, 2), "test")
+             .hasValue());
+
+    TEST_ASSERT(reader.readVectors(FakeArray{}, "test")->empty());
+}
+
+void test_read_colors()
+{
+    hg::CustomWallBatchReader reader;
+
+    // Components are clamped to `[0, 255]`.
+    const auto colors = reader.readColors(
+        FakeArray{{10, 20, 30, 40, -5, 300, 255, 1000}}, "test");
+
+    TEST_ASSERT(colors.hasValue());
+    TEST_ASSERT_EQ(colors->size(), 2u);
+    TEST_ASSERT((*colors)[0] == sf::Color(10, 20, 30, 40));
+    TEST_ASSERT((*colors)[1] == sf::Color(0, 255, 255, 255));
+
+    // Lengths that are not a multiple of four and non-numbers are rejected.
+    TEST_ASSERT(
+        !reader.readColors(FakeArray{{1, 2, 3, 4, 5}}, "test").hasValue());
+
+    TEST_ASSERT(
+        !reader.readColors(withNonNumber(FakeArray{{1, 2, 3, 4}}, 3), "test")
+             .hasValue());
+}
+
+void checkPos(hg::CCustomWallManager& cwManager,
+    const hg::CCustomWallHandle h, const int vertexIdx, const float x,
+    const float y)
+{
+    const sf::Vector2f& pos = cwManager.getVertexPos(h, vertexIdx);
+
+    TEST_ASSERT_EQ(pos.x, x);
+    TEST_ASSERT_EQ(pos.y, y);
+}
+
+// Checks the color of the vertices of the custom wall `h`, all four vertices
+// share it in these tests. The wall is found in the drawn vertices by the
+// position of its first vertex, which is unique in these tests.
+void checkColor(hg::CCustomWallManager& cwManager,
+    const hg::CCustomWallHandle h, const sf::Color& expected)
+{
+    hg::Utils::FastVertexVectorTris wallQuads;
+    wallQuads.reserve_quad(cwManager.count());
+    cwManager.draw(wallQuads);
+
+    const sf::Vector2f& pos = cwManager.getVertexPos(h, 0);
+
+    for (std::size_t i = 0; i < wallQuads.size(); i += 6)
+    {
+        if (wallQuads[i].position == pos)
+        {
+            TEST_ASSERT(wallQuads[i].color == expected);
+            return;
+        }
+    }
+
+    TEST_ASSERT(false);
+}
+
+void test_batch_functions()
+{
+    hg::CCustomWallManager cwManager;
+
+    const hg::CCustomWallHandle h0 = cwManager.create([](hg::CCustomWall&) {});
+    const hg::CCustomWallHandle h1 = cwManager.create([](hg::CCustomWall&) {});
+
+    // Positions, four per wall.
+    const std::array handles{h0, h1};
+
+    const std::array<sf::Vector2f, 8> positions{{{0.f, 1.f}, {2.f, 3.f},
+        {4.f, 5.f}, {6.f, 7.f}, {10.f, 11.f}, {12.f, 13.f}, {14.f, 15.f},
+        {16.f, 17.f}}};
+
+    cwManager.setVertexPos4Many(handles, positions);
+
+    checkPos(cwManager, h0, 0, 0.f, 1.f);
+    checkPos(cwManager, h0, 3, 6.f, 7.f);
+    checkPos(cwManager, h1, 0, 10.f, 11.f);
+    checkPos(cwManager, h1, 3, 16.f, 17.f);
+
+    // Offsets, one per wall.
+    const std::array reversedHandles{h1, h0};
+    const std::array<sf::Vector2f, 2> offsets{{{1.f, 2.f}, {-1.f, -2.f}}};
+
+    cwManager.moveVertexPos4SameMany(reversedHandles, offsets);
+
+    checkPos(cwManager, h0, 0, -1.f, -1.f);
+    checkPos(cwManager, h1, 3, 17.f, 19.f);
+
+    // Colors, one per wall.
+    const std::array colors{sf::Color(10, 20, 30, 40), sf::Color::Red};
+
+    cwManager.setVertexColor4SameMany(handles, colors);
+
+    checkColor(cwManager, h0, sf::Color(10, 20, 30, 40));
+    checkColor(cwManager, h1, sf::Color::Red);
+
+    // Mismatched lengths are rejected without modifying any wall.
+    const std::span<const hg::CCustomWallHandle> oneHandle{&h0, 1};
+
+    cwManager.setVertexPos4Many(handles, std::span{positions}.first(4));
+    cwManager.setVertexPos4Many(oneHandle, std::span{positions}.first(3));
+    cwManager.moveVertexPos4SameMany(handles, std::span{offsets}.first(1));
+    cwManager.moveVertexPos4SameMany(oneHandle, offsets);
+    cwManager.setVertexColor4SameMany(handles, std::span{colors}.first(1));
+    cwManager.setVertexColor4SameMany(oneHandle, colors);
+
+    checkPos(cwManager, h0, 0, -1.f, -1.f);
+    checkPos(cwManager, h1, 3, 17.f, 19.f);
+    checkColor(cwManager, h0, sf::Color(10, 20, 30, 40));
+    checkColor(cwManager, h1, sf::Color::Red);
+
+    // Invalid handles are skipped, including destroyed ones and the ones
+    // read from non-number elements, the valid ones are still updated.
+    cwManager.destroy(h0);
+
+    const std::array withInvalid{h0, 12345, -1, h1};
+    const std::array<sf::Vector2f, 4> moreOffsets{
+        {{100.f, 100.f}, {100.f, 100.f}, {100.f, 100.f}, {1.f, 1.f}}};
+
+    cwManager.moveVertexPos4SameMany(withInvalid, moreOffsets);
+
+    TEST_ASSERT_EQ(cwManager.count(), 1u);
+    checkPos(cwManager, h1, 3, 18.f, 20.f);
+}
+
+} // namespace
+
+int main()
+{
+    test_read_handles();
+    test_read_vectors();
+    test_read_colors();
+    test_batch_functions();
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/DrawTrace.hpp"
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+int main()
+{
+    hg::Utils::FastVertexVectorTris tris;
+    tris.reserve_more_quad(2);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        tris.batch_unsafe_emplace_back_quad(sf::Color::White,
+            sf::Vector2f{0.f, 0.f}, sf::Vector2f{0.f, 1.f},
+            sf::Vector2f{1.f, 1.f}, sf::Vector2f{1.f, 0.f});
+    }
+
+    hg::Utils::DrawTrace trace;
+    TEST_ASSERT_EQ(trace.getFrameCount(), 0);
+
+    trace.beginFrame();
+    trace.recordDraw(tris, sf::RenderStates::Default);
+    trace.recordDraw(tris);
+
+    TEST_ASSERT_EQ(trace.getFrameCount(), 1);
+    TEST_ASSERT_EQ(trace.getFrameCalls().size(), 2);
+    TEST_ASSERT_EQ(trace.getFrameVertexCount(), 24);
+
+    const hg::Utils::DrawTrace::Call& call = trace.getFrameCalls()[0];
+    TEST_ASSERT_EQ(call.vertexCount, 12);
+    TEST_ASSERT(call.primitiveType == sf::PrimitiveType::Triangles);
+    TEST_ASSERT(call.texture == nullptr);
+    TEST_ASSERT(call.shader == nullptr);
+
+    // Only the calls of the current frame are kept, the totals accumulate.
+    trace.beginFrame();
+    trace.recordDraw(tris);
+
+    TEST_ASSERT_EQ(trace.getFrameCount(), 2);
+    TEST_ASSERT_EQ(trace.getFrameCalls().size(), 1);
+    TEST_ASSERT_EQ(trace.getFrameVertexCount(), 12);
+    TEST_ASSERT_EQ(trace.getTotalCallCount(), 3);
+    TEST_ASSERT_EQ(trace.getTotalVertexCount(), 36);
+
+    trace.clear();
+    TEST_ASSERT_EQ(trace.getFrameCount(), 0);
+    TEST_ASSERT_EQ(trace.getTotalCallCount(), 0);
+    TEST_ASSERT(trace.getFrameCalls().empty());
+}
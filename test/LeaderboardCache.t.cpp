@@ -0,0 +1,104 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Core/LeaderboardCache.hpp"
+
+#include "TestUtils.hpp"
+
+#include <vector>
+
+int main()
+{
+    hg::LeaderboardCache lc;
+
+    TEST_ASSERT(!lc.hasPendingRequests());
+    TEST_ASSERT(lc.shouldRequestScores(1));
+
+    // Prefetching queues a single request per leaderboard.
+    lc.prefetch(1);
+    lc.prefetch(2);
+    lc.prefetch(1);
+
+    TEST_ASSERT(lc.hasPendingRequests());
+
+    const std::vector<hg::CachedLeaderboardVersion> requests =
+        lc.takePendingRequests();
+
+    TEST_ASSERT_EQ(requests.size(), 2);
+    TEST_ASSERT_EQ(requests[0].levelValidatorId, 1);
+    TEST_ASSERT_EQ(requests[0].version, hg::noLeaderboardVersion);
+    TEST_ASSERT_EQ(requests[1].levelValidatorId, 2);
+    TEST_ASSERT(!lc.hasPendingRequests());
+
+    // In-flight requests are not repeated by the background refresh.
+    TEST_ASSERT(!lc.shouldRequestScores(1));
+    lc.collectScoresToRefresh();
+    TEST_ASSERT(!lc.hasPendingRequests());
+
+    // A pending request does not count as information.
+    TEST_ASSERT(!lc.hasInformation(1));
+
+    lc.receivedScores(1,
+        {hg::Database::ProcessedScore{.position = 0,
+            .userName = "a",
+            .scoreTimestamp = 0,
+            .scoreValue = 10.0}});
+
+    TEST_ASSERT(lc.hasInformation(1));
+    TEST_ASSERT(!lc.hasInformation(2));
+    TEST_ASSERT_EQ(lc.getScores(1).size(), 1);
+    TEST_ASSERT(lc.getOwnScore(1) == nullptr);
+
+    lc.receivedOwnScore(1, hg::Database::ProcessedScore{.position = 3,
+                               .userName = "b",
+                               .scoreTimestamp = 0,
+                               .scoreValue = 5.0});
+
+    TEST_ASSERT(lc.getOwnScore(1) != nullptr);
+    TEST_ASSERT_EQ(lc.getOwnScore(1)->position, 3);
+
+    // Fresh scores are not requested again.
+    TEST_ASSERT(!lc.shouldRequestScores(1));
+    lc.prefetch(1);
+    TEST_ASSERT(!lc.hasPendingRequests());
+
+    // Versioned replies are applied on top of the cached scores.
+    const std::vector<hg::Database::ProcessedScore> newScores{
+        hg::Database::ProcessedScore{.position = 0,
+            .userName = "c",
+            .scoreTimestamp = 1,
+            .scoreValue = 20.0},
+        hg::Database::ProcessedScore{.position = 1,
+            .userName = "a",
+            .scoreTimestamp = 0,
+            .scoreValue = 10.0}};
+
+    TEST_ASSERT(lc.receivedScoresDelta(2, hg::noLeaderboardVersion, 10,
+        hg::makeLeaderboardDelta({}, newScores), sf::base::nullOpt));
+
+    TEST_ASSERT(lc.hasInformation(2));
+    TEST_ASSERT_EQ(lc.getScores(2).size(), 2);
+    TEST_ASSERT(lc.receivedScoresUnchanged(2, 10));
+
+    // Mismatching versions are discarded and requested again in full.
+    TEST_ASSERT(!lc.receivedScoresDelta(
+        2, 9, 11, hg::LeaderboardDelta{}, sf::base::nullOpt));
+
+    lc.prefetch(2);
+
+    const std::vector<hg::CachedLeaderboardVersion> retry =
+        lc.takePendingRequests();
+
+    TEST_ASSERT_EQ(retry.size(), 1);
+    TEST_ASSERT_EQ(retry[0].version, hg::noLeaderboardVersion);
+
+    // Requests rejected by the server can be sent again without waiting for
+    // them to time out.
+    lc.prefetch(3);
+    TEST_ASSERT_EQ(lc.takePendingRequests().size(), 1);
+    TEST_ASSERT(!lc.shouldRequestScores(3));
+
+    lc.requestRejected(3);
+    TEST_ASSERT(lc.shouldRequestScores(3));
+}
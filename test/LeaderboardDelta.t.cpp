@@ -0,0 +1,136 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/LeaderboardDelta.hpp"
+
+#include "TestUtils.hpp"
+
+#include <string>
+#include <vector>
+
+using Scores = std::vector<hg::Database::ProcessedScore>;
+
+[[nodiscard]] static Scores makeScores(const std::vector<std::string>& names)
+{
+    Scores result;
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        result.push_back(hg::Database::ProcessedScore{
+            .position = static_cast<std::uint32_t>(i), //
+            .userName = names[i],                      //
+            .scoreTimestamp = names[i].size(),         //
+            .scoreValue = 100.0 - names[i].size()      //
+        });
+    }
+
+    return result;
+}
+
+[[nodiscard]] static bool equal(const Scores& a, const Scores& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].position != b[i].position ||
+            a[i].userName != b[i].userName ||
+            a[i].scoreTimestamp != b[i].scoreTimestamp ||
+            a[i].scoreValue != b[i].scoreValue)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void test_roundtrip(const Scores& oldScores, const Scores& newScores)
+{
+    const hg::LeaderboardDelta delta =
+        hg::makeLeaderboardDelta(oldScores, newScores);
+
+    const auto applied = hg::applyLeaderboardDelta(oldScores, delta);
+    TEST_ASSERT(applied.hasValue());
+    TEST_ASSERT(equal(*applied, newScores));
+}
+
+static void test_leaderboard_delta()
+{
+    const Scores a = makeScores({"a", "bb", "ccc", "dddd"});
+    const Scores b = makeScores({"a", "eeeee", "bb", "ccc"});
+
+    // Unchanged leaderboards produce an empty delta.
+    {
+        const hg::LeaderboardDelta delta = hg::makeLeaderboardDelta(a, a);
+        TEST_ASSERT_EQ(delta.size, 4);
+        TEST_ASSERT(delta.moved.empty());
+        TEST_ASSERT(delta.inserted.empty());
+    }
+
+    // A new score pushes down the ones below it, which are sent as moves.
+    {
+        const hg::LeaderboardDelta delta = hg::makeLeaderboardDelta(a, b);
+        TEST_ASSERT_EQ(delta.size, 4);
+        TEST_ASSERT_EQ(delta.moved.size(), 2);
+        TEST_ASSERT_EQ(delta.inserted.size(), 1);
+        TEST_ASSERT_EQ(delta.inserted[0].index, 1);
+        TEST_ASSERT_EQ(delta.inserted[0].score.userName, "eeeee");
+    }
+
+    test_roundtrip(a, b);
+    test_roundtrip(b, a);
+    test_roundtrip({}, a);
+    test_roundtrip(a, {});
+    test_roundtrip(makeScores({"a", "bb"}), a);
+
+    // Deltas that do not fit the cached scores are rejected.
+    {
+        const hg::LeaderboardDelta delta = hg::makeLeaderboardDelta(a, b);
+        TEST_ASSERT(!hg::applyLeaderboardDelta({}, delta).hasValue());
+    }
+}
+
+static void test_leaderboard_history()
+{
+    hg::LeaderboardHistory history{100 /* firstVersion */, 2 /* snapshots */};
+
+    TEST_ASSERT(!history.isUpToDate(7));
+
+    const hg::LeaderboardVersion v0 =
+        history.update(7, makeScores({"a"})).version;
+
+    TEST_ASSERT_EQ(v0, 100);
+    TEST_ASSERT(history.isUpToDate(7));
+
+    history.invalidate(7);
+    TEST_ASSERT(!history.isUpToDate(7));
+
+    const hg::LeaderboardVersion v1 =
+        history.update(7, makeScores({"a", "bb"})).version;
+
+    const hg::LeaderboardVersion v2 =
+        history.update(7, makeScores({"bb"})).version;
+
+    TEST_ASSERT(v0 < v1 && v1 < v2);
+    TEST_ASSERT_EQ(history.getLatest(7).version, v2);
+
+    // Only the last two snapshots are kept.
+    TEST_ASSERT(history.find(7, v0) == nullptr);
+    TEST_ASSERT(history.find(7, v1) != nullptr);
+    TEST_ASSERT_EQ(history.find(7, v1)->scores.size(), 2);
+    TEST_ASSERT(history.find(8, v1) == nullptr);
+
+    history.invalidateAll();
+    TEST_ASSERT(!history.isUpToDate(7));
+}
+
+int main()
+{
+    test_leaderboard_delta();
+    test_leaderboard_history();
+}
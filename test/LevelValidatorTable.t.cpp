@@ -0,0 +1,51 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/LevelValidatorTable.hpp"
+
+#include "TestUtils.hpp"
+
+#include <string>
+#include <vector>
+
+int main()
+{
+    hg::LevelValidatorTable table;
+    TEST_ASSERT(table.empty());
+
+    table.add(3, "ohvrvanilla_vittorio_romeo_cube_1_apeirogon_m_1");
+    table.add(std::vector<hg::LevelValidatorMapping>{
+        {.id = 7, .validator = "ohvrvanilla_vittorio_romeo_cube_1_pi_m_1"},
+        {.id = 9, .validator = "ohvrvanilla_vittorio_romeo_cube_1_pi_m_1.6"}});
+
+    TEST_ASSERT_EQ(table.size(), 3);
+
+    TEST_ASSERT(table.contains(7));
+    TEST_ASSERT(!table.contains(8));
+    TEST_ASSERT(table.contains("ohvrvanilla_vittorio_romeo_cube_1_pi_m_1.6"));
+    TEST_ASSERT(!table.contains("ohvrvanilla_vittorio_romeo_cube_1_pi_m_2"));
+
+    const auto id =
+        table.getId("ohvrvanilla_vittorio_romeo_cube_1_apeirogon_m_1");
+    TEST_ASSERT(id.hasValue());
+    TEST_ASSERT_EQ(*id, 3);
+
+    TEST_ASSERT(!table.getId("unknown").hasValue());
+
+    const std::string* validator = table.getValidator(9);
+    TEST_ASSERT(validator != nullptr);
+    TEST_ASSERT_EQ(*validator, "ohvrvanilla_vittorio_romeo_cube_1_pi_m_1.6");
+    TEST_ASSERT(table.getValidator(42) == nullptr);
+
+    // Round-trip through the representation sent in `STCPServerStatus`.
+    hg::LevelValidatorTable received;
+    received.add(table.toMappings());
+
+    TEST_ASSERT_EQ(received.size(), table.size());
+    TEST_ASSERT_EQ(*received.getValidator(7), *table.getValidator(7));
+
+    table.clear();
+    TEST_ASSERT(table.empty());
+    TEST_ASSERT(!table.contains(3));
+}
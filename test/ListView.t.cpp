@@ -0,0 +1,42 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/ListView.hpp"
+
+#include "TestUtils.hpp"
+
+int main()
+{
+    using hg::Utils::getVisibleRows;
+    using hg::Utils::RowRange;
+
+    // Whole list on screen.
+    TEST_ASSERT((getVisibleRows(0.f, 10.f, 5, 0.f, 100.f) == RowRange{0, 5}));
+
+    // Empty list, or degenerate rows/view.
+    TEST_ASSERT((getVisibleRows(0.f, 10.f, 0, 0.f, 100.f) == RowRange{0, 0}));
+    TEST_ASSERT((getVisibleRows(0.f, 0.f, 5, 0.f, 100.f) == RowRange{0, 0}));
+    TEST_ASSERT((getVisibleRows(0.f, 10.f, 5, 10.f, 0.f) == RowRange{0, 0}));
+
+    // Long list scrolled up: rows 30..39 fill the view, the partially
+    // visible rows at both borders are included.
+    TEST_ASSERT(
+        (getVisibleRows(-300.f, 10.f, 500, 0.f, 100.f) == RowRange{30, 40}));
+    TEST_ASSERT(
+        (getVisibleRows(-305.f, 10.f, 500, 0.f, 100.f) == RowRange{30, 41}));
+
+    // List starting below the top of the view.
+    TEST_ASSERT(
+        (getVisibleRows(50.f, 10.f, 500, 0.f, 100.f) == RowRange{0, 5}));
+
+    // List entirely above or below the view.
+    TEST_ASSERT(getVisibleRows(-1000.f, 10.f, 50, 0.f, 100.f).size() == 0);
+    TEST_ASSERT(getVisibleRows(200.f, 10.f, 50, 0.f, 100.f).size() == 0);
+
+    // The last rows of a list scrolled to the bottom.
+    TEST_ASSERT(
+        (getVisibleRows(-4950.f, 10.f, 500, 0.f, 100.f) == RowRange{495, 500}));
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/ParticleSystem.hpp"
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <SFML/System/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+
+[[nodiscard]] static hg::Utils::ParticleSystem::Particle makeParticle(
+    const float x, const float scale)
+{
+    return hg::Utils::ParticleSystem::Particle{
+        .position = {x, 0.f},         //
+        .velocity = {1.f, 2.f},       //
+        .rotationDeg = 0.f,           //
+        .angularVelocityDeg = 0.f,    //
+        .scale = scale,               //
+        .color = sf::Color::White     //
+    };
+}
+
+int main()
+{
+    hg::Utils::ParticleSystem ps;
+    TEST_ASSERT(ps.empty());
+
+    for (int i = 0; i < 6; ++i)
+    {
+        ps.emplace(makeParticle(static_cast<float>(i), 1.f));
+    }
+
+    TEST_ASSERT_EQ(ps.size(), 6);
+
+    // Erasing preserves the order of the remaining particles.
+    ps.eraseIf([](const std::size_t i) { return i % 2 == 0; });
+
+    TEST_ASSERT_EQ(ps.size(), 3);
+    TEST_ASSERT_EQ(ps.positions()[0].x, 1.f);
+    TEST_ASSERT_EQ(ps.positions()[1].x, 3.f);
+    TEST_ASSERT_EQ(ps.positions()[2].x, 5.f);
+
+    ps.integrate(2.f);
+    TEST_ASSERT_EQ(ps.positions()[0].x, 3.f);
+    TEST_ASSERT_EQ(ps.positions()[0].y, 4.f);
+
+    // Every particle is emitted as two triangles.
+    hg::Utils::FastVertexVectorTris tris;
+
+    const sf::FloatRect textureRect{{0.f, 0.f}, {4.f, 8.f}};
+    ps.emitQuads(tris, textureRect, {2.f, 4.f});
+
+    TEST_ASSERT_EQ(tris.size(), 3 * 6);
+
+    // Unrotated, unscaled quads are centered on the origin.
+    TEST_ASSERT_EQ(tris[0].position.x, 1.f);
+    TEST_ASSERT_EQ(tris[0].position.y, 0.f);
+    TEST_ASSERT_EQ(tris[0].texCoords.x, 0.f);
+    TEST_ASSERT_EQ(tris[2].position.x, 5.f);
+    TEST_ASSERT_EQ(tris[2].position.y, 8.f);
+    TEST_ASSERT_EQ(tris[2].texCoords.x, 4.f);
+    TEST_ASSERT_EQ(tris[2].texCoords.y, 8.f);
+
+    ps.clear();
+    TEST_ASSERT(ps.empty());
+}
@@ -162,6 +162,62 @@ static void test_replay_file_serialization_to_buffer()
     TEST_ASSERT_NS_EQ(rf_out, rf);
 }
 
+static void test_replay_file_state_hashes()
+{
+    hg::replay_data rd;
+
+    rd.record_input(false, false, false, false);
+    rd.record_input(false, true, false, false);
+    rd.record_input(true, false, true, false);
+
+    hg::replay_file rf{
+        //
+        ._version{59832},
+        ._player_name{"hello world"},
+        ._seed{12345},
+        ._data{rd},
+        ._pack_id{"totally real pack id"},
+        ._level_id{"legit level id"},
+        ._first_play{false},
+        ._difficulty_mult{2.5f},
+        ._played_score{100.f}
+        //
+    };
+
+    constexpr std::size_t buf_size{2048};
+    std::byte buf[buf_size];
+
+    // Without state hashes, the original format is written.
+    const hg::serialization_result sr_legacy = rf.serialize(buf, buf_size);
+    TEST_ASSERT_NS(sr_legacy);
+
+    rf._state_hashes.set_interval(240);
+    rf._state_hashes.record_hash(0xAAAA'BBBB'CCCC'DDDDull);
+    rf._state_hashes.record_hash(0x1234'5678'9ABC'DEF0ull);
+    TEST_ASSERT_EQ(rf._state_hashes.size(), 2);
+
+    const hg::serialization_result sr = rf.serialize(buf, buf_size);
+    TEST_ASSERT_NS(sr);
+    TEST_ASSERT_EQ(sr.written_bytes(),
+        sr_legacy.written_bytes() + sizeof(std::uint32_t) * 2 +
+            sizeof(std::uint64_t) * 3);
+
+    hg::replay_file rf_out;
+    TEST_ASSERT_NS(rf_out.deserialize(buf, sr.written_bytes()));
+    TEST_ASSERT_NS_EQ(rf_out, rf);
+    TEST_ASSERT_EQ(rf_out._state_hashes.interval(), 240);
+    TEST_ASSERT_EQ(rf_out._state_hashes.at(1), 0x1234'5678'9ABC'DEF0ull);
+
+    // A replay in the original format is read with no state hashes.
+    hg::replay_file rf_legacy;
+    TEST_ASSERT_NS(rf_legacy.deserialize(buf, sr_legacy.written_bytes()));
+    TEST_ASSERT(rf_legacy._state_hashes.empty());
+
+    // A truncated state hash section is an error.
+    hg::replay_file rf_truncated;
+    TEST_ASSERT_NS(!rf_truncated.deserialize(buf, sr.written_bytes() - 1));
+}
+
 void test_impl_file_serialization(hg::replay_file& rf)
 {
     TEST_ASSERT(rf.serialize_to_file("test.ohr"));
@@ -267,6 +323,7 @@ int main()
 
     test_replay_file_serialization_to_buffer();
     test_replay_file_serialization_to_file();
+    test_replay_file_state_hashes();
 
     test_replay_file_serialization_to_file_randomized(0, 0);
     test_replay_file_serialization_to_file_randomized(0, 1);
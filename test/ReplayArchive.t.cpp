@@ -0,0 +1,228 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/ReplayArchive.hpp"
+
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "TestUtils.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+[[nodiscard]] static hg::compressed_replay_file makeFakeCrf(
+    const std::size_t size, const char fill)
+{
+    hg::compressed_replay_file crf;
+    crf._data.assign(size, fill);
+    return crf;
+}
+
+static void test_replay_archive_roundtrip(const std::filesystem::path& dir)
+{
+    {
+        hg::ReplayArchiveWriter writer{dir, 64 /* maxSegmentBytes */};
+
+        writer.append("lvA", 1, 10.0, 100, makeFakeCrf(40, 'a'));
+        writer.append("lvA", 2, 20.0, 101, makeFakeCrf(40, 'b'));
+        writer.append("lvB", 1, 5.0, 102, makeFakeCrf(10, 'c'));
+    }
+
+    hg::ReplayArchiveReader reader{dir};
+    TEST_ASSERT(reader.loadIndex());
+    TEST_ASSERT_EQ(reader.getEntries().size(), 3);
+
+    // Second replay does not fit in the 64 byte segment, so it rolls over.
+    TEST_ASSERT_EQ(reader.getEntries()[0].segment, 0);
+    TEST_ASSERT_EQ(reader.getEntries()[1].segment, 1);
+    TEST_ASSERT_EQ(reader.getEntries()[2].segment, 1);
+    TEST_ASSERT_EQ(reader.getEntries()[2].offset, 40);
+
+    TEST_ASSERT_EQ(reader.getEntriesForLevel("lvA").size(), 2);
+    TEST_ASSERT_EQ(reader.getEntriesForLevel("lvC").size(), 0);
+
+    const auto best = reader.getBestEntry("lvA");
+    TEST_ASSERT(best.hasValue());
+    TEST_ASSERT_EQ(best->steamId, 2);
+
+    const auto bestUser = reader.getBestEntryForUser("lvA", 1);
+    TEST_ASSERT(bestUser.hasValue());
+    TEST_ASSERT_EQ(bestUser->score, 10.0);
+
+    const auto crf = reader.read(*best);
+    TEST_ASSERT(crf.hasValue());
+    TEST_ASSERT_NS(crf->_data == makeFakeCrf(40, 'b')._data);
+
+    const auto crfC = reader.read(reader.getEntries()[2]);
+    TEST_ASSERT(crfC.hasValue());
+    TEST_ASSERT_NS(crfC->_data == makeFakeCrf(10, 'c')._data);
+}
+
+static void test_replay_archive_resume(const std::filesystem::path& dir)
+{
+    {
+        hg::ReplayArchiveWriter writer{dir, 64 /* maxSegmentBytes */};
+        writer.append("lvB", 3, 7.0, 103, makeFakeCrf(8, 'd'));
+    }
+
+    hg::ReplayArchiveReader reader{dir};
+    TEST_ASSERT(reader.loadIndex());
+    TEST_ASSERT_EQ(reader.getEntries().size(), 4);
+
+    const hg::ReplayArchiveEntry& e = reader.getEntries()[3];
+    TEST_ASSERT_EQ(e.segment, 1);
+    TEST_ASSERT_EQ(e.offset, 50);
+
+    const auto crf = reader.read(e);
+    TEST_ASSERT(crf.hasValue());
+    TEST_ASSERT_NS(crf->_data == makeFakeCrf(8, 'd')._data);
+}
+
+static void appendGarbage(
+    const std::filesystem::path& path, const std::string& data)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::out | std::ios::app);
+    os.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+static void test_replay_archive_truncated(const std::filesystem::path& dir)
+{
+    // Simulate a crash in the middle of a write: replay data without its
+    // index record, and a partial index record.
+    appendGarbage(dir / "segment_000001.ohrs", "unindexed");
+    appendGarbage(dir / "index.ohri", std::string{"\x03\x00\x00\x00lv", 6});
+
+    {
+        hg::ReplayArchiveWriter writer{dir, 64 /* maxSegmentBytes */};
+        writer.append("lvC", 4, 9.0, 104, makeFakeCrf(4, 'e'));
+    }
+
+    hg::ReplayArchiveReader reader{dir};
+    TEST_ASSERT(reader.loadIndex());
+    TEST_ASSERT_EQ(reader.getEntries().size(), 5);
+
+    const hg::ReplayArchiveEntry& e = reader.getEntries()[4];
+    TEST_ASSERT_EQ(e.levelValidator, "lvC");
+    TEST_ASSERT_EQ(e.segment, 1);
+    TEST_ASSERT_EQ(e.offset, 58);
+
+    const auto crf = reader.read(e);
+    TEST_ASSERT(crf.hasValue());
+    TEST_ASSERT_NS(crf->_data == makeFakeCrf(4, 'e')._data);
+
+    // Index records claiming huge level validators are rejected.
+    appendGarbage(dir / "index.ohri", "\xff\xff\xff\x7f");
+
+    hg::ReplayArchiveReader corruptReader{dir};
+    TEST_ASSERT(corruptReader.loadIndex());
+    TEST_ASSERT_EQ(corruptReader.getEntries().size(), 5);
+}
+
+// Same layout as the records written by `ReplayArchiveWriter`.
+static void appendIndexRecord(
+    const std::filesystem::path& path, const hg::ReplayArchiveEntry& e)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::out | std::ios::app);
+
+    const auto write = [&](const auto& datum)
+    { os.write(reinterpret_cast<const char*>(&datum), sizeof(datum)); };
+
+    write(static_cast<std::uint32_t>(e.levelValidator.size()));
+    os.write(e.levelValidator.data(),
+        static_cast<std::streamsize>(e.levelValidator.size()));
+    write(e.steamId);
+    write(e.score);
+    write(e.timestamp);
+    write(e.segment);
+    write(e.offset);
+    write(e.size);
+}
+
+[[nodiscard]] static hg::ReplayArchiveEntry makeEntry(
+    const std::string& levelValidator, const std::uint64_t offset,
+    const std::uint64_t size)
+{
+    return hg::ReplayArchiveEntry{
+        .levelValidator = levelValidator, //
+        .steamId = 5,                     //
+        .score = 1.0,                     //
+        .timestamp = 105,                 //
+        .segment = 0,                     //
+        .offset = offset,                 //
+        .size = size                      //
+    };
+}
+
+static void test_replay_archive_out_of_bounds(const std::filesystem::path& dir)
+{
+    {
+        hg::ReplayArchiveWriter writer{dir, 64 /* maxSegmentBytes */};
+        writer.append("lvA", 1, 10.0, 100, makeFakeCrf(8, 'a'));
+    }
+
+    // Unindexed data, and a corrupt record claiming more data than the
+    // segment holds. The record must not prevent the unindexed data from
+    // being cut off.
+    appendGarbage(dir / "segment_000000.ohrs", "unindexed");
+    appendIndexRecord(dir / "index.ohri", makeEntry("lvB", 0, 60));
+
+    {
+        hg::ReplayArchiveWriter writer{dir, 64 /* maxSegmentBytes */};
+        writer.append("lvC", 2, 20.0, 101, makeFakeCrf(4, 'c'));
+    }
+
+    TEST_ASSERT_EQ(std::filesystem::file_size(dir / "segment_000000.ohrs"), 12);
+
+    // Records pointing past the end of their segment are skipped.
+    hg::ReplayArchiveReader reader{dir};
+    TEST_ASSERT(reader.loadIndex());
+    TEST_ASSERT_EQ(reader.getEntries().size(), 2);
+    TEST_ASSERT_EQ(reader.getEntries()[1].levelValidator, "lvC");
+    TEST_ASSERT_EQ(reader.getEntries()[1].offset, 8);
+
+    const auto crf = reader.read(reader.getEntries()[1]);
+    TEST_ASSERT(crf.hasValue());
+    TEST_ASSERT_NS(crf->_data == makeFakeCrf(4, 'c')._data);
+
+    // Reading them is rejected before allocating, including offsets that
+    // would overflow.
+    TEST_ASSERT(!reader.read(makeEntry("lvB", 4, 60)).hasValue());
+    TEST_ASSERT(!reader.read(makeEntry("lvB", UINT64_MAX, 4)).hasValue());
+
+    TEST_ASSERT(
+        !reader.read(makeEntry("lvB", 0, hg::maxArchivedReplaySize + 1))
+             .hasValue());
+
+    // Records claiming huge replays are rejected like huge level validators:
+    // the following records are not trusted either.
+    appendIndexRecord(dir / "index.ohri",
+        makeEntry("lvD", 0, hg::maxArchivedReplaySize + 1));
+    appendIndexRecord(dir / "index.ohri", makeEntry("lvE", 0, 4));
+
+    hg::ReplayArchiveReader corruptReader{dir};
+    TEST_ASSERT(corruptReader.loadIndex());
+    TEST_ASSERT_EQ(corruptReader.getEntries().size(), 2);
+}
+
+int main()
+{
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "ohtest_replay_archive";
+
+    std::filesystem::remove_all(dir);
+
+    test_replay_archive_roundtrip(dir);
+    test_replay_archive_resume(dir);
+    test_replay_archive_truncated(dir);
+
+    std::filesystem::remove_all(dir);
+
+    test_replay_archive_out_of_bounds(dir);
+
+    std::filesystem::remove_all(dir);
+}
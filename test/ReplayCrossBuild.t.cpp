@@ -0,0 +1,174 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Data/ProfileData.hpp"
+
+#include "SSVOpenHexagon/Global/Assets.hpp"
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Version.hpp"
+
+#include "SSVOpenHexagon/Core/HexagonGame.hpp"
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+// Records replays with one build of the game and plays them back with
+// another. CI records them with a regular build (`--record <dir>`) and plays
+// them back with a `SSVOH_AGGRESSIVE_OPTIMIZATIONS` build (`--play <dir>`),
+// which must reach the same scores and state hashes. Without arguments, both
+// steps run in this build.
+
+static void recordReplays(
+    hg::HexagonGame& hg, const std::filesystem::path& dir)
+{
+    constexpr std::array packs{
+        "ohvrvanilla_vittorio_romeo_cube_1",        //
+        "ohvrvanilla_vittorio_romeo_experimental_1" //
+    };
+
+    constexpr std::array levels{
+        "ohvrvanilla_vittorio_romeo_cube_1_apeirogon",        //
+        "ohvrvanilla_vittorio_romeo_experimental_1_autotest0" //
+    };
+
+    std::filesystem::create_directories(dir);
+
+    for (std::size_t i = 0; i < packs.size(); ++i)
+    {
+        // Once with a fixed input and once with random ones.
+        for (const bool randomInputs : {false, true})
+        {
+            sf::base::Optional<hg::replay_file> rf;
+
+            hg.onDeathReplayCreated = [&](const hg::replay_file& newRf)
+            { rf.emplace(newRf); };
+
+            hg.executeRandomInputs = randomInputs;
+            hg.alwaysSpinRight = !randomInputs;
+
+            hg.newGame(packs[i], levels[i], true /* firstPlay */,
+                1.f /* diffMult */, /* mExecuteLastReplay */ false);
+
+            hg.setMustStart(true);
+            TEST_ASSERT(hg.executeGameUntilDeath(10 /* maxProcessingSeconds */,
+                              1.f /* timescale */)
+                            .hasValue());
+
+            TEST_ASSERT(rf.hasValue());
+
+            const std::string filename = std::string{levels[i]} +
+                                         (randomInputs ? "_random" : "_spin") +
+                                         ".ohr";
+
+            TEST_ASSERT(rf->serialize_to_file(dir / filename));
+
+            std::cerr << "Recorded " << filename << " with score "
+                      << rf->_played_score << '\n';
+        }
+    }
+}
+
+static void playReplays(hg::HexagonGame& hg, const std::filesystem::path& dir)
+{
+    std::vector<std::filesystem::path> paths;
+
+    for (const auto& entry : std::filesystem::directory_iterator{dir})
+    {
+        if (entry.path().extension() == ".ohr")
+        {
+            paths.push_back(entry.path());
+        }
+    }
+
+    TEST_ASSERT(!paths.empty());
+
+    for (const std::filesystem::path& p : paths)
+    {
+        hg::replay_file rf;
+        TEST_ASSERT(rf.deserialize_from_file(p));
+        TEST_ASSERT_EQ(rf._version, hg::replay_format_version);
+
+        const sf::base::Optional<hg::HexagonGame::GameExecutionResult> ger =
+            hg.runReplayUntilDeathAndGetScore(
+                rf, 10 /* maxProcessingSeconds */, 1.f /* timescale */);
+
+        std::cerr << p.filename() << ": "
+                  << (ger.hasValue() ? ger->playedTimeSeconds : -1.0)
+                  << " == " << rf._played_score << '\n';
+
+        // A divergence means that the state hashes recorded every few ticks
+        // did not match, not only the final score.
+        TEST_ASSERT(!hg.hasReplayDiverged());
+        TEST_ASSERT(ger.hasValue());
+        TEST_ASSERT_EQ(ger->playedTimeSeconds, rf._played_score);
+    }
+}
+
+int main(int argc, char** argv)
+try
+{
+    hg::Config::loadConfig({});
+
+    hg::HGAssets assets{nullptr /* graphicsContext */,
+        nullptr /* steamManager */, true /* headless */};
+
+    hg::ProfileData fakeProfile{hg::GAME_VERSION, "testProfile", {}, {}};
+    assets.addLocalProfile(SSVOH_MOVE(fakeProfile));
+    assets.pSetCurrent("testProfile");
+
+    hg::HexagonGame hg{
+        nullptr /* graphicsContext */, //
+        nullptr /* steamManager */,    //
+        nullptr /* discordManager */,  //
+        assets,                        //
+        nullptr /* audio */,           //
+        nullptr /* window */,          //
+        nullptr /* client */           //
+    };
+
+    if (argc == 3 && std::string_view{argv[1]} == "--record")
+    {
+        recordReplays(hg, argv[2]);
+    }
+    else if (argc == 3 && std::string_view{argv[1]} == "--play")
+    {
+        playReplays(hg, argv[2]);
+    }
+    else
+    {
+        const std::filesystem::path dir =
+            std::filesystem::temp_directory_path() / "ohtest_replay_xbuild";
+
+        std::filesystem::remove_all(dir);
+
+        recordReplays(hg, dir);
+        playReplays(hg, dir);
+
+        std::filesystem::remove_all(dir);
+    }
+
+    return 0;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+    return 1;
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Data/ProfileData.hpp"
+
+#include "SSVOpenHexagon/Global/Assets.hpp"
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+#include "SSVOpenHexagon/Global/Version.hpp"
+
+#include "SSVOpenHexagon/Core/HexagonGame.hpp"
+#include "SSVOpenHexagon/Core/Replay.hpp"
+
+#include "TestUtils.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <SFML/Base/Optional.hpp>
+#include <stdexcept>
+
+int main()
+try
+{
+    using Status = hg::HexagonGame::GameExecutionStatus;
+
+    constexpr std::array packs{
+        "ohvrvanilla_vittorio_romeo_cube_1",        //
+        "ohvrvanilla_vittorio_romeo_experimental_1" //
+    };
+
+    constexpr std::array levels{
+        "ohvrvanilla_vittorio_romeo_cube_1_apeirogon",        //
+        "ohvrvanilla_vittorio_romeo_experimental_1_autotest0" //
+    };
+
+    constexpr int ticksPerSlice = 97;
+    constexpr std::chrono::microseconds sliceDuration{1'000'000};
+
+    hg::Config::loadConfig({});
+
+    hg::HGAssets assets{nullptr /* graphicsContext */,
+        nullptr /* steamManager */, true /* headless */};
+
+    hg::ProfileData fakeProfile{hg::GAME_VERSION, "testProfile", {}, {}};
+    assets.addLocalProfile(SSVOH_MOVE(fakeProfile));
+    assets.pSetCurrent("testProfile");
+
+    const auto makeGame = [&]
+    {
+        return hg::HexagonGame{
+            nullptr /* graphicsContext */, //
+            nullptr /* steamManager */,    //
+            nullptr /* discordManager */,  //
+            assets,                        //
+            nullptr /* audio */,           //
+            nullptr /* window */,          //
+            nullptr /* client */           //
+        };
+    };
+
+    std::array<hg::HexagonGame, 2> games{makeGame(), makeGame()};
+    std::array<sf::base::Optional<hg::replay_file>, 2> replays;
+    std::array<double, 2> scores{};
+
+    // Record one replay per level, executing the whole game at once.
+    for (std::size_t i = 0; i < games.size(); ++i)
+    {
+        hg::HexagonGame& hg = games[i];
+
+        hg.alwaysSpinRight = true;
+        hg.onDeathReplayCreated = [&replays, i](const hg::replay_file& rf)
+        { replays[i].emplace(rf); };
+
+        hg.newGame(packs[i], levels[i], true /* firstPlay */,
+            1.f /* diffMult */, /* mExecuteLastReplay */ false);
+
+        hg.setMustStart(true);
+        scores[i] = hg.executeGameUntilDeath(
+                          5 /* maxProcessingSeconds */, 1.f /* timescale */)
+                        .value()
+                        .playedTimeSeconds;
+
+        TEST_ASSERT(replays[i].hasValue());
+        hg.onDeathReplayCreated = nullptr;
+    }
+
+    // A single tick is not enough to finish any game.
+    games[0].startReplayExecution(replays[0].value());
+
+    const Status singleTickStatus =
+        games[0].executeGameSlice(1, sliceDuration, 1.f /* timescale */);
+
+    TEST_ASSERT(singleTickStatus == Status::Paused);
+
+    // Execute both replays from the start, interleaving their slices.
+    std::array<Status, 2> statuses{Status::Paused, Status::Paused};
+    std::array<int, 2> slices{};
+
+    for (std::size_t i = 0; i < games.size(); ++i)
+    {
+        games[i].startReplayExecution(replays[i].value());
+    }
+
+    while (statuses[0] == Status::Paused || statuses[1] == Status::Paused)
+    {
+        for (std::size_t i = 0; i < games.size(); ++i)
+        {
+            if (statuses[i] != Status::Paused)
+            {
+                continue;
+            }
+
+            statuses[i] = games[i].executeGameSlice(
+                ticksPerSlice, sliceDuration, 1.f /* timescale */);
+
+            ++slices[i];
+        }
+    }
+
+    for (std::size_t i = 0; i < games.size(); ++i)
+    {
+        TEST_ASSERT(statuses[i] == Status::Finished);
+        TEST_ASSERT_GT(slices[i], 1);
+
+        const double replayPlayedTimeSeconds =
+            games[i].getGameExecutionResult().playedTimeSeconds;
+
+        std::cerr << scores[i] << " == " << replayPlayedTimeSeconds
+                  << std::endl;
+
+        TEST_ASSERT_EQ(scores[i], replayPlayedTimeSeconds);
+    }
+
+    return 0;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Data/StyleData.hpp"
+
+#include "SSVOpenHexagon/SSVUtilsJson/SSVUtilsJson.hpp"
+
+#include "SSVOpenHexagon/Utils/FastVertexVector.hpp"
+#include "SSVOpenHexagon/Utils/Math.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cmath>
+
+static void checkNear(const sf::Vector2f& pos, const float x, const float y)
+{
+    TEST_ASSERT(std::abs(pos.x - x) < 1e-5f);
+    TEST_ASSERT(std::abs(pos.y - y) < 1e-5f);
+}
+
+// Draws the background of `styleData` around the origin, and checks that
+// there is one triangle per side, spanning the sector of that side.
+static void checkBackground(const hg::StyleData& styleData,
+    const unsigned int sides, const bool menu)
+{
+    hg::Utils::FastVertexVectorTris tris;
+
+    if (menu)
+    {
+        styleData.drawBackgroundMenu(tris, sf::Vector2f{0.f, 0.f}, sides,
+            false /* darkenUnevenBackgroundChunk */, false /* blackAndWhite */,
+            false /* fourByThree */);
+
+        // The menu hexagon adds two more triangles per side.
+        TEST_ASSERT_EQ(tris.size(), sides * 9u);
+    }
+    else
+    {
+        styleData.drawBackground(tris, sf::Vector2f{0.f, 0.f}, sides,
+            false /* darkenUnevenBackgroundChunk */, false /* blackAndWhite */);
+
+        TEST_ASSERT_EQ(tris.size(), sides * 3u);
+    }
+
+    const float div = hg::Utils::tau / sides * 1.0001f;
+    const float radius = styleData.bgTileRadius;
+
+    for (unsigned int i = 0; i < sides; ++i)
+    {
+        const float angle = hg::Utils::toRad(styleData.BGRotOff) + div * i;
+        const float angleA = angle + div / 2.f;
+        const float angleB = angle - div / 2.f;
+
+        checkNear(tris[i * 3].position, 0.f, 0.f);
+
+        checkNear(tris[i * 3 + 1].position, std::cos(angleA) * radius,
+            std::sin(angleA) * radius);
+
+        checkNear(tris[i * 3 + 2].position, std::cos(angleB) * radius,
+            std::sin(angleB) * radius);
+    }
+}
+
+int main()
+{
+    const char* const json = R"({"colors": [)"
+                             R"({"value": [255, 0, 0, 255]},)"
+                             R"({"value": [0, 0, 255, 255]}]})";
+
+    hg::StyleData styleData{ssvuj::getFromStr(json)};
+
+    styleData.bgTileRadius = 1.f;
+    styleData.computeColors();
+
+    // The sector directions are cached, and must be recomputed whenever the
+    // number of sides changes, including back to a previous count.
+    checkBackground(styleData, 6, false /* menu */);
+    checkBackground(styleData, 6, false /* menu */);
+    checkBackground(styleData, 4, false /* menu */);
+    checkBackground(styleData, 7, false /* menu */);
+    checkBackground(styleData, 6, false /* menu */);
+
+    // The menu background shares the cache.
+    checkBackground(styleData, 3, true /* menu */);
+    checkBackground(styleData, 5, true /* menu */);
+    checkBackground(styleData, 5, false /* menu */);
+
+    // They also depend on the rotation offset.
+    styleData.BGRotOff = 30.f;
+    checkBackground(styleData, 5, false /* menu */);
+    checkBackground(styleData, 8, true /* menu */);
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/TextLayoutCache.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GraphicsContext.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+#include <SFML/Base/Optional.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include <cstdint>
+
+using hg::Utils::TextLayoutCache;
+
+static void test_hits(const sf::Font& font)
+{
+    TextLayoutCache cache;
+
+    sf::Text prototype{font, "", 16};
+
+    sf::Text& a = cache.get(prototype, "abc");
+    TEST_ASSERT(a.getString() == "abc");
+    TEST_ASSERT_EQ(cache.size(), 1u);
+
+    // Same string and layout: the same laid-out text is returned.
+    TEST_ASSERT_EQ(&cache.get(prototype, "abc"), &a);
+    TEST_ASSERT_EQ(cache.size(), 1u);
+
+    // Properties that do not affect the layout are copied from the
+    // prototype without creating a new entry.
+    prototype.setFillColor(sf::Color::Red);
+
+    sf::Text& b = cache.get(prototype, std::string{"abc"});
+    TEST_ASSERT_EQ(&b, &a);
+    TEST_ASSERT(b.getFillColor() == sf::Color::Red);
+    TEST_ASSERT_EQ(cache.size(), 1u);
+}
+
+static void test_invalidation(const sf::Font& font, const sf::Font& otherFont)
+{
+    TextLayoutCache cache;
+
+    sf::Text prototype{font, "", 16};
+    sf::Text& original = cache.get(prototype, "abc");
+
+    // A different string.
+    sf::Text& otherString = cache.get(prototype, "abd");
+    TEST_ASSERT(&otherString != &original);
+    TEST_ASSERT(otherString.getString() == "abd");
+    TEST_ASSERT_EQ(cache.size(), 2u);
+
+    // A different font.
+    sf::Text otherFontPrototype{otherFont, "", 16};
+
+    sf::Text& withOtherFont = cache.get(otherFontPrototype, "abc");
+    TEST_ASSERT(&withOtherFont != &original);
+    TEST_ASSERT_EQ(&withOtherFont.getFont(), &otherFont);
+    TEST_ASSERT_EQ(cache.size(), 3u);
+
+    // A different character size.
+    prototype.setCharacterSize(24);
+
+    sf::Text& resized = cache.get(prototype, "abc");
+    TEST_ASSERT(&resized != &original);
+    TEST_ASSERT_EQ(resized.getCharacterSize(), 24u);
+    TEST_ASSERT_EQ(cache.size(), 4u);
+
+    // The previous entries are still valid.
+    prototype.setCharacterSize(16);
+    TEST_ASSERT_EQ(&cache.get(prototype, "abc"), &original);
+    TEST_ASSERT_EQ(original.getCharacterSize(), 16u);
+    TEST_ASSERT_EQ(cache.size(), 4u);
+}
+
+static void test_eviction(const sf::Font& font)
+{
+    TextLayoutCache cache;
+
+    const sf::Text prototype{font, "", 16};
+
+    (void)cache.get(prototype, "used");
+    (void)cache.get(prototype, "idle");
+    TEST_ASSERT_EQ(cache.size(), 2u);
+
+    // Entries survive `maxIdleFrames` frames without being used.
+    for (std::uint64_t i = 0; i <= TextLayoutCache::maxIdleFrames; ++i)
+    {
+        cache.nextFrame();
+        (void)cache.get(prototype, "used");
+    }
+
+    TEST_ASSERT_EQ(cache.size(), 2u);
+
+    cache.nextFrame();
+    TEST_ASSERT_EQ(cache.size(), 1u);
+
+    // The evicted entry is laid out again on its next use.
+    (void)cache.get(prototype, "idle");
+    TEST_ASSERT_EQ(cache.size(), 2u);
+
+    cache.clear();
+    TEST_ASSERT_EQ(cache.size(), 0u);
+}
+
+int main()
+{
+    // Fonts require a graphics context.
+#ifndef SSVOH_HEADLESS_TESTS
+    sf::GraphicsContext gc;
+
+    const std::filesystem::path assetsDir =
+        std::filesystem::path{SSVOH_RELEASE_DIR} / "Assets";
+
+    sf::base::Optional<sf::Font> font = sf::Font::openFromFile(
+        gc, (assetsDir / "OpenSquare-Regular.ttf").string());
+
+    sf::base::Optional<sf::Font> boldFont = sf::Font::openFromFile(
+        gc, (assetsDir / "OpenSquare-Bold.ttf").string());
+
+    TEST_ASSERT(font.hasValue());
+    TEST_ASSERT(boldFont.hasValue());
+
+    test_hits(*font);
+    test_invalidation(*font, *boldFont);
+    test_eviction(*font);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Core/TickProfiler.hpp"
+
+#include "TestUtils.hpp"
+
+#include <chrono>
+#include <sstream>
+
+int main()
+{
+    hg::TickProfiler tp;
+
+    {
+        const auto stats = tp.getStats(hg::TickStage::UpdateWalls);
+        TEST_ASSERT_EQ(stats.samples, 0);
+    }
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        tp.record(hg::TickStage::UpdateWalls, static_cast<float>(i));
+    }
+
+    {
+        const auto stats = tp.getStats(hg::TickStage::UpdateWalls);
+        TEST_ASSERT_EQ(stats.samples, 100);
+        TEST_ASSERT_EQ(stats.minMs, 1.f);
+        TEST_ASSERT_EQ(stats.avgMs, 50.5f);
+        TEST_ASSERT_EQ(stats.p99Ms, 99.f);
+    }
+
+    // Other stages are unaffected.
+    TEST_ASSERT_EQ(tp.getStats(hg::TickStage::Draw).samples, 0);
+
+    // Old samples are overwritten once the ring buffer is full.
+    for (std::size_t i = 0; i < hg::TickProfiler::sampleCount; ++i)
+    {
+        tp.record(hg::TickStage::UpdateWalls, 2.f);
+    }
+
+    {
+        const auto stats = tp.getStats(hg::TickStage::UpdateWalls);
+        TEST_ASSERT_EQ(stats.samples, hg::TickProfiler::sampleCount);
+        TEST_ASSERT_EQ(stats.minMs, 2.f);
+        TEST_ASSERT_EQ(stats.p99Ms, 2.f);
+    }
+
+    {
+        const hg::TickProfiler::Scope scope{tp, hg::TickStage::Draw};
+    }
+
+    TEST_ASSERT_EQ(tp.getStats(hg::TickStage::Draw).samples, 1);
+
+    std::ostringstream oss;
+    tp.dump(oss);
+    TEST_ASSERT(oss.str().find("updateWalls") != std::string::npos);
+
+    tp.clear();
+    TEST_ASSERT_EQ(tp.getStats(hg::TickStage::UpdateWalls).samples, 0);
+
+    // Tick intervals and their deviation from the expected step.
+    {
+        using namespace std::chrono_literals;
+
+        const hg::HRTimePoint t0{};
+
+        tp.recordTickStart(t0, 10.f);
+        TEST_ASSERT_EQ(tp.getStats(hg::TickStage::TickInterval).samples, 0);
+
+        tp.recordTickStart(t0 + 10ms, 10.f);
+        tp.recordTickStart(t0 + 14ms, 10.f);
+
+        const auto interval = tp.getStats(hg::TickStage::TickInterval);
+        TEST_ASSERT_EQ(interval.samples, 2);
+        TEST_ASSERT_EQ(interval.minMs, 4.f);
+        TEST_ASSERT_EQ(interval.avgMs, 7.f);
+
+        const auto jitter = tp.getStats(hg::TickStage::TickJitter);
+        TEST_ASSERT_EQ(jitter.samples, 2);
+        TEST_ASSERT_EQ(jitter.minMs, 0.f);
+        TEST_ASSERT_EQ(jitter.avgMs, 3.f);
+
+        // Clearing forgets the last tick start.
+        tp.clear();
+        tp.recordTickStart(t0 + 100ms, 10.f);
+        TEST_ASSERT_EQ(tp.getStats(hg::TickStage::TickInterval).samples, 0);
+    }
+}
@@ -0,0 +1,204 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/Timeline2.hpp"
+
+#include "SSVOpenHexagon/Global/Macros.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using hg::Utils::recycling_pool;
+using hg::Utils::timeline2;
+using hg::Utils::timeline2_arena;
+using hg::Utils::timeline2_runner;
+
+// Runs all the actions of `t`, none of which is expected to wait.
+void runAll(timeline2& t)
+{
+    timeline2_runner runner;
+
+    const bool finished = runner.update(t, timeline2::time_point{}) ==
+                          timeline2_runner::outcome::finished;
+
+    TEST_ASSERT(finished);
+}
+
+void test_recycling_pool()
+{
+    recycling_pool<int> pool;
+
+    const std::uint32_t a = pool.acquire(1);
+    const std::uint32_t b = pool.acquire(2);
+
+    TEST_ASSERT_EQ(a, 0u);
+    TEST_ASSERT_EQ(b, 1u);
+    TEST_ASSERT_EQ(pool.size(), 2u);
+
+    // Released slots are reset and reused before new ones are added.
+    pool.release(a);
+    TEST_ASSERT_EQ(pool[a], 0);
+
+    const std::uint32_t c = pool.acquire(3);
+    TEST_ASSERT_EQ(c, a);
+    TEST_ASSERT_EQ(pool[c], 3);
+    TEST_ASSERT_EQ(pool[b], 2);
+    TEST_ASSERT_EQ(pool.size(), 2u);
+
+    // Existing slots do not move when the pool grows.
+    const int* const addr = &pool[b];
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        (void)pool.acquire(i);
+    }
+
+    TEST_ASSERT_EQ(&pool[b], addr);
+    TEST_ASSERT_EQ(*addr, 2);
+}
+
+void test_release_on_clear()
+{
+    timeline2_arena arena;
+    timeline2 t{arena};
+
+    int calls = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        t.append_do([&calls] { ++calls; });
+    }
+
+    t.append_wait_until_fn([] { return timeline2::time_point{}; });
+
+    TEST_ASSERT_EQ(arena.size(), 4u);
+    runAll(t);
+    TEST_ASSERT_EQ(calls, 3);
+
+    t.clear();
+    TEST_ASSERT_EQ(t.size(), 0u);
+
+    // Refilling the cleared timeline reuses its slots.
+    for (int i = 0; i < 3; ++i)
+    {
+        t.append_do([&calls] { calls += 10; });
+    }
+
+    t.append_wait_until_fn([] { return timeline2::time_point{}; });
+
+    TEST_ASSERT_EQ(arena.size(), 4u);
+    runAll(t);
+    TEST_ASSERT_EQ(calls, 33);
+}
+
+void test_release_on_destruction()
+{
+    timeline2_arena arena;
+    timeline2 t{arena};
+
+    {
+        timeline2 tmp{arena};
+        tmp.append_do([] {});
+        tmp.append_do([] {});
+
+        TEST_ASSERT_EQ(arena.size(), 2u);
+    }
+
+    // The slots of the destroyed timeline are available to the others.
+    t.append_do([] {});
+    t.append_do([] {});
+
+    TEST_ASSERT_EQ(arena.size(), 2u);
+}
+
+void test_move()
+{
+    timeline2_arena arena;
+
+    int calls = 0;
+
+    // Move construction transfers the slots, the moved-from timeline does not
+    // release them when destroyed.
+    sf::base::Optional<timeline2> src;
+    src.emplace(arena);
+    src->append_do([&calls] { ++calls; });
+
+    timeline2 dst{SSVOH_MOVE(*src)};
+    src.reset();
+
+    TEST_ASSERT_EQ(dst.size(), 1u);
+    TEST_ASSERT_EQ(arena.size(), 1u);
+
+    (void)arena.acquire_do_fn([] {});
+    TEST_ASSERT_EQ(arena.size(), 2u);
+
+    runAll(dst);
+    TEST_ASSERT_EQ(calls, 1);
+
+    // Move assignment releases the slots previously owned by the target.
+    timeline2 other{arena};
+    other.append_do([&calls] { calls += 10; });
+    TEST_ASSERT_EQ(arena.size(), 3u);
+
+    dst = SSVOH_MOVE(other);
+    TEST_ASSERT_EQ(dst.size(), 1u);
+
+    (void)arena.acquire_do_fn([] {});
+    TEST_ASSERT_EQ(arena.size(), 3u);
+
+    runAll(dst);
+    TEST_ASSERT_EQ(calls, 11);
+}
+
+void test_clear_while_running()
+{
+    timeline2_arena arena;
+    timeline2 t{arena};
+
+    int value = 0;
+    int captured = 0;
+
+    // Same as `t_clear` followed by `t_eval` inside a running `t_eval`.
+    t.append_do(
+        [&t, &value, &captured, payload = 42]
+        {
+            t.clear();
+            t.append_do([&value] { value = 1; });
+
+            // The running function must not have been reset or overwritten.
+            captured = payload;
+        });
+
+    runAll(t);
+    TEST_ASSERT_EQ(captured, 42);
+    TEST_ASSERT_EQ(value, 0);
+
+    // The new function got its own slot, and the released one is recycled
+    // once the running function has returned.
+    TEST_ASSERT_EQ(t.size(), 1u);
+    TEST_ASSERT_EQ(arena.size(), 2u);
+
+    (void)arena.acquire_do_fn([] {});
+    TEST_ASSERT_EQ(arena.size(), 2u);
+
+    runAll(t);
+    TEST_ASSERT_EQ(value, 1);
+}
+
+} // namespace
+
+int main()
+{
+    test_recycling_pool();
+    test_release_on_clear();
+    test_release_on_destruction();
+    test_move();
+    test_clear_while_running();
+}
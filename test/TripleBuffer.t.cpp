@@ -0,0 +1,97 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/TripleBuffer.hpp"
+
+#include "TestUtils.hpp"
+
+#include <thread>
+
+#include <cstdint>
+
+namespace {
+
+struct Payload
+{
+    std::uint64_t a;
+    std::uint64_t b;
+};
+
+} // namespace
+
+int main()
+{
+    // Single thread semantics.
+    {
+        hg::Utils::TripleBuffer<int> tb;
+
+        TEST_ASSERT(!tb.consume());
+
+        tb.getWriteBuffer() = 1;
+        tb.publish();
+
+        TEST_ASSERT(tb.consume());
+        TEST_ASSERT_EQ(tb.getReadBuffer(), 1);
+
+        // Nothing new was published.
+        TEST_ASSERT(!tb.consume());
+        TEST_ASSERT_EQ(tb.getReadBuffer(), 1);
+
+        // Only the most recent publication is seen.
+        tb.getWriteBuffer() = 2;
+        tb.publish();
+        tb.getWriteBuffer() = 3;
+        tb.publish();
+
+        TEST_ASSERT(tb.consume());
+        TEST_ASSERT_EQ(tb.getReadBuffer(), 3);
+
+        // The write buffer is never the read buffer.
+        TEST_ASSERT(&tb.getWriteBuffer() != &tb.getReadBuffer());
+    }
+
+    // A reader never sees a torn or older value.
+    {
+        constexpr std::uint64_t publications = 200'000;
+
+        hg::Utils::TripleBuffer<Payload> tb;
+
+        std::thread producer{[&]
+            {
+                for (std::uint64_t i = 1; i <= publications; ++i)
+                {
+                    Payload& p = tb.getWriteBuffer();
+                    p.a = i;
+                    p.b = i * 3;
+                    tb.publish();
+                }
+            }};
+
+        std::uint64_t last = 0;
+        bool torn = false;
+        bool wentBack = false;
+
+        while (last < publications)
+        {
+            if (!tb.consume())
+            {
+                continue;
+            }
+
+            const Payload& p = tb.getReadBuffer();
+
+            torn = torn || p.b != p.a * 3;
+            wentBack = wentBack || p.a <= last;
+            last = p.a;
+        }
+
+        producer.join();
+
+        TEST_ASSERT(!torn);
+        TEST_ASSERT(!wentBack);
+        TEST_ASSERT_EQ(last, publications);
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Online/UserScoreCache.hpp"
+
+#include "SSVOpenHexagon/Online/Database.hpp"
+
+#include "SSVOpenHexagon/Global/Config.hpp"
+
+#include "TestUtils.hpp"
+
+#include <SFML/Base/Optional.hpp>
+
+#include <filesystem>
+
+#include <cstddef>
+
+static void test_max_replay_played_seconds()
+{
+    const auto ticksPerSecond =
+        static_cast<std::size_t>(hg::Config::TICKS_PER_SECOND);
+
+    TEST_ASSERT_EQ(hg::getMaxReplayPlayedSeconds(0), 0.0);
+    TEST_ASSERT_EQ(hg::getMaxReplayPlayedSeconds(ticksPerSecond), 1.0);
+    TEST_ASSERT_EQ(hg::getMaxReplayPlayedSeconds(ticksPerSecond * 90), 90.0);
+}
+
+static void test_can_improve_on_stored_score()
+{
+    const auto ticksPerSecond =
+        static_cast<std::size_t>(hg::Config::TICKS_PER_SECOND);
+
+    // Users without a stored score always have their replays simulated.
+    TEST_ASSERT(hg::canImproveOnStoredScore(sf::base::nullOpt, 0.0));
+
+    const sf::base::Optional<double> stored = sf::base::makeOptional(10.0);
+
+    // Replays too short to beat the stored score are discarded, including
+    // those that could at most tie with it.
+    TEST_ASSERT(!hg::canImproveOnStoredScore(
+        stored, hg::getMaxReplayPlayedSeconds(ticksPerSecond * 5)));
+
+    TEST_ASSERT(!hg::canImproveOnStoredScore(
+        stored, hg::getMaxReplayPlayedSeconds(ticksPerSecond * 10)));
+
+    // A single extra tick is enough to be worth simulating.
+    TEST_ASSERT(hg::canImproveOnStoredScore(
+        stored, hg::getMaxReplayPlayedSeconds(ticksPerSecond * 10 + 1)));
+}
+
+static void test_user_score_cache()
+{
+    hg::UserScoreCache cache;
+
+    // Miss: nothing is loaded until the score is stored.
+    TEST_ASSERT(cache.find(1, 100) == nullptr);
+
+    // Users without a stored score are cached as well, so that the database
+    // is not queried again for them.
+    cache.store(1, 100, sf::base::nullOpt);
+
+    const sf::base::Optional<double>* missing = cache.find(1, 100);
+    TEST_ASSERT(missing != nullptr);
+    TEST_ASSERT(!missing->hasValue());
+
+    // Hit: the stored value is returned.
+    cache.store(1, 200, sf::base::makeOptional(15.0));
+
+    const sf::base::Optional<double>* hit = cache.find(1, 200);
+    TEST_ASSERT(hit != nullptr);
+    TEST_ASSERT_EQ(**hit, 15.0);
+
+    // Scores are per level validator and per user.
+    TEST_ASSERT(cache.find(2, 200) == nullptr);
+    TEST_ASSERT(cache.find(1, 300) == nullptr);
+
+    // Accepted scores only replace worse ones, like in the database.
+    cache.addScore(1, 100, 5.0);
+    TEST_ASSERT_EQ(**cache.find(1, 100), 5.0);
+
+    cache.addScore(1, 200, 12.0);
+    TEST_ASSERT_EQ(**cache.find(1, 200), 15.0);
+
+    cache.addScore(1, 200, 20.0);
+    TEST_ASSERT_EQ(**cache.find(1, 200), 20.0);
+
+    TEST_ASSERT_EQ(cache.size(), 2u);
+
+    cache.clear();
+    TEST_ASSERT_EQ(cache.size(), 0u);
+    TEST_ASSERT(cache.find(1, 200) == nullptr);
+}
+
+static void test_database_get_user_score_value()
+{
+    // Miss: no stored score.
+    TEST_ASSERT(!hg::Database::getUserScoreValue(1, 100).hasValue());
+
+    hg::Database::addScore(1, 0 /* timestamp */, 100, 12.5);
+
+    // Hit: the stored score.
+    const sf::base::Optional<double> score =
+        hg::Database::getUserScoreValue(1, 100);
+
+    TEST_ASSERT(score.hasValue());
+    TEST_ASSERT_EQ(*score, 12.5);
+
+    // Scores are per level validator and per user.
+    TEST_ASSERT(!hg::Database::getUserScoreValue(2, 100).hasValue());
+    TEST_ASSERT(!hg::Database::getUserScoreValue(1, 200).hasValue());
+
+    // Only the best score is kept.
+    hg::Database::addScore(1, 1 /* timestamp */, 100, 10.0);
+    TEST_ASSERT_EQ(*hg::Database::getUserScoreValue(1, 100), 12.5);
+
+    hg::Database::addScore(1, 2 /* timestamp */, 100, 30.0);
+    TEST_ASSERT_EQ(*hg::Database::getUserScoreValue(1, 100), 30.0);
+}
+
+int main()
+{
+    test_max_replay_played_seconds();
+    test_can_improve_on_stored_score();
+    test_user_score_cache();
+
+    // The database is created in the working directory.
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "ohtest_user_score_cache";
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const std::filesystem::path previousDir = std::filesystem::current_path();
+    std::filesystem::current_path(dir);
+
+    test_database_get_user_score_value();
+
+    std::filesystem::current_path(previousDir);
+}
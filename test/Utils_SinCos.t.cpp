@@ -0,0 +1,84 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Utils/Math.hpp"
+
+#include "TestUtils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include <cstdint>
+
+namespace {
+
+struct Recorded
+{
+    float rad;
+    std::uint32_t sinBits;
+    std::uint32_t cosBits;
+};
+
+// Results recorded on x86-64. They must be reproduced bit for bit on every
+// platform and with every set of compiler flags, otherwise replays recorded
+// on one platform would not play back identically on another.
+constexpr std::array recorded{
+    Recorded{0.f, 0x00000000u, 0x3f800000u},        //
+    Recorded{0.5f, 0x3ef57744u, 0x3f60a940u},       //
+    Recorded{1.f, 0x3f576aa4u, 0x3f0a5140u},        //
+    Recorded{-1.f, 0xbf576aa4u, 0x3f0a5140u},       //
+    Recorded{1.5707964f, 0x3f800000u, 0xb3340000u}, //
+    Recorded{3.1415927f, 0xb3b80000u, 0xbf800000u}, //
+    Recorded{-2.75f, 0xbec36912u, 0xbf6c9f15u},     //
+    Recorded{100.f, 0xbf01a12eu, 0x3f5cc0eeu},      //
+    Recorded{-1234.5f, 0xbe14e299u, 0xbf7d4796u},   //
+    Recorded{10000000.f, 0x3ed7520au, 0xbf6842dfu}, //
+};
+
+} // namespace
+
+int main()
+{
+    using hg::Utils::sinCos;
+    using hg::Utils::SinCos;
+
+    for (const Recorded& r : recorded)
+    {
+        const SinCos sc = sinCos(r.rad);
+
+        TEST_ASSERT_EQ(std::bit_cast<std::uint32_t>(sc.sin), r.sinBits);
+        TEST_ASSERT_EQ(std::bit_cast<std::uint32_t>(sc.cos), r.cosBits);
+    }
+
+    // Accuracy over a few turns in both directions.
+    double maxError = 0.0;
+
+    for (int i = -200'000; i <= 200'000; ++i)
+    {
+        const float rad = static_cast<float>(i) * 1e-4f;
+        const SinCos sc = sinCos(rad);
+
+        maxError = std::max(maxError,
+            std::abs(sc.sin - std::sin(static_cast<double>(rad))));
+        maxError = std::max(maxError,
+            std::abs(sc.cos - std::cos(static_cast<double>(rad))));
+    }
+
+    TEST_ASSERT(maxError < 5e-8);
+
+    // Exact at the quadrant boundaries, and never out of range.
+    TEST_ASSERT_EQ(sinCos(0.f).sin, 0.f);
+    TEST_ASSERT_EQ(sinCos(0.f).cos, 1.f);
+    TEST_ASSERT_EQ(sinCos(hg::Utils::pi / 2.f).sin, 1.f);
+    TEST_ASSERT_EQ(sinCos(hg::Utils::pi).cos, -1.f);
+
+    // Non-finite angles do not trigger undefined behavior.
+    TEST_ASSERT_EQ(sinCos(std::numeric_limits<float>::infinity()).cos, 1.f);
+    TEST_ASSERT_EQ(sinCos(std::numeric_limits<float>::quiet_NaN()).cos, 1.f);
+
+    return 0;
+}
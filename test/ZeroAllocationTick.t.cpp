@@ -0,0 +1,101 @@
+// Copyright (c) 2013-2020 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: https://opensource.org/licenses/AFL-3.0
+
+#include "SSVOpenHexagon/Data/ProfileData.hpp"
+
+#include "SSVOpenHexagon/Global/Assets.hpp"
+#include "SSVOpenHexagon/Global/Config.hpp"
+#include "SSVOpenHexagon/Global/Macros.hpp"
+#include "SSVOpenHexagon/Global/Version.hpp"
+
+#include "SSVOpenHexagon/Core/HexagonGame.hpp"
+
+#include "SSVOpenHexagon/Utils/AllocationCounter.hpp"
+
+#include "TestUtils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+SSVOH_DEFINE_ALLOCATION_COUNTER;
+
+int main()
+try
+{
+    constexpr std::array packs{
+        "ohvrvanilla_vittorio_romeo_cube_1",     //
+        "ohvrvanilla_vittorio_romeo_hypercube_1" //
+    };
+
+    constexpr std::array levels{
+        "ohvrvanilla_vittorio_romeo_cube_1_apeirogon",         //
+        "ohvrvanilla_vittorio_romeo_hypercube_1_acceleradiant" //
+    };
+
+    constexpr int ticksPerSecond =
+        static_cast<int>(hg::Config::TICKS_PER_SECOND);
+    constexpr int warmUpTicks = ticksPerSecond * 20;
+    constexpr int measuredTicks = ticksPerSecond * 30;
+
+    hg::Config::loadConfig({});
+
+    // Keep the game going for the whole measurement.
+    hg::Config::setInvincible(true);
+
+    hg::HGAssets assets{nullptr /* graphicsContext */,
+        nullptr /* steamManager */, true /* headless */};
+
+    hg::ProfileData fakeProfile{hg::GAME_VERSION, "testProfile", {}, {}};
+    assets.addLocalProfile(SSVOH_MOVE(fakeProfile));
+    assets.pSetCurrent("testProfile");
+
+    hg::HexagonGame hg{
+        nullptr /* graphicsContext */, //
+        nullptr /* steamManager */,    //
+        nullptr /* discordManager */,  //
+        assets,                        //
+        nullptr /* audio */,           //
+        nullptr /* window */,          //
+        nullptr /* client */           //
+    };
+
+    hg.alwaysSpinRight = true;
+
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        hg.newGame(packs[i], levels[i], true /* firstPlay */,
+            1.f /* diffMult */, /* mExecuteLastReplay */ false);
+
+        hg.setMustStart(true);
+
+        for (int t = 0; t < warmUpTicks; ++t)
+        {
+            hg.executeTick(1.f /* timescale */);
+        }
+
+        const hg::Utils::AllocationCounterScope allocationCounter;
+
+        for (int t = 0; t < measuredTicks; ++t)
+        {
+            hg.executeTick(1.f /* timescale */);
+        }
+
+        const std::uint64_t allocations = allocationCounter.count();
+
+        TEST_ASSERT(!hg.getStatus().hasDied);
+        TEST_ASSERT_EQ(allocations, std::uint64_t{0});
+    }
+
+    return 0;
+}
+catch (const std::runtime_error& e)
+{
+    std::cerr << "EXCEPTION: " << e.what() << std::endl;
+}
+catch (...)
+{
+    std::cerr << "EXCEPTION: unknown" << std::endl;
+}